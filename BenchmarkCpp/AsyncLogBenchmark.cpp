@@ -0,0 +1,90 @@
+// AsyncLogBenchmark.cpp  SimpleLog  BenchmarkCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Measures messages written from increasing numbers of producer threads through an AsyncSimpleLog with a small queue,
+// until the writer thread forwarded all of them to the base log.
+
+#include "Benchmark.h"
+
+#include "SimpleLog/SimpleLog.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	/// <summary>
+	/// Counts the messages forwarded by the writer thread
+	/// </summary>
+	class CountingLog : public sgrottel::ISimpleLog
+	{
+	public:
+		mutable std::atomic<uint64_t> count{ 0 };
+	protected:
+		void WriteImpl(uint32_t, char const*, size_t) const override { count.fetch_add(1, std::memory_order_relaxed); }
+		void WriteImpl(uint32_t, wchar_t const*, size_t) const override { count.fetch_add(1, std::memory_order_relaxed); }
+	};
+
+	/// <summary>
+	/// Writes the messages from `threadCount` threads, and returns the measured result
+	/// </summary>
+	benchmark::Result WriteFromThreads(sgrottel::AsyncSimpleLog& log, unsigned int threadCount, uint64_t messages)
+	{
+		uint64_t const perThread = messages / threadCount;
+		std::vector<std::thread> threads;
+		auto const start = std::chrono::steady_clock::now();
+		for (unsigned int t = 0; t < threadCount; ++t)
+		{
+			threads.emplace_back([&log, perThread, t]()
+				{
+					for (uint64_t i = 0; i < perThread; ++i)
+					{
+						log.Write(sgrottel::ISimpleLog::FlagLevelMessage, "thread %u message %llu of the async log benchmark",
+							t, static_cast<unsigned long long>(i));
+					}
+				});
+		}
+		for (std::thread& t : threads)
+		{
+			t.join();
+		}
+		log.Drain();
+		auto const end = std::chrono::steady_clock::now();
+
+		benchmark::Result r;
+		r.name = "async, " + std::to_string(threadCount) + " producers";
+		r.iterations = perThread * threadCount;
+		r.seconds = std::chrono::duration<double>(end - start).count();
+		return r;
+	}
+}
+
+int main(int argc, char const* argv[])
+{
+	uint64_t const messages = benchmark::ParseIterations(argc, argv, 400000);
+
+	for (unsigned int threadCount : { 1u, 2u, 4u, 8u })
+	{
+		CountingLog base;
+		sgrottel::AsyncSimpleLog log{ base, 64 };
+		benchmark::Print(WriteFromThreads(log, threadCount, messages));
+	}
+
+	return 0;
+}
@@ -0,0 +1,321 @@
+// Benchmark.h  SimpleLog  BenchmarkCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace benchmark
+{
+
+	/// <summary>
+	/// Prevents the compiler from optimizing away the computation of a value
+	/// </summary>
+	template<typename T>
+	inline void DoNotOptimize(T const& value)
+	{
+#if defined(_MSC_VER)
+		static volatile char const* sink;
+		sink = reinterpret_cast<char const*>(&value);
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+
+	/// <summary>
+	/// Result of one measured benchmark case
+	/// </summary>
+	struct Result
+	{
+		std::string name;
+		uint64_t iterations{ 0 };
+		double seconds{ 0.0 };
+
+		double NanosecondsPerOp() const { return (iterations > 0) ? (seconds * 1e9 / static_cast<double>(iterations)) : 0.0; }
+		double OpsPerSecond() const { return (seconds > 0.0) ? (static_cast<double>(iterations) / seconds) : 0.0; }
+	};
+
+	/// <summary>
+	/// Runs `func(i)` for `iterations` times and measures the total wall-clock time
+	/// </summary>
+	template<typename FUNC>
+	Result Run(char const* name, uint64_t iterations, FUNC&& func)
+	{
+		// warm up caches and lazily initialized state
+		for (uint64_t i = 0; i < iterations / 100 + 1; ++i)
+		{
+			func(i);
+		}
+
+		auto const start = std::chrono::steady_clock::now();
+		for (uint64_t i = 0; i < iterations; ++i)
+		{
+			func(i);
+		}
+		auto const end = std::chrono::steady_clock::now();
+
+		Result r;
+		r.name = name;
+		r.iterations = iterations;
+		r.seconds = std::chrono::duration<double>(end - start).count();
+		return r;
+	}
+
+	inline void Print(Result const& r)
+	{
+		std::printf("%-48s %12.2f ns/op %14.0f op/s\n", r.name.c_str(), r.NanosecondsPerOp(), r.OpsPerSecond());
+	}
+
+	/// <summary>
+	/// Collects the results of a benchmark program, prints each one, and writes all of them as JSON if `--json FILE` is given
+	/// </summary>
+	class Report
+	{
+	public:
+		Report(char const* suite, int argc, char const* const* argv) : m_suite{ suite }
+		{
+			for (int i = 1; i + 1 < argc; ++i)
+			{
+				if (std::strcmp(argv[i], "--json") == 0)
+				{
+					m_jsonPath = argv[i + 1];
+				}
+			}
+		}
+
+		/// <summary>
+		/// Adds a value describing the whole run, e.g. the library version
+		/// </summary>
+		void SetInfo(std::string key, std::string value)
+		{
+			m_info.emplace_back(std::move(key), std::move(value));
+		}
+
+		void Add(Result const& r)
+		{
+			Print(r);
+			m_results.push_back(r);
+		}
+
+		std::vector<Result> const& GetResults() const
+		{
+			return m_results;
+		}
+
+		/// <summary>
+		/// Writes the JSON file, if requested
+		/// </summary>
+		/// <returns>False if the file could not be written</returns>
+		bool WriteJson() const
+		{
+			if (m_jsonPath.empty()) return true;
+			FILE* f = std::fopen(m_jsonPath.c_str(), "w");
+			if (f == nullptr) return false;
+			std::fprintf(f, "{\n  \"suite\": \"%s\",\n", escape(m_suite).c_str());
+			for (auto const& info : m_info)
+			{
+				std::fprintf(f, "  \"%s\": \"%s\",\n", escape(info.first).c_str(), escape(info.second).c_str());
+			}
+			std::fprintf(f, "  \"results\": [");
+			for (size_t i = 0; i < m_results.size(); ++i)
+			{
+				Result const& r = m_results[i];
+				std::fprintf(f, "%s\n    { \"name\": \"%s\", \"iterations\": %llu, \"seconds\": %.9g, \"ns_per_op\": %.3f, \"ops_per_second\": %.1f }",
+					(i > 0) ? "," : "", escape(r.name).c_str(), static_cast<unsigned long long>(r.iterations), r.seconds, r.NanosecondsPerOp(), r.OpsPerSecond());
+			}
+			std::fprintf(f, "\n  ]\n}\n");
+			return std::fclose(f) == 0;
+		}
+
+	private:
+		static std::string escape(std::string const& str)
+		{
+			std::string out;
+			for (char c : str)
+			{
+				if (c == '"' || c == '\\') out.push_back('\\');
+				if (static_cast<unsigned char>(c) < 0x20) continue;
+				out.push_back(c);
+			}
+			return out;
+		}
+
+		std::string m_suite;
+		std::string m_jsonPath;
+		std::vector<std::pair<std::string, std::string>> m_info;
+		std::vector<Result> m_results;
+	};
+
+	/// <summary>
+	/// Redirects stdout to the null device while in scope, e.g. for logs echoing to the console
+	/// </summary>
+	class SuppressStdout
+	{
+	public:
+		SuppressStdout()
+		{
+			std::fflush(stdout);
+#if defined(_WIN32)
+			m_saved = _dup(1);
+			FILE* nul = std::fopen("NUL", "w");
+			if (nul != nullptr)
+			{
+				_dup2(_fileno(nul), 1);
+				std::fclose(nul);
+			}
+#else
+			m_saved = ::dup(1);
+			int const nul = ::open("/dev/null", O_WRONLY);
+			if (nul >= 0)
+			{
+				::dup2(nul, 1);
+				::close(nul);
+			}
+#endif
+		}
+
+		~SuppressStdout()
+		{
+			std::fflush(stdout);
+			if (m_saved < 0) return;
+#if defined(_WIN32)
+			_dup2(m_saved, 1);
+			_close(m_saved);
+#else
+			::dup2(m_saved, 1);
+			::close(m_saved);
+#endif
+		}
+
+		SuppressStdout(const SuppressStdout&) = delete;
+		SuppressStdout(SuppressStdout&&) = delete;
+		SuppressStdout& operator=(const SuppressStdout&) = delete;
+		SuppressStdout& operator=(SuppressStdout&&) = delete;
+
+	private:
+		int m_saved{ -1 };
+	};
+
+	/// <summary>
+	/// Histogram of latency values in nanoseconds, with log-linear buckets like a HDR histogram:
+	/// values are recorded exactly below 128, and with a relative error of below 1/64 above.
+	/// </summary>
+	class Histogram
+	{
+	public:
+		static constexpr unsigned int SubBucketBits = 7;
+		static constexpr uint64_t SubBucketCount = uint64_t{ 1 } << SubBucketBits;
+		static constexpr uint64_t SubBucketHalf = SubBucketCount / 2;
+		static constexpr size_t BucketCount = static_cast<size_t>(SubBucketCount + (64 - SubBucketBits) * SubBucketHalf);
+
+		Histogram() : m_counts(BucketCount, 0) {}
+
+		void Record(uint64_t value)
+		{
+			++m_counts[indexOf(value)];
+			++m_total;
+			if (value > m_max) m_max = value;
+		}
+
+		void Add(Histogram const& other)
+		{
+			for (size_t i = 0; i < BucketCount; ++i)
+			{
+				m_counts[i] += other.m_counts[i];
+			}
+			m_total += other.m_total;
+			if (other.m_max > m_max) m_max = other.m_max;
+		}
+
+		uint64_t Count() const { return m_total; }
+		uint64_t Max() const { return m_max; }
+
+		/// <summary>
+		/// Gets the value below or at which `percent` of all recorded values are
+		/// </summary>
+		/// <param name="percent">The percentile, in the range [0, 100]</param>
+		/// <returns>The highest value equivalent to the bucket of the percentile, or zero if nothing was recorded</returns>
+		uint64_t Percentile(double percent) const
+		{
+			if (m_total == 0) return 0;
+			uint64_t rank = static_cast<uint64_t>(percent / 100.0 * static_cast<double>(m_total) + 0.5);
+			if (rank < 1) rank = 1;
+			if (rank > m_total) rank = m_total;
+			uint64_t seen = 0;
+			for (size_t i = 0; i < BucketCount; ++i)
+			{
+				seen += m_counts[i];
+				if (seen >= rank)
+				{
+					uint64_t const value = highestValueOf(i);
+					return (value < m_max) ? value : m_max;
+				}
+			}
+			return m_max;
+		}
+
+	private:
+		static size_t indexOf(uint64_t value)
+		{
+			if (value < SubBucketCount) return static_cast<size_t>(value);
+			unsigned int shift = 0;
+			while ((value >> shift) >= SubBucketCount) ++shift;
+			return static_cast<size_t>(SubBucketCount + (shift - 1) * SubBucketHalf + ((value >> shift) - SubBucketHalf));
+		}
+
+		static uint64_t highestValueOf(size_t index)
+		{
+			if (index < SubBucketCount) return index;
+			uint64_t const shift = (index - SubBucketCount) / SubBucketHalf + 1;
+			uint64_t const sub = (index - SubBucketCount) % SubBucketHalf + SubBucketHalf;
+			return ((sub + 1) << shift) - 1;
+		}
+
+		std::vector<uint64_t> m_counts;
+		uint64_t m_total{ 0 };
+		uint64_t m_max{ 0 };
+	};
+
+	/// <summary>
+	/// Parses `--iterations N` from the command line
+	/// </summary>
+	inline uint64_t ParseIterations(int argc, char const* const* argv, uint64_t defaultIterations)
+	{
+		for (int i = 1; i + 1 < argc; ++i)
+		{
+			if (std::strcmp(argv[i], "--iterations") == 0)
+			{
+				return std::strtoull(argv[i + 1], nullptr, 10);
+			}
+		}
+		return defaultIterations;
+	}
+
+}
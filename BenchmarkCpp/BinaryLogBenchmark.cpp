@@ -0,0 +1,141 @@
+// BinaryLogBenchmark.cpp  SimpleLog  BenchmarkCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Compares the cost of writing printf-based messages to text log files and to binary log files.
+// Binary log files store the format and the arguments; they are decoded and compared against the text log files.
+// The statistics of binary logs only count the messages, not the records of the file format.
+
+#include "Benchmark.h"
+
+#include "SimpleLog/SimpleLog.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	/// <summary>
+	/// Writes the messages, and returns the measured result
+	/// </summary>
+	benchmark::Result WriteMessages(sgrottel::SimpleLog& log, char const* mode, uint64_t messages)
+	{
+		char const* const names[] = { "alpha", "beta", "gamma" };
+		auto const start = std::chrono::steady_clock::now();
+		for (uint64_t i = 0; i < messages; ++i)
+		{
+			log.Write(sgrottel::ISimpleLog::FlagLevelMessage, "message %llu from %s: value %.3f, id 0x%08x, %d%%",
+				static_cast<unsigned long long>(i), names[i % 3], static_cast<double>(i) * 0.25, static_cast<unsigned int>(i * 2654435761u),
+				static_cast<int>(i % 100));
+			if (i % 1000 == 0)
+			{
+				log.Warning("plain text message");
+			}
+		}
+		auto const end = std::chrono::steady_clock::now();
+
+		benchmark::Result r;
+		r.name = mode;
+		r.iterations = messages;
+		r.seconds = std::chrono::duration<double>(end - start).count();
+		return r;
+	}
+
+	/// <summary>
+	/// Reads the lines of a text log, without the time stamps
+	/// </summary>
+	std::vector<std::string> ReadMessages(std::istream& in)
+	{
+		std::vector<std::string> messages;
+		std::string line;
+		while (std::getline(in, line))
+		{
+			size_t const pos = line.find('|');
+			messages.push_back((pos == std::string::npos) ? line : line.substr(pos));
+		}
+		return messages;
+	}
+}
+
+int main(int argc, char const* argv[])
+{
+	uint64_t const messages = benchmark::ParseIterations(argc, argv, 400000);
+
+	std::filesystem::path const dir = std::filesystem::temp_directory_path() / ("simplelog_binary_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+	std::filesystem::create_directories(dir);
+	bool ok = true;
+
+	std::filesystem::path textPath;
+	{
+		sgrottel::SimpleLog log{ dir, "text", 2 };
+		log.SetFlushPolicy(sgrottel::SimpleLog::FlushPolicy::Never());
+		textPath = log.GetFilePath();
+		benchmark::Print(WriteMessages(log, "text", messages));
+	}
+	std::vector<std::string> expected;
+	{
+		std::ifstream in{ textPath, std::ios::binary };
+		expected = ReadMessages(in);
+	}
+
+	for (bool mapped : { false, true })
+	{
+		char const* mode = mapped ? "binary, memory-mapped" : "binary";
+		sgrottel::SimpleLog::Options options = mapped ? sgrottel::SimpleLog::Options::MemoryMapped(64 * 1024) : sgrottel::SimpleLog::Options::File();
+		options.fileFormat = sgrottel::SimpleLog::FileFormat::Binary;
+		std::filesystem::path path;
+		{
+			sgrottel::SimpleLog log{ dir, mapped ? "mapped" : "binary", 2, options };
+			log.SetFlushPolicy(sgrottel::SimpleLog::FlushPolicy::Never());
+			path = log.GetFilePath();
+			benchmark::Print(WriteMessages(log, mode, messages));
+
+			// header and format records are not counted as messages
+			sgrottel::LogStats const stats = log.GetStats();
+			if (stats.TotalMessages() != expected.size())
+			{
+				std::printf("FAILED: %s: %llu messages counted, expected %llu\n", mode, static_cast<unsigned long long>(stats.TotalMessages()),
+					static_cast<unsigned long long>(expected.size()));
+				ok = false;
+			}
+		}
+
+		std::stringstream decoded;
+		std::ifstream in{ path, std::ios::binary };
+		auto const start = std::chrono::steady_clock::now();
+		size_t const count = sgrottel::BinaryLogDecoder::Decode(in, decoded);
+		auto const end = std::chrono::steady_clock::now();
+		benchmark::Result r;
+		r.name = std::string{ "decoding " } + mode;
+		r.iterations = count;
+		r.seconds = std::chrono::duration<double>(end - start).count();
+		benchmark::Print(r);
+
+		if (ReadMessages(decoded) != expected)
+		{
+			std::printf("FAILED: %s: decoded messages differ from the text log\n", path.string().c_str());
+			ok = false;
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::remove_all(dir, ec);
+
+	return ok ? 0 : 1;
+}
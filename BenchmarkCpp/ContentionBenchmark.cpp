@@ -0,0 +1,139 @@
+// ContentionBenchmark.cpp  SimpleLog  BenchmarkCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Measures the throughput of one log written from increasing numbers of threads.
+// Lines are assembled outside of the lock, so throughput should scale until the file write saturates.
+// The statistics of the log must count all messages and bytes, and show the time threads waited for the lock.
+// Suppressed messages must be counted once, also when passed through an echoing log.
+
+#include "Benchmark.h"
+
+#include "SimpleLog/SimpleLog.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char const* argv[])
+{
+	uint64_t const messages = benchmark::ParseIterations(argc, argv, 400000);
+
+	std::filesystem::path const dir = std::filesystem::temp_directory_path() / ("simplelog_contention_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+	std::filesystem::create_directories(dir);
+
+	uint64_t written = 0;
+	std::filesystem::path path;
+	sgrottel::LogStats stats;
+	{
+		sgrottel::SimpleLog log{ dir, "contention", 2 };
+		log.SetFlushPolicy(sgrottel::SimpleLog::FlushPolicy::Never());
+		path = log.GetFilePath();
+
+		for (unsigned int threadCount : { 1u, 2u, 4u, 8u, 16u, 32u })
+		{
+			uint64_t const perThread = messages / threadCount;
+			std::vector<std::thread> threads;
+			auto const start = std::chrono::steady_clock::now();
+			for (unsigned int t = 0; t < threadCount; ++t)
+			{
+				threads.emplace_back([&log, perThread, t]()
+					{
+						for (uint64_t i = 0; i < perThread; ++i)
+						{
+							log.Write(sgrottel::ISimpleLog::FlagLevelMessage, "thread %u message %llu of the contention benchmark",
+								t, static_cast<unsigned long long>(i));
+						}
+					});
+			}
+			for (std::thread& t : threads)
+			{
+				t.join();
+			}
+			auto const end = std::chrono::steady_clock::now();
+
+			benchmark::Result r;
+			r.name = std::to_string(threadCount) + " threads";
+			r.iterations = perThread * threadCount;
+			r.seconds = std::chrono::duration<double>(end - start).count();
+			benchmark::Print(r);
+			written += r.iterations;
+		}
+		stats = log.GetStats();
+	}
+	std::printf("%llu lock waits, %.3f ms total; %llu write calls, %.3f ms total\n",
+		static_cast<unsigned long long>(stats.lockWaits), static_cast<double>(stats.lockWaitNanoseconds) / 1e6,
+		static_cast<unsigned long long>(stats.writeCalls), static_cast<double>(stats.writeNanoseconds) / 1e6);
+
+	// correctness: no line was lost or torn
+	uint64_t lines = 0;
+	uint64_t broken = 0;
+	{
+		std::ifstream file{ path, std::ios::binary };
+		std::string const suffix = " of the contention benchmark";
+		std::string line;
+		while (std::getline(file, line))
+		{
+			++lines;
+			if (line.find("| thread ") == std::string::npos || line.size() < suffix.size()
+				|| line.compare(line.size() - suffix.size(), suffix.size(), suffix) != 0) ++broken;
+		}
+	}
+
+	std::error_code ec;
+	uint64_t const fileSize = std::filesystem::file_size(path, ec);
+	std::filesystem::remove_all(dir, ec);
+
+	// the statistics count each message and byte exactly once
+	if (stats.TotalMessages() != written || stats.messages[sgrottel::ISimpleLog::FlagLevelMessage] != written
+		|| stats.bytesWritten != fileSize || stats.writeCalls < written)
+	{
+		std::printf("FAILED: statistics of %llu messages and %llu bytes, expected %llu and %llu\n",
+			static_cast<unsigned long long>(stats.TotalMessages()), static_cast<unsigned long long>(stats.bytesWritten),
+			static_cast<unsigned long long>(written), static_cast<unsigned long long>(fileSize));
+		return 1;
+	}
+
+	if (lines != written || broken != 0)
+	{
+		std::printf("FAILED: %llu of %llu lines, %llu broken\n", static_cast<unsigned long long>(lines),
+			static_cast<unsigned long long>(written), static_cast<unsigned long long>(broken));
+		return 1;
+	}
+
+	// a suppressed message is counted once, also when passed through an echoing log, and checks of `IsEnabled` are not counted
+	{
+		sgrottel::SimpleLog memoryLog{ {}, {}, 0, sgrottel::SimpleLog::Options::Ring(4096) };
+		memoryLog.SetMinLevel(sgrottel::ISimpleLog::FlagLevelWarning);
+		sgrottel::EchoingSimpleLog echoLog{ memoryLog };
+		echoLog.SetEchoDetails(false);
+		uint64_t enabled = 0;
+		for (uint64_t i = 0; i < 100; ++i)
+		{
+			if (echoLog.IsEnabled(sgrottel::ISimpleLog::FlagLevelDetail)) ++enabled;
+			echoLog.Detail("suppressed");
+		}
+		sgrottel::LogStats const memoryStats = memoryLog.GetStats();
+		if (enabled != 0 || memoryStats.suppressedMessages != 100 || memoryStats.TotalMessages() != 0)
+		{
+			std::printf("FAILED: %llu suppressed messages counted, expected 100\n", static_cast<unsigned long long>(memoryStats.suppressedMessages));
+			return 1;
+		}
+	}
+	return 0;
+}
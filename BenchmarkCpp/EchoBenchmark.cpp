@@ -0,0 +1,266 @@
+// EchoBenchmark.cpp  SimpleLog  BenchmarkCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// Measures the console echo from increasing numbers of threads, with one write call per message, and with coalesced output.
+// The output is discarded; the statistics of the echo show how many write calls were needed.
+// Then, the echo writes into a pipe which is read slowly. With background output, the writing threads must not wait for it,
+// no error message may be lost, and all dropped messages must be reported in the output.
+
+#include "Benchmark.h"
+
+#include "SimpleLog/SimpleLog.hpp"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+	/// <summary>
+	/// Redirects stdout into a pipe while in scope, which is read slowly by a thread
+	/// </summary>
+	class SlowStdout
+	{
+	public:
+		SlowStdout()
+		{
+			std::fflush(stdout);
+			int fds[2];
+#if defined(_WIN32)
+			if (_pipe(fds, 4096, _O_BINARY) != 0) return;
+			m_saved = _dup(1);
+			_dup2(fds[1], 1);
+			_close(fds[1]);
+#else
+			if (::pipe(fds) != 0) return;
+			m_saved = ::dup(1);
+			::dup2(fds[1], 1);
+			::close(fds[1]);
+#endif
+			m_reader = std::thread{ [this, fd = fds[0]]()
+				{
+					char buf[4096];
+					while (true)
+					{
+#if defined(_WIN32)
+						int const n = _read(fd, buf, sizeof(buf));
+#else
+						ssize_t const n = ::read(fd, buf, sizeof(buf));
+#endif
+						if (n <= 0) break;
+						m_output.append(buf, static_cast<size_t>(n));
+						std::this_thread::sleep_for(std::chrono::microseconds(200));
+					}
+#if defined(_WIN32)
+					_close(fd);
+#else
+					::close(fd);
+#endif
+				} };
+		}
+
+		/// <summary>
+		/// Restores stdout, and returns all output read from the pipe
+		/// </summary>
+		std::string Finish()
+		{
+			std::fflush(stdout);
+			if (m_saved >= 0)
+			{
+#if defined(_WIN32)
+				_dup2(m_saved, 1);
+				_close(m_saved);
+#else
+				::dup2(m_saved, 1);
+				::close(m_saved);
+#endif
+				m_saved = -1;
+			}
+			if (m_reader.joinable()) m_reader.join();
+			return m_output;
+		}
+
+		~SlowStdout()
+		{
+			Finish();
+		}
+
+		SlowStdout(const SlowStdout&) = delete;
+		SlowStdout(SlowStdout&&) = delete;
+		SlowStdout& operator=(const SlowStdout&) = delete;
+		SlowStdout& operator=(SlowStdout&&) = delete;
+
+	private:
+		int m_saved{ -1 };
+		std::thread m_reader;
+		std::string m_output;
+	};
+
+	/// <summary>
+	/// Echoes messages into a slowly read pipe, every 100th an error, and checks that every message is echoed or reported as dropped
+	/// </summary>
+	bool SlowOutput(uint64_t messages, bool background)
+	{
+		unsigned int const threadCount = 4;
+		uint64_t const perThread = messages / threadCount;
+		benchmark::Result r;
+		sgrottel::LogStats stats;
+		std::string output;
+		{
+			SlowStdout slow;
+			{
+				sgrottel::NullLog null;
+				sgrottel::EchoingSimpleLog echo{ null };
+				echo.SetUseColors(false);
+				if (background) echo.SetBackgroundOutput(16 * 1024);
+
+				std::vector<std::thread> threads;
+				auto const start = std::chrono::steady_clock::now();
+				for (unsigned int t = 0; t < threadCount; ++t)
+				{
+					threads.emplace_back([&echo, perThread, t]()
+						{
+							for (uint64_t i = 0; i < perThread; ++i)
+							{
+								if (i % 100 == 0)
+								{
+									echo.Error("thread %u error %llu of the echo benchmark", t, static_cast<unsigned long long>(i));
+								}
+								else
+								{
+									echo.Write(sgrottel::ISimpleLog::FlagLevelMessage, "thread %u message %llu of the echo benchmark", t, static_cast<unsigned long long>(i));
+								}
+							}
+						});
+				}
+				for (std::thread& t : threads)
+				{
+					t.join();
+				}
+				auto const end = std::chrono::steady_clock::now();
+				r.name = std::string{ background ? "background" : "per message" } + ", slow output, " + std::to_string(threadCount) + " threads";
+				r.iterations = perThread * threadCount;
+				r.seconds = std::chrono::duration<double>(end - start).count();
+				stats = echo.GetStats();
+			}
+			output = slow.Finish();
+		}
+		benchmark::Print(r);
+
+		uint64_t errors = 0;
+		uint64_t echoed = 0;
+		uint64_t reported = 0;
+		size_t pos = 0;
+		while (pos < output.size())
+		{
+			size_t const end = std::min(output.find('\n', pos), output.size());
+			std::string const line = output.substr(pos, end - pos);
+			pos = end + 1;
+			size_t const notice = line.find(" messages not echoed");
+			if (notice != std::string::npos)
+			{
+				reported += std::strtoull(line.c_str(), nullptr, 10);
+			}
+			else
+			{
+				++echoed;
+				if (line.find(" error ") != std::string::npos) ++errors;
+			}
+		}
+		std::printf("  %llu echoed, %llu dropped and reported\n", static_cast<unsigned long long>(echoed), static_cast<unsigned long long>(reported));
+
+		uint64_t const expectedErrors = threadCount * ((perThread + 99) / 100);
+		if (echoed + reported != r.iterations || errors != expectedErrors || reported != stats.droppedMessages)
+		{
+			std::printf("FAILED: %llu echoed and %llu reported of %llu messages; %llu of %llu errors\n",
+				static_cast<unsigned long long>(echoed), static_cast<unsigned long long>(reported), static_cast<unsigned long long>(r.iterations),
+				static_cast<unsigned long long>(errors), static_cast<unsigned long long>(expectedErrors));
+			return false;
+		}
+		return true;
+	}
+}
+
+int main(int argc, char const* argv[])
+{
+	uint64_t const messages = benchmark::ParseIterations(argc, argv, 200000);
+	bool ok = true;
+
+	for (bool coalesce : { false, true })
+	{
+		char const* mode = coalesce ? "coalesced" : "per message";
+		for (unsigned int threadCount : { 1u, 2u, 4u, 8u })
+		{
+			sgrottel::NullLog null;
+			sgrottel::EchoingSimpleLog echo{ null };
+			echo.SetCoalesceOutput(coalesce);
+
+			uint64_t const perThread = messages / threadCount;
+			benchmark::Result r;
+			{
+				benchmark::SuppressStdout const suppress;
+				std::vector<std::thread> threads;
+				auto const start = std::chrono::steady_clock::now();
+				for (unsigned int t = 0; t < threadCount; ++t)
+				{
+					threads.emplace_back([&echo, perThread, t]()
+						{
+							for (uint64_t i = 0; i < perThread; ++i)
+							{
+								echo.Write(sgrottel::ISimpleLog::FlagLevelMessage, "thread %u message %llu of the echo benchmark",
+									t, static_cast<unsigned long long>(i));
+							}
+						});
+				}
+				for (std::thread& t : threads)
+				{
+					t.join();
+				}
+				auto const end = std::chrono::steady_clock::now();
+				r.name = std::string{ mode } + ", " + std::to_string(threadCount) + " threads";
+				r.iterations = perThread * threadCount;
+				r.seconds = std::chrono::duration<double>(end - start).count();
+			}
+			benchmark::Print(r);
+
+			sgrottel::LogStats const stats = echo.GetStats();
+			std::printf("  %llu write calls, %.1f messages per call\n", static_cast<unsigned long long>(stats.writeCalls),
+				(stats.writeCalls > 0) ? static_cast<double>(stats.TotalMessages()) / static_cast<double>(stats.writeCalls) : 0.0);
+			if (stats.TotalMessages() != r.iterations || stats.writeCalls == 0 || stats.writeCalls > r.iterations
+				|| (!coalesce && stats.writeCalls != r.iterations))
+			{
+				std::printf("FAILED: %llu messages echoed with %llu write calls, expected %llu\n", static_cast<unsigned long long>(stats.TotalMessages()),
+					static_cast<unsigned long long>(stats.writeCalls), static_cast<unsigned long long>(r.iterations));
+				ok = false;
+			}
+		}
+	}
+
+	ok = SlowOutput(messages / 10, false) && ok;
+	ok = SlowOutput(messages / 10, true) && ok;
+
+	return ok ? 0 : 1;
+}
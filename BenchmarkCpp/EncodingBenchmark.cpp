@@ -0,0 +1,148 @@
+// EncodingBenchmark.cpp  SimpleLog  BenchmarkCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Compares the vectorized UTF8 encoding against a plain scalar implementation.
+// Compile with `-mavx2` or `/arch:AVX2` to measure the AVX2 kernels instead of the SSE2 ones.
+
+#include "Benchmark.h"
+
+#include "SimpleLog/SimpleLog.hpp"
+
+#include <string>
+
+namespace
+{
+	/// <summary>
+	/// Scalar reference implementation, code point by code point
+	/// </summary>
+	void ScalarFromWide(std::string& outUtf8, wchar_t const* str, size_t len)
+	{
+		outUtf8.resize(len * 4);
+		size_t o = 0;
+		for (size_t i = 0; i < len; ++i)
+		{
+			uint32_t c = static_cast<uint32_t>(str[i]);
+			if constexpr (sizeof(wchar_t) == 2)
+			{
+				c &= 0xffff;
+				if (c >= 0xd800 && c <= 0xdbff && i + 1 < len)
+				{
+					uint32_t const c2 = static_cast<uint32_t>(str[i + 1]) & 0xffff;
+					if (c2 >= 0xdc00 && c2 <= 0xdfff)
+					{
+						c = 0x10000 + ((c - 0xd800) << 10) + (c2 - 0xdc00);
+						++i;
+					}
+				}
+			}
+			if ((c >= 0xd800 && c <= 0xdfff) || c > 0x10ffff)
+			{
+				c = 0xfffd;
+			}
+			o += sgrottel::Utf8Encoding::EncodeCodePoint(outUtf8.data() + o, c);
+		}
+		outUtf8.resize(o);
+	}
+
+	size_t ScalarAsciiPrefixLength(char const* str, size_t len)
+	{
+		size_t i = 0;
+		while (i < len && static_cast<unsigned char>(str[i]) < 0x80) ++i;
+		return i;
+	}
+
+	void PrintThroughput(benchmark::Result const& r, size_t charsPerOp)
+	{
+		benchmark::Print(r);
+		std::printf("%-48s %12.2f chars/ns\n", "", static_cast<double>(charsPerOp) / r.NanosecondsPerOp());
+	}
+}
+
+int main(int argc, char const* argv[])
+{
+	uint64_t const iterations = benchmark::ParseIterations(argc, argv, 1000000);
+
+	std::wstring ascii;
+	while (ascii.size() < 240)
+	{
+		ascii += L"The quick brown fox jumps over the lazy dog. ";
+	}
+	std::wstring mixed = ascii;
+	for (size_t i = 7; i < mixed.size(); i += 40)
+	{
+		mixed[i] = static_cast<wchar_t>(0x7834);
+	}
+	std::wstring invalid = ascii + L"\xd800 tail";
+	std::string narrow(ascii.begin(), ascii.end());
+
+	// correctness: the vectorized implementation must match the scalar one
+	int failures = 0;
+	std::string expected;
+	std::string actual;
+	for (std::wstring const* str : { &ascii, &mixed, &invalid })
+	{
+		for (size_t len = 0; len <= str->size(); ++len)
+		{
+			ScalarFromWide(expected, str->data(), len);
+			sgrottel::Utf8Encoding::FromWide(actual, str->data(), len);
+			if (expected != actual) ++failures;
+		}
+	}
+	for (size_t pos = 0; pos < narrow.size(); ++pos)
+	{
+		std::string s = narrow;
+		s[pos] = static_cast<char>(0xc3);
+		if (sgrottel::Utf8Encoding::AsciiPrefixLength(s.data(), s.size()) != ScalarAsciiPrefixLength(s.data(), s.size())) ++failures;
+	}
+	if (!sgrottel::Utf8Encoding::IsAscii(narrow.data(), narrow.size())) ++failures;
+
+	PrintThroughput(benchmark::Run("scalar FromWide, ASCII", iterations, [&](uint64_t)
+		{
+			ScalarFromWide(expected, ascii.data(), ascii.size());
+			benchmark::DoNotOptimize(expected.data());
+		}), ascii.size());
+	PrintThroughput(benchmark::Run("Utf8Encoding::FromWide, ASCII", iterations, [&](uint64_t)
+		{
+			sgrottel::Utf8Encoding::FromWide(actual, ascii.data(), ascii.size());
+			benchmark::DoNotOptimize(actual.data());
+		}), ascii.size());
+	PrintThroughput(benchmark::Run("scalar FromWide, mixed", iterations, [&](uint64_t)
+		{
+			ScalarFromWide(expected, mixed.data(), mixed.size());
+			benchmark::DoNotOptimize(expected.data());
+		}), mixed.size());
+	PrintThroughput(benchmark::Run("Utf8Encoding::FromWide, mixed", iterations, [&](uint64_t)
+		{
+			sgrottel::Utf8Encoding::FromWide(actual, mixed.data(), mixed.size());
+			benchmark::DoNotOptimize(actual.data());
+		}), mixed.size());
+	PrintThroughput(benchmark::Run("scalar ASCII detection", iterations, [&](uint64_t)
+		{
+			benchmark::DoNotOptimize(ScalarAsciiPrefixLength(narrow.data(), narrow.size()));
+		}), narrow.size());
+	PrintThroughput(benchmark::Run("Utf8Encoding::AsciiPrefixLength", iterations, [&](uint64_t)
+		{
+			benchmark::DoNotOptimize(sgrottel::Utf8Encoding::AsciiPrefixLength(narrow.data(), narrow.size()));
+		}), narrow.size());
+
+	if (failures != 0)
+	{
+		std::printf("FAILED: %d encoding mismatches\n", failures);
+		return 1;
+	}
+	return 0;
+}
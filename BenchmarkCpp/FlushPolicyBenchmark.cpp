@@ -0,0 +1,66 @@
+// FlushPolicyBenchmark.cpp  SimpleLog  BenchmarkCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Measures the cost per message of a log file with each flush policy, and the number of flush calls in the log statistics.
+
+#include "Benchmark.h"
+
+#include "SimpleLog/SimpleLog.hpp"
+
+#include <filesystem>
+#include <string>
+
+int main(int argc, char const* argv[])
+{
+	uint64_t const messages = benchmark::ParseIterations(argc, argv, 100000);
+
+	std::filesystem::path const dir = std::filesystem::temp_directory_path() / ("simplelog_flush_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+	std::filesystem::create_directories(dir);
+
+	struct Case
+	{
+		char const* name;
+		sgrottel::SimpleLog::FlushPolicy policy;
+	};
+	Case const cases[] = {
+		{ "every message", sgrottel::SimpleLog::FlushPolicy::EveryMessage() },
+		{ "on error", sgrottel::SimpleLog::FlushPolicy::OnLevel(sgrottel::ISimpleLog::FlagLevelError) },
+		{ "every 4 KiB", sgrottel::SimpleLog::FlushPolicy::EveryBytes(4096) },
+		{ "never", sgrottel::SimpleLog::FlushPolicy::Never() },
+	};
+
+	for (Case const& c : cases)
+	{
+		std::string const name = std::string{ "flush " } + c.name;
+		sgrottel::SimpleLog log{ dir, "flush", 2 };
+		log.SetFlushPolicy(c.policy);
+		sgrottel::LogStats const before = log.GetStats();
+		benchmark::Print(benchmark::Run(name.c_str(), messages, [&](uint64_t i)
+			{
+				// every tenth message is an error
+				uint32_t const flags = (i % 10 == 0) ? sgrottel::ISimpleLog::FlagLevelError : sgrottel::ISimpleLog::FlagLevelMessage;
+				log.Write(flags, "message %llu of the flush policy benchmark", static_cast<unsigned long long>(i));
+			}));
+		sgrottel::LogStats const after = log.GetStats();
+		std::printf("  %llu flush calls\n", static_cast<unsigned long long>(after.flushCalls - before.flushCalls));
+	}
+
+	std::error_code ec;
+	std::filesystem::remove_all(dir, ec);
+
+	return 0;
+}
@@ -0,0 +1,135 @@
+// GroupCommitBenchmark.cpp  SimpleLog  BenchmarkCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// Compares one write and flush per message with group commit, from increasing numbers of threads, flushing after every message.
+// The resulting files must be complete, and group commit must not need more write and flush calls than messages.
+
+#include "Benchmark.h"
+
+#include "SimpleLog/SimpleLog.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	/// <summary>
+	/// Writes the messages from `threadCount` threads, and returns the measured result
+	/// </summary>
+	benchmark::Result WriteFromThreads(sgrottel::SimpleLog& log, char const* mode, unsigned int threadCount, uint64_t messages)
+	{
+		uint64_t const perThread = messages / threadCount;
+		sgrottel::LogStats const before = log.GetStats();
+		std::vector<std::thread> threads;
+		auto const start = std::chrono::steady_clock::now();
+		for (unsigned int t = 0; t < threadCount; ++t)
+		{
+			threads.emplace_back([&log, perThread, t]()
+				{
+					for (uint64_t i = 0; i < perThread; ++i)
+					{
+						log.Write(sgrottel::ISimpleLog::FlagLevelMessage, "thread %u message %llu of the group commit benchmark",
+							t, static_cast<unsigned long long>(i));
+					}
+				});
+		}
+		for (std::thread& t : threads)
+		{
+			t.join();
+		}
+		auto const end = std::chrono::steady_clock::now();
+		sgrottel::LogStats const after = log.GetStats();
+
+		benchmark::Result r;
+		r.name = std::string{ mode } + ", " + std::to_string(threadCount) + " threads";
+		r.iterations = perThread * threadCount;
+		r.seconds = std::chrono::duration<double>(end - start).count();
+		benchmark::Print(r);
+		std::printf("    %llu write calls, %llu flush calls\n", static_cast<unsigned long long>(after.writeCalls - before.writeCalls),
+			static_cast<unsigned long long>(after.flushCalls - before.flushCalls));
+		return r;
+	}
+
+	/// <summary>
+	/// Checks the number of lines, and that each line is complete
+	/// </summary>
+	bool CheckFile(std::filesystem::path const& path, uint64_t expectedLines)
+	{
+		std::string const suffix = " of the group commit benchmark";
+		std::ifstream file{ path, std::ios::binary };
+		std::string line;
+		uint64_t lines = 0;
+		uint64_t broken = 0;
+		while (std::getline(file, line))
+		{
+			++lines;
+			if (line.find("| thread ") == std::string::npos || line.size() < suffix.size()
+				|| line.compare(line.size() - suffix.size(), suffix.size(), suffix) != 0) ++broken;
+		}
+		if (lines != expectedLines || broken != 0)
+		{
+			std::printf("FAILED: %s: %llu of %llu lines, %llu broken\n", path.string().c_str(), static_cast<unsigned long long>(lines),
+				static_cast<unsigned long long>(expectedLines), static_cast<unsigned long long>(broken));
+			return false;
+		}
+		return true;
+	}
+}
+
+int main(int argc, char const* argv[])
+{
+	uint64_t const messages = benchmark::ParseIterations(argc, argv, 20000);
+
+	std::filesystem::path const dir = std::filesystem::temp_directory_path() / ("simplelog_group_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+	std::filesystem::create_directories(dir);
+	bool ok = true;
+
+	for (bool grouped : { false, true })
+	{
+		char const* mode = grouped ? "group commit" : "per message";
+		uint64_t written = 0;
+		std::filesystem::path path;
+		{
+			sgrottel::SimpleLog log{ dir, mode, 2 };
+			log.SetFlushPolicy(sgrottel::SimpleLog::FlushPolicy::EveryMessage());
+			log.SetGroupCommit(grouped);
+			path = log.GetFilePath();
+			for (unsigned int threadCount : { 1u, 4u, 16u })
+			{
+				written += WriteFromThreads(log, mode, threadCount, messages).iterations;
+			}
+			sgrottel::LogStats const stats = log.GetStats();
+			if (stats.TotalMessages() != written || stats.writeCalls > written || stats.flushCalls > written)
+			{
+				std::printf("FAILED: %s: %llu of %llu messages counted, %llu write calls, %llu flush calls\n", mode,
+					static_cast<unsigned long long>(stats.TotalMessages()), static_cast<unsigned long long>(written),
+					static_cast<unsigned long long>(stats.writeCalls), static_cast<unsigned long long>(stats.flushCalls));
+				ok = false;
+			}
+		}
+		ok = CheckFile(path, written) && ok;
+	}
+
+	std::error_code ec;
+	std::filesystem::remove_all(dir, ec);
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,248 @@
+// LatencyHarness.cpp  SimpleLog  BenchmarkCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// Measures the latency of each write call, and the aggregate throughput, with increasing numbers of producer threads.
+// Averages hide lock contention and slow flushes; the percentiles of the per-call latencies show them.
+//
+// Options:
+//   --iterations N    messages per thread count, over all threads
+//   --threads N       highest thread count; thread counts double from 1
+//   --size N          characters of payload in each message
+//   --mix C,E,W,M,D   relative weights of critical, error, warning, message, and detail messages
+//   --rate N          messages per second and thread; 0 writes as fast as possible
+//   --sink LIST       comma-separated list of: null, file, flushed, mapped, async
+//
+// With a rate, late calls are measured from their scheduled time, so a stalled call also counts for the calls it delayed.
+
+#include "Benchmark.h"
+
+#include "SimpleLog/SimpleLog.hpp"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct Config
+	{
+		uint64_t messages{ 100000 };
+		unsigned int maxThreads{ 16 };
+		size_t size{ 64 };
+		std::array<unsigned int, 5> mix{ 0, 1, 4, 80, 15 };
+		uint64_t rate{ 0 };
+		std::string sinks{ "null,file,flushed,mapped,async" };
+	};
+
+	char const* FindArg(int argc, char const* const* argv, char const* name)
+	{
+		for (int i = 1; i + 1 < argc; ++i)
+		{
+			if (std::strcmp(argv[i], name) == 0) return argv[i + 1];
+		}
+		return nullptr;
+	}
+
+	Config ParseConfig(int argc, char const* const* argv)
+	{
+		Config config;
+		config.messages = benchmark::ParseIterations(argc, argv, config.messages);
+		if (char const* v = FindArg(argc, argv, "--threads")) config.maxThreads = static_cast<unsigned int>(std::strtoul(v, nullptr, 10));
+		if (char const* v = FindArg(argc, argv, "--size")) config.size = static_cast<size_t>(std::strtoull(v, nullptr, 10));
+		if (char const* v = FindArg(argc, argv, "--rate")) config.rate = std::strtoull(v, nullptr, 10);
+		if (char const* v = FindArg(argc, argv, "--sink")) config.sinks = v;
+		if (char const* v = FindArg(argc, argv, "--mix"))
+		{
+			char* end = const_cast<char*>(v);
+			for (unsigned int& weight : config.mix)
+			{
+				weight = static_cast<unsigned int>(std::strtoul(end, &end, 10));
+				if (*end == ',') ++end;
+			}
+		}
+		if (config.maxThreads < 1) config.maxThreads = 1;
+		return config;
+	}
+
+	/// <summary>
+	/// Selects the level of each message by the weights of the mix, with a fixed pseudo-random sequence per thread
+	/// </summary>
+	class LevelMix
+	{
+	public:
+		LevelMix(std::array<unsigned int, 5> const& weights, unsigned int seed) : m_weights{ weights }, m_state{ seed * 2654435761u + 1u }
+		{
+			for (unsigned int w : m_weights) m_total += w;
+		}
+
+		uint32_t Next()
+		{
+			static constexpr uint32_t levels[5] = {
+				sgrottel::ISimpleLog::FlagLevelCritical,
+				sgrottel::ISimpleLog::FlagLevelError,
+				sgrottel::ISimpleLog::FlagLevelWarning,
+				sgrottel::ISimpleLog::FlagLevelMessage,
+				sgrottel::ISimpleLog::FlagLevelDetail };
+			if (m_total == 0) return sgrottel::ISimpleLog::FlagLevelMessage;
+			m_state = m_state * 1664525u + 1013904223u;
+			unsigned int pick = (m_state >> 8) % m_total;
+			for (size_t i = 0; i < 5; ++i)
+			{
+				if (pick < m_weights[i]) return levels[i];
+				pick -= m_weights[i];
+			}
+			return sgrottel::ISimpleLog::FlagLevelMessage;
+		}
+
+	private:
+		std::array<unsigned int, 5> m_weights;
+		unsigned int m_total{ 0 };
+		uint32_t m_state;
+	};
+
+	/// <summary>
+	/// Writes the messages from `threadCount` threads, recording the latency of each call
+	/// </summary>
+	void Measure(sgrottel::ISimpleLog const& log, char const* sink, unsigned int threadCount, Config const& config)
+	{
+		using clock = std::chrono::steady_clock;
+		uint64_t const perThread = config.messages / threadCount;
+		std::string const payload(config.size, 'x');
+		std::vector<benchmark::Histogram> histograms(threadCount);
+		std::vector<std::thread> threads;
+
+		clock::duration const interval = (config.rate > 0)
+			? std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / static_cast<double>(config.rate)))
+			: clock::duration::zero();
+		clock::time_point const start = clock::now();
+		for (unsigned int t = 0; t < threadCount; ++t)
+		{
+			threads.emplace_back([&, t]()
+				{
+					LevelMix mix{ config.mix, t };
+					benchmark::Histogram& histogram = histograms[t];
+					for (uint64_t i = 0; i < perThread; ++i)
+					{
+						uint32_t const level = mix.Next();
+						clock::time_point begin = clock::now();
+						if (interval != clock::duration::zero())
+						{
+							clock::time_point const scheduled = start + interval * static_cast<clock::rep>(i);
+							if (begin < scheduled)
+							{
+								// on time: the wake-up delay of the sleep is not part of the latency
+								std::this_thread::sleep_until(scheduled);
+								begin = clock::now();
+							}
+							else
+							{
+								begin = scheduled;
+							}
+						}
+						log.Write(level, "thread %u message %llu %s", t, static_cast<unsigned long long>(i), payload.c_str());
+						clock::time_point const end = clock::now();
+						histogram.Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()));
+					}
+				});
+		}
+		for (std::thread& t : threads)
+		{
+			t.join();
+		}
+		clock::time_point const end = clock::now();
+
+		benchmark::Histogram all;
+		for (benchmark::Histogram const& h : histograms)
+		{
+			all.Add(h);
+		}
+		double const seconds = std::chrono::duration<double>(end - start).count();
+		std::string const name = std::string{ sink } + ", " + std::to_string(threadCount) + " threads";
+		std::printf("%-24s %12.0f msg/s  p50 %9llu ns  p99 %9llu ns  p99.9 %9llu ns  max %10llu ns\n", name.c_str(),
+			(seconds > 0.0) ? static_cast<double>(all.Count()) / seconds : 0.0,
+			static_cast<unsigned long long>(all.Percentile(50.0)), static_cast<unsigned long long>(all.Percentile(99.0)),
+			static_cast<unsigned long long>(all.Percentile(99.9)), static_cast<unsigned long long>(all.Max()));
+	}
+}
+
+int main(int argc, char const* argv[])
+{
+	Config const config = ParseConfig(argc, argv);
+
+	std::filesystem::path const dir = std::filesystem::temp_directory_path() / ("simplelog_latency_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+	std::filesystem::create_directories(dir);
+	bool ok = true;
+
+	size_t pos = 0;
+	while (pos <= config.sinks.size())
+	{
+		size_t const next = std::min(config.sinks.find(',', pos), config.sinks.size());
+		std::string const sink = config.sinks.substr(pos, next - pos);
+		pos = next + 1;
+		if (sink.empty()) continue;
+
+		std::unique_ptr<sgrottel::NullLog> null;
+		std::unique_ptr<sgrottel::SimpleLog> file;
+		std::unique_ptr<sgrottel::AsyncSimpleLog> async;
+		sgrottel::ISimpleLog const* target = nullptr;
+		if (sink == "null")
+		{
+			null = std::make_unique<sgrottel::NullLog>();
+			target = null.get();
+		}
+		else if (sink == "file" || sink == "flushed" || sink == "async")
+		{
+			// the default flush policy writes every message to the storage device
+			file = std::make_unique<sgrottel::SimpleLog>(dir, sink, 2);
+			if (sink != "flushed") file->SetFlushPolicy(sgrottel::SimpleLog::FlushPolicy::Never());
+			target = file.get();
+			if (sink == "async")
+			{
+				async = std::make_unique<sgrottel::AsyncSimpleLog>(*file);
+				target = async.get();
+			}
+		}
+		else if (sink == "mapped")
+		{
+			file = std::make_unique<sgrottel::SimpleLog>(dir, sink, 2, sgrottel::SimpleLog::Options::MemoryMapped());
+			target = file.get();
+		}
+		else
+		{
+			std::printf("FAILED: unknown sink '%s'\n", sink.c_str());
+			ok = false;
+			continue;
+		}
+
+		for (unsigned int threadCount = 1; threadCount <= config.maxThreads; threadCount *= 2)
+		{
+			Measure(*target, sink.c_str(), threadCount, config);
+		}
+		async.reset();
+		file.reset();
+	}
+
+	std::error_code ec;
+	std::filesystem::remove_all(dir, ec);
+
+	return ok ? 0 : 1;
+}
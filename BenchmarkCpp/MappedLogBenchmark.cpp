@@ -0,0 +1,206 @@
+// MappedLogBenchmark.cpp  SimpleLog  BenchmarkCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Compares the file write mode with the memory-mapped write mode, from increasing numbers of threads.
+// Small segments make many lines cross segment boundaries. The resulting files must be complete and trimmed.
+// On POSIX systems, a file size limit makes segments fail to map. Their lines are dropped, and writing must continue after the limit is lifted.
+
+#include "Benchmark.h"
+
+#include "SimpleLog/SimpleLog.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <csignal>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	/// <summary>
+	/// Writes the messages from `threadCount` threads, and returns the measured result
+	/// </summary>
+	benchmark::Result WriteFromThreads(sgrottel::SimpleLog& log, char const* mode, unsigned int threadCount, uint64_t messages)
+	{
+		uint64_t const perThread = messages / threadCount;
+		std::vector<std::thread> threads;
+		auto const start = std::chrono::steady_clock::now();
+		for (unsigned int t = 0; t < threadCount; ++t)
+		{
+			threads.emplace_back([&log, perThread, t]()
+				{
+					for (uint64_t i = 0; i < perThread; ++i)
+					{
+						log.Write(sgrottel::ISimpleLog::FlagLevelMessage, "thread %u message %llu of the mapped log benchmark",
+							t, static_cast<unsigned long long>(i));
+					}
+				});
+		}
+		for (std::thread& t : threads)
+		{
+			t.join();
+		}
+		auto const end = std::chrono::steady_clock::now();
+
+		benchmark::Result r;
+		r.name = std::string{ mode } + ", " + std::to_string(threadCount) + " threads";
+		r.iterations = perThread * threadCount;
+		r.seconds = std::chrono::duration<double>(end - start).count();
+		return r;
+	}
+
+	/// <summary>
+	/// Checks the number of lines, and that each line is complete
+	/// </summary>
+	bool CheckFile(std::filesystem::path const& path, uint64_t expectedLines)
+	{
+		std::string const suffix = " of the mapped log benchmark";
+		std::ifstream file{ path, std::ios::binary };
+		std::string line;
+		uint64_t lines = 0;
+		uint64_t broken = 0;
+		while (std::getline(file, line))
+		{
+			++lines;
+			if (line.find("| thread ") == std::string::npos || line.size() < suffix.size()
+				|| line.compare(line.size() - suffix.size(), suffix.size(), suffix) != 0) ++broken;
+		}
+		if (lines != expectedLines || broken != 0)
+		{
+			std::printf("FAILED: %s: %llu of %llu lines, %llu broken\n", path.string().c_str(), static_cast<unsigned long long>(lines),
+				static_cast<unsigned long long>(expectedLines), static_cast<unsigned long long>(broken));
+			return false;
+		}
+		return true;
+	}
+
+#if !defined(_WIN32)
+	/// <summary>
+	/// Writes lines while segments fail to map, and checks that all other lines are complete
+	/// </summary>
+	bool CheckFailedMaps(std::filesystem::path const& dir)
+	{
+		constexpr size_t segmentSize = 64 * 1024;
+		constexpr uint64_t limitedMessages = 5000;
+		constexpr uint64_t messages = 20000;
+
+		struct rlimit original;
+		if (::getrlimit(RLIMIT_FSIZE, &original) != 0) return true;
+		std::signal(SIGXFSZ, SIG_IGN);
+		// a hang on a blocked segment slot fails the test
+		::alarm(120);
+
+		sgrottel::LogStats stats;
+		std::filesystem::path path;
+		{
+			sgrottel::SimpleLog log{ dir, "failedmaps", 2, sgrottel::SimpleLog::Options::MemoryMapped(segmentSize) };
+			log.SetFlushPolicy(sgrottel::SimpleLog::FlushPolicy::Never());
+			path = log.GetFilePath();
+
+			struct rlimit limited = original;
+			limited.rlim_cur = 3 * segmentSize;
+			::setrlimit(RLIMIT_FSIZE, &limited);
+			for (uint64_t i = 0; i < messages; ++i)
+			{
+				if (i == limitedMessages)
+				{
+					::setrlimit(RLIMIT_FSIZE, &original);
+				}
+				log.Write(sgrottel::ISimpleLog::FlagLevelMessage, "thread %u message %llu of the mapped log benchmark",
+					0u, static_cast<unsigned long long>(i));
+			}
+			stats = log.GetStats();
+		}
+		::setrlimit(RLIMIT_FSIZE, &original);
+		::alarm(0);
+
+		// lines of segments which failed to map are zero bytes in the file
+		std::string const suffix = " of the mapped log benchmark";
+		std::ifstream file{ path, std::ios::binary };
+		std::string line;
+		uint64_t complete = 0;
+		uint64_t broken = 0;
+		while (std::getline(file, line))
+		{
+			if (line.find('\0') != std::string::npos) continue;
+			if (line.find("| thread ") == std::string::npos || line.size() < suffix.size()
+				|| line.compare(line.size() - suffix.size(), suffix.size(), suffix) != 0) ++broken;
+			else ++complete;
+		}
+		if (stats.droppedMessages == 0 || complete + stats.droppedMessages != messages || broken != 0)
+		{
+			std::printf("FAILED: failed maps: %llu complete lines, %llu dropped of %llu, %llu broken\n",
+				static_cast<unsigned long long>(complete), static_cast<unsigned long long>(stats.droppedMessages),
+				static_cast<unsigned long long>(messages), static_cast<unsigned long long>(broken));
+			return false;
+		}
+		return true;
+	}
+#endif
+}
+
+int main(int argc, char const* argv[])
+{
+	uint64_t const messages = benchmark::ParseIterations(argc, argv, 400000);
+
+	std::filesystem::path const dir = std::filesystem::temp_directory_path() / ("simplelog_mapped_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+	std::filesystem::create_directories(dir);
+	bool ok = true;
+
+	for (bool mapped : { false, true })
+	{
+		char const* mode = mapped ? "memory-mapped" : "file";
+		uint64_t written = 0;
+		std::filesystem::path path;
+		{
+			sgrottel::SimpleLog log{ dir, mode, 2, mapped ? sgrottel::SimpleLog::Options::MemoryMapped(64 * 1024) : sgrottel::SimpleLog::Options::File() };
+			log.SetFlushPolicy(sgrottel::SimpleLog::FlushPolicy::Never());
+			path = log.GetFilePath();
+			for (unsigned int threadCount : { 1u, 2u, 4u, 8u })
+			{
+				benchmark::Result const r = WriteFromThreads(log, mode, threadCount, messages);
+				benchmark::Print(r);
+				written += r.iterations;
+			}
+		}
+		ok = CheckFile(path, written) && ok;
+	}
+
+	// retention of trimmed memory-mapped log files
+	for (int i = 0; i < 2; ++i)
+	{
+		sgrottel::SimpleLog log{ dir, "retention", 2, sgrottel::SimpleLog::Options::MemoryMapped(64 * 1024) };
+		WriteFromThreads(log, "retention", 2, 1000);
+		log.Flush();
+	}
+	ok = CheckFile(dir / "retention.log", 1000) && CheckFile(dir / "retention.1.log", 1000) && ok;
+
+#if !defined(_WIN32)
+	ok = CheckFailedMaps(dir) && ok;
+#endif
+
+	std::error_code ec;
+	std::filesystem::remove_all(dir, ec);
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+// MinLevelBenchmark.cpp  SimpleLog  BenchmarkCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// This translation unit is compiled with `SIMPLELOG_MIN_LEVEL=SIMPLELOG_LEVEL_WARNING`.
+// Detail and message calls are compiled out and must cost the same as the empty loop.
+
+#include "Benchmark.h"
+
+#include "SimpleLog/SimpleLog.hpp"
+
+#include <string>
+
+static_assert(!sgrottel::ISimpleLog::IsLevelCompiledIn(sgrottel::ISimpleLog::FlagLevelDetail));
+static_assert(!sgrottel::ISimpleLog::IsLevelCompiledIn(sgrottel::ISimpleLog::FlagLevelMessage));
+static_assert(sgrottel::ISimpleLog::IsLevelCompiledIn(sgrottel::ISimpleLog::FlagLevelWarning));
+
+namespace
+{
+	int g_evaluations = 0;
+
+	[[maybe_unused]] int ExpensiveArgument(uint64_t i)
+	{
+		++g_evaluations;
+		return static_cast<int>(i * 7);
+	}
+
+	/// <summary>
+	/// Counts messages which reach the log implementation
+	/// </summary>
+	class CountingLog : public sgrottel::ISimpleLog
+	{
+	public:
+		mutable uint64_t count = 0;
+	protected:
+		void WriteImpl(uint32_t, char const*, size_t) const override { ++count; }
+		void WriteImpl(uint32_t, wchar_t const*, size_t) const override { ++count; }
+	};
+}
+
+int main(int argc, char const* argv[])
+{
+	uint64_t const iterations = benchmark::ParseIterations(argc, argv, 100000000);
+	CountingLog log;
+	sgrottel::ISimpleLog const& ilog = log;
+
+	benchmark::Print(benchmark::Run("empty loop", iterations, [](uint64_t i) { benchmark::DoNotOptimize(i); }));
+	benchmark::Print(benchmark::Run("Detail() compiled out", iterations, [&](uint64_t i)
+		{
+			benchmark::DoNotOptimize(i);
+			ilog.Detail("value %d of %s", static_cast<int>(i), "detail");
+		}));
+	benchmark::Print(benchmark::Run("Write(FlagLevelDetail) compiled out", iterations, [&](uint64_t i)
+		{
+			benchmark::DoNotOptimize(i);
+			ilog.Write(sgrottel::ISimpleLog::FlagLevelDetail, "value %d of %s", static_cast<int>(i), "detail");
+		}));
+	benchmark::Print(benchmark::Run("SIMPLELOG_DETAIL() compiled out", iterations, [&](uint64_t i)
+		{
+			benchmark::DoNotOptimize(i);
+			SIMPLELOG_DETAIL(ilog, "value %d", ExpensiveArgument(i));
+		}));
+	uint64_t const enabledIterations = iterations / 100 + 1;
+	uint64_t const disabledCount = log.count;
+	benchmark::Print(benchmark::Run("Warning() enabled, for comparison", enabledIterations, [&](uint64_t i)
+		{
+			benchmark::DoNotOptimize(i);
+			ilog.Warning("value %d of %s", static_cast<int>(i), "warning");
+		}));
+	uint64_t const enabledCount = log.count - disabledCount;
+
+	// correctness: compiled out calls never reach the log, and the macros never evaluate their arguments
+	if (disabledCount != 0 || enabledCount == 0 || g_evaluations != 0)
+	{
+		std::printf("FAILED: %llu compiled out messages written, %llu enabled messages written, %d arguments evaluated\n",
+			static_cast<unsigned long long>(disabledCount), static_cast<unsigned long long>(enabledCount), g_evaluations);
+		return 1;
+	}
+	return 0;
+}
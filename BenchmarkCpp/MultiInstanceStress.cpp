@@ -0,0 +1,159 @@
+// MultiInstanceStress.cpp  SimpleLog  BenchmarkCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Writes several independent log files in parallel from many threads.
+// Every line must end up complete and unaltered in the file of its log instance.
+
+#include "Benchmark.h"
+
+#include "SimpleLog/SimpleLog.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr int LogCount = 4;
+	constexpr int ThreadCount = 8;
+
+	/// <summary>
+	/// Varying message lengths make the scratch buffers grow and shrink
+	/// </summary>
+	size_t PaddingLength(int thread, int message)
+	{
+		return static_cast<size_t>((thread * 131 + message * 17) % 700);
+	}
+
+	/// <summary>
+	/// The expected UTF8 message text, matching what the writer threads log
+	/// </summary>
+	std::string ExpectedText(int log, int thread, int message)
+	{
+		std::string text = "log " + std::to_string(log) + " thread " + std::to_string(thread) + " message " + std::to_string(message)
+			+ ((message % 2 == 0) ? " narrow " : " wide \xc3\xbc ");
+		text.append(PaddingLength(thread, message), static_cast<char>('a' + log));
+		return text;
+	}
+}
+
+int main(int argc, char const* argv[])
+{
+	int const messages = static_cast<int>(benchmark::ParseIterations(argc, argv, 20000));
+
+	std::filesystem::path const dir = std::filesystem::temp_directory_path() / ("simplelog_stress_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+	std::filesystem::create_directories(dir);
+
+	std::vector<std::unique_ptr<sgrottel::SimpleLog>> logs;
+	for (int l = 0; l < LogCount; ++l)
+	{
+		logs.push_back(std::make_unique<sgrottel::SimpleLog>(dir, "stress" + std::to_string(l), 2));
+		logs.back()->SetFlushPolicy(sgrottel::SimpleLog::FlushPolicy::Never());
+	}
+	std::vector<std::filesystem::path> paths;
+	for (auto const& log : logs)
+	{
+		paths.push_back(log->GetFilePath());
+	}
+
+	auto const start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for (int t = 0; t < ThreadCount; ++t)
+	{
+		threads.emplace_back([&, t]()
+			{
+				std::string narrowPad;
+				std::wstring widePad;
+				for (int m = 0; m < messages; ++m)
+				{
+					int const l = (t + m) % LogCount;
+					size_t const padLen = PaddingLength(t, m);
+					if (m % 2 == 0)
+					{
+						narrowPad.assign(padLen, static_cast<char>('a' + l));
+						logs[l]->Write(sgrottel::ISimpleLog::FlagLevelMessage, "log %d thread %d message %d narrow %s", l, t, m, narrowPad.c_str());
+					}
+					else
+					{
+						widePad.assign(padLen, static_cast<wchar_t>(L'a' + l));
+						logs[l]->WriteFormat(sgrottel::ISimpleLog::FlagLevelMessage, L"log {} thread {} message {} wide ü {}", l, t, m, widePad);
+					}
+				}
+			});
+	}
+	for (std::thread& t : threads)
+	{
+		t.join();
+	}
+	auto const end = std::chrono::steady_clock::now();
+	logs.clear();
+
+	double const seconds = std::chrono::duration<double>(end - start).count();
+	std::printf("%d logs, %d threads, %d messages each: %.3f s, %.0f messages/s\n",
+		LogCount, ThreadCount, messages, seconds, static_cast<double>(ThreadCount) * messages / seconds);
+
+	// correctness: each log file contains exactly the lines written to it
+	int failures = 0;
+	for (int l = 0; l < LogCount; ++l)
+	{
+		std::vector<int> next(ThreadCount, 0);
+		for (int t = 0; t < ThreadCount; ++t)
+		{
+			while (next[t] < messages && (t + next[t]) % LogCount != l) ++next[t];
+		}
+		std::ifstream file{ paths[l], std::ios::binary };
+		std::string line;
+		while (std::getline(file, line))
+		{
+			size_t const sep = line.find("| ");
+			int thread = -1;
+			if (sep != std::string::npos)
+			{
+				size_t const pos = line.find(" thread ", sep);
+				if (pos != std::string::npos) thread = std::atoi(line.c_str() + pos + 8);
+			}
+			if (thread < 0 || thread >= ThreadCount || next[thread] >= messages
+				|| line.compare(sep + 2, std::string::npos, ExpectedText(l, thread, next[thread])) != 0)
+			{
+				if (failures++ < 5) std::printf("Unexpected line in log %d: %.80s\n", l, line.c_str());
+				continue;
+			}
+			// messages of one thread are written in order
+			do { ++next[thread]; } while (next[thread] < messages && (thread + next[thread]) % LogCount != l);
+		}
+		for (int t = 0; t < ThreadCount; ++t)
+		{
+			if (next[t] < messages)
+			{
+				if (failures++ < 5) std::printf("Missing messages of thread %d in log %d\n", t, l);
+			}
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::remove_all(dir, ec);
+
+	if (failures != 0)
+	{
+		std::printf("FAILED: %d errors\n", failures);
+		return 1;
+	}
+	return 0;
+}
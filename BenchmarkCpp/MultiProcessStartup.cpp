@@ -0,0 +1,208 @@
+// MultiProcessStartup.cpp  SimpleLog  BenchmarkCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Starts many processes at once, which each create a log and write one message.
+// Processes creating logs of different names do not wait for each other.
+// Processes creating the same log are serialized, and each of them must end up in its own retained log file.
+// The setup lock must also work for non-ASCII paths, and derive the same mutex name as the CSharp implementation.
+
+#include "Benchmark.h"
+
+#include "SimpleLog/SimpleLog.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	constexpr int retention = 10;
+
+	/// <summary>
+	/// The work of one child process
+	/// </summary>
+	int Child(std::filesystem::path const& dir, std::string const& name)
+	{
+		try
+		{
+			sgrottel::SimpleLog log{ dir, name, retention };
+			log.Write(sgrottel::ISimpleLog::FlagLevelMessage, "child process started");
+			return 0;
+		}
+		catch (...)
+		{
+			return 1;
+		}
+	}
+
+	/// <summary>
+	/// Starts `count` child processes, waits for all of them, and returns the measured result
+	/// </summary>
+	benchmark::Result RunChildren(char const* self, std::filesystem::path const& dir, char const* mode, unsigned int count, bool sameName, bool& ok)
+	{
+		auto const start = std::chrono::steady_clock::now();
+#if defined(_WIN32)
+		std::vector<PROCESS_INFORMATION> children;
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			std::string const name = sameName ? "same" : ("child" + std::to_string(i));
+			std::string cmd = "\"" + std::string{ self } + "\" --child \"" + dir.string() + "\" " + name;
+			STARTUPINFOA si{};
+			si.cb = sizeof(si);
+			PROCESS_INFORMATION pi{};
+			if (!CreateProcessA(nullptr, cmd.data(), nullptr, nullptr, FALSE, 0, nullptr, nullptr, &si, &pi))
+			{
+				ok = false;
+				continue;
+			}
+			CloseHandle(pi.hThread);
+			children.push_back(pi);
+		}
+		for (PROCESS_INFORMATION const& pi : children)
+		{
+			WaitForSingleObject(pi.hProcess, INFINITE);
+			DWORD code = 1;
+			GetExitCodeProcess(pi.hProcess, &code);
+			if (code != 0) ok = false;
+			CloseHandle(pi.hProcess);
+		}
+#else
+		(void)self;
+		std::vector<pid_t> children;
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			std::string const name = sameName ? "same" : ("child" + std::to_string(i));
+			pid_t const pid = ::fork();
+			if (pid == 0)
+			{
+				::_exit(Child(dir, name));
+			}
+			if (pid < 0)
+			{
+				ok = false;
+				continue;
+			}
+			children.push_back(pid);
+		}
+		for (pid_t pid : children)
+		{
+			int status = 0;
+			while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+			if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) ok = false;
+		}
+#endif
+		auto const end = std::chrono::steady_clock::now();
+
+		benchmark::Result r;
+		r.name = std::string{ mode } + ", " + std::to_string(count) + " processes";
+		r.iterations = count;
+		r.seconds = std::chrono::duration<double>(end - start).count();
+		return r;
+	}
+
+	uint64_t CountLines(std::filesystem::path const& path)
+	{
+		std::ifstream file{ path };
+		std::string line;
+		uint64_t lines = 0;
+		while (std::getline(file, line)) ++lines;
+		return lines;
+	}
+}
+
+int main(int argc, char const* argv[])
+{
+	if (argc == 4 && std::string{ argv[1] } == "--child")
+	{
+		return Child(argv[2], argv[3]);
+	}
+
+	unsigned int const count = static_cast<unsigned int>(benchmark::ParseIterations(argc, argv, 200));
+
+	std::filesystem::path const dir = std::filesystem::temp_directory_path() / ("simplelog_processes_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+	std::filesystem::create_directories(dir);
+	bool ok = true;
+
+	benchmark::Print(RunChildren(argv[0], dir, "different logs", count, false, ok));
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		if (CountLines(dir / ("child" + std::to_string(i) + ".log")) != 1) ok = false;
+	}
+	if (!ok) std::printf("FAILED: different logs\n");
+
+	benchmark::Print(RunChildren(argv[0], dir, "same log", count, true, ok));
+	// each process renamed the files of the previous ones, so the retained files hold one message each
+	unsigned int const expected = std::min<unsigned int>(count, retention);
+	for (unsigned int i = 0; i < expected; ++i)
+	{
+		std::filesystem::path const p = dir / ((i == 0) ? std::string{ "same.log" } : ("same." + std::to_string(i) + ".log"));
+		if (CountLines(p) != 1)
+		{
+			std::printf("FAILED: same log: %s\n", p.string().c_str());
+			ok = false;
+		}
+	}
+
+	// the setup lock of a non-ASCII log directory
+	{
+		std::filesystem::path const unicodeDir = dir / std::filesystem::u8path(u8"\u00dcber \u7834\u6ec5");
+		for (int i = 0; i < 2; ++i)
+		{
+			sgrottel::SimpleLog log{ unicodeDir, "unicode", retention };
+			log.Write(sgrottel::ISimpleLog::FlagLevelMessage, "child process started");
+		}
+		if (CountLines(unicodeDir / "unicode.log") != 1 || CountLines(unicodeDir / "unicode.1.log") != 1)
+		{
+			std::printf("FAILED: non-ASCII log directory\n");
+			ok = false;
+		}
+	}
+
+	// the names of the setup mutex on Windows, as derived by the CSharp implementation
+	struct MutexNameCase
+	{
+		wchar_t const* fullPath;
+		wchar_t const* mutexName;
+	};
+	MutexNameCase const mutexNames[] = {
+		{ L"C:\\Logs\\\u00dcber\\MyApp", L"SGROTTEL_SIMPLELOG_4602b0092dfd3ec1" },
+		{ L"C:\\LOGS\\\u00dcber\\MYAPP", L"SGROTTEL_SIMPLELOG_4602b0092dfd3ec1" },
+		{ L"C:\\Logs\\\u00fcber\\MyApp", L"SGROTTEL_SIMPLELOG_4f4e1c34c34ca1a1" },
+		{ L"C:\\Logs\\\U0001F600\\MyApp", L"SGROTTEL_SIMPLELOG_71bb60f1ab95bc99" },
+	};
+	for (MutexNameCase const& c : mutexNames)
+	{
+		if (sgrottel::SimpleLog::GetSetupMutexName(c.fullPath) != c.mutexName)
+		{
+			std::printf("FAILED: setup mutex name %ls\n", c.mutexName);
+			ok = false;
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::remove_all(dir, ec);
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+// RetentionBenchmark.cpp  SimpleLog  BenchmarkCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Measures the construction of logs with many retained log files, for numbered and for time-stamped file names.
+// Numbered file names rename all retained files on construction, time-stamped file names only create one file.
+
+#include "Benchmark.h"
+
+#include "SimpleLog/SimpleLog.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace
+{
+	size_t CountFiles(std::filesystem::path const& dir)
+	{
+		size_t count = 0;
+		for (std::filesystem::directory_entry const& entry : std::filesystem::directory_iterator{ dir })
+		{
+			std::string const fn = entry.path().filename().string();
+			if (fn.size() > 4 && fn.compare(fn.size() - 4, 4, ".log") == 0) ++count;
+		}
+		return count;
+	}
+}
+
+int main(int argc, char const* argv[])
+{
+	uint64_t const iterations = benchmark::ParseIterations(argc, argv, 200);
+
+	std::filesystem::path const root = std::filesystem::temp_directory_path() / ("simplelog_retention_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+	bool ok = true;
+
+	for (int retention : { 2, 10, 50 })
+	{
+		for (bool stamped : { false, true })
+		{
+			std::filesystem::path const dir = root / (std::to_string(retention) + (stamped ? "_stamped" : "_numbered"));
+			std::filesystem::create_directories(dir);
+			sgrottel::SimpleLog::Options const options = stamped ? sgrottel::SimpleLog::Options::TimeStamped() : sgrottel::SimpleLog::Options::File();
+
+			// only the construction is measured; the destruction waits for the background pruning
+			double seconds = 0.0;
+			for (uint64_t i = 0; i < iterations; ++i)
+			{
+				auto const start = std::chrono::steady_clock::now();
+				auto log = std::make_unique<sgrottel::SimpleLog>(dir, "retention", retention, options);
+				seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+				log->Write(sgrottel::ISimpleLog::FlagLevelMessage, "log %llu", static_cast<unsigned long long>(i));
+			}
+
+			benchmark::Result r;
+			r.name = std::string{ stamped ? "time-stamped" : "numbered" } + ", retention " + std::to_string(retention);
+			r.iterations = iterations;
+			r.seconds = seconds;
+			benchmark::Print(r);
+
+			size_t const files = CountFiles(dir);
+			if (files != static_cast<size_t>(retention))
+			{
+				std::printf("FAILED: %s: %zu files retained\n", r.name.c_str(), files);
+				ok = false;
+			}
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::remove_all(root, ec);
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,225 @@
+// RingBenchmark.cpp  SimpleLog  BenchmarkCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// Compares detail messages written to a log file with the in-memory ring of a memory-only log, from increasing numbers of threads.
+// The ring content must only hold complete lines, also when read while threads are writing, and end with the last message written.
+
+#include "Benchmark.h"
+
+#include "SimpleLog/SimpleLog.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	char const* const Suffix = " of the ring benchmark";
+
+	/// <summary>
+	/// Writes the messages from `threadCount` threads, and returns the measured result
+	/// </summary>
+	benchmark::Result WriteFromThreads(sgrottel::SimpleLog& log, char const* mode, unsigned int threadCount, uint64_t messages)
+	{
+		uint64_t const perThread = messages / threadCount;
+		std::vector<std::thread> threads;
+		auto const start = std::chrono::steady_clock::now();
+		for (unsigned int t = 0; t < threadCount; ++t)
+		{
+			threads.emplace_back([&log, perThread, t]()
+				{
+					for (uint64_t i = 0; i < perThread; ++i)
+					{
+						log.Detail("thread %u message %llu%s", t, static_cast<unsigned long long>(i), Suffix);
+					}
+				});
+		}
+		for (std::thread& t : threads)
+		{
+			t.join();
+		}
+		auto const end = std::chrono::steady_clock::now();
+
+		benchmark::Result r;
+		r.name = std::string{ mode } + ", " + std::to_string(threadCount) + " threads";
+		r.iterations = perThread * threadCount;
+		r.seconds = std::chrono::duration<double>(end - start).count();
+		return r;
+	}
+
+	/// <summary>
+	/// Checks that the content only holds complete lines, with increasing message numbers per thread, and returns their number.
+	/// Lines not written yet, or left from an earlier round through the ring, break the order.
+	/// </summary>
+	bool CheckLines(std::string const& content, char const* what, uint64_t& lines)
+	{
+		std::string const suffix = Suffix;
+		std::istringstream stream{ content };
+		std::string line;
+		std::map<unsigned int, unsigned long long> lastMessage;
+		lines = 0;
+		uint64_t broken = 0;
+		while (std::getline(stream, line))
+		{
+			++lines;
+			size_t const pos = line.find("|DETAIL thread ");
+			unsigned int thread = 0;
+			unsigned long long message = 0;
+			if (pos == std::string::npos || line.size() < suffix.size()
+				|| line.compare(line.size() - suffix.size(), suffix.size(), suffix) != 0
+				|| std::sscanf(line.c_str() + pos, "|DETAIL thread %u message %llu", &thread, &message) != 2)
+			{
+				++broken;
+				continue;
+			}
+			auto const last = lastMessage.find(thread);
+			if (last != lastMessage.end() && last->second >= message) ++broken;
+			lastMessage[thread] = message;
+		}
+		if (broken != 0 || (!content.empty() && content.back() != '\n'))
+		{
+			std::printf("FAILED: %s: %llu of %llu lines broken\n", what, static_cast<unsigned long long>(broken), static_cast<unsigned long long>(lines));
+			return false;
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// Checks the ring content after the threads finished
+	/// </summary>
+	bool CheckRing(sgrottel::SimpleLog const& log, size_t ringSize, unsigned int threadCount, uint64_t perThread, std::filesystem::path const& dumpPath)
+	{
+		std::string const content = log.GetRingContent();
+		uint64_t lines = 0;
+		bool ok = CheckLines(content, "ring", lines);
+		if (content.size() > ringSize || content.size() < ringSize / 2)
+		{
+			std::printf("FAILED: ring holds %llu bytes\n", static_cast<unsigned long long>(content.size()));
+			ok = false;
+		}
+		// the newest line is the last message of the thread finishing last
+		bool lastFound = false;
+		for (unsigned int t = 0; t < threadCount; ++t)
+		{
+			std::string const last = "|DETAIL thread " + std::to_string(t) + " message " + std::to_string(perThread - 1) + Suffix + "\n";
+			lastFound = lastFound || (content.size() >= last.size() && content.compare(content.size() - last.size(), last.size(), last) == 0);
+		}
+		if (!lastFound)
+		{
+			std::printf("FAILED: ring does not end with a last message\n");
+			ok = false;
+		}
+
+		// both dump functions give the same content
+		std::string dumped;
+		log.DumpRing([&dumped](char const* data, size_t len) { dumped.append(data, len); });
+		if (dumped != content)
+		{
+			std::printf("FAILED: ring dump to callback differs\n");
+			ok = false;
+		}
+		if (!log.DumpRing(dumpPath))
+		{
+			std::printf("FAILED: ring dump to file\n");
+			return false;
+		}
+		std::ifstream file{ dumpPath, std::ios::binary };
+		std::string const fileContent{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+		if (fileContent != content)
+		{
+			std::printf("FAILED: ring dump to file differs\n");
+			ok = false;
+		}
+		return ok;
+	}
+}
+
+int main(int argc, char const* argv[])
+{
+	uint64_t const messages = benchmark::ParseIterations(argc, argv, 400000);
+	size_t const ringSize = 64 * 1024;
+
+	std::filesystem::path const dir = std::filesystem::temp_directory_path() / ("simplelog_ring_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+	std::filesystem::create_directories(dir);
+	bool ok = true;
+
+	{
+		sgrottel::SimpleLog log{ dir, "file", 2 };
+		log.SetFlushPolicy(sgrottel::SimpleLog::FlushPolicy::Never());
+		for (unsigned int threadCount : { 1u, 2u, 4u, 8u })
+		{
+			benchmark::Print(WriteFromThreads(log, "file", threadCount, messages));
+		}
+	}
+
+	for (unsigned int threadCount : { 1u, 2u, 4u, 8u })
+	{
+		sgrottel::SimpleLog log{ {}, {}, 0, sgrottel::SimpleLog::Options::Ring(ringSize) };
+		benchmark::Result const r = WriteFromThreads(log, "ring", threadCount, messages);
+		benchmark::Print(r);
+		ok = CheckRing(log, ringSize, threadCount, messages / threadCount, dir / "dump.log") && ok;
+		if (log.GetStats().TotalMessages() != r.iterations)
+		{
+			std::printf("FAILED: ring counted %llu of %llu messages\n", static_cast<unsigned long long>(log.GetStats().TotalMessages()),
+				static_cast<unsigned long long>(r.iterations));
+			ok = false;
+		}
+	}
+
+	// reading the ring while threads are writing
+	{
+		sgrottel::SimpleLog log{ {}, {}, 0, sgrottel::SimpleLog::Options::Ring(4 * 1024) };
+		std::atomic<bool> done{ false };
+		uint64_t reads = 0;
+		std::thread reader{ [&]()
+			{
+				while (!done.load())
+				{
+					uint64_t lines = 0;
+					ok = CheckLines(log.GetRingContent(), "ring read while writing", lines) && ok;
+					++reads;
+				}
+			} };
+		WriteFromThreads(log, "ring", 8, messages);
+		done.store(true);
+		reader.join();
+		std::printf("ring read %llu times while writing\n", static_cast<unsigned long long>(reads));
+	}
+
+	// without ring, the memory-only log keeps nothing
+	{
+		sgrottel::SimpleLog log{ {}, {}, 0 };
+		log.Critical("discarded");
+		if (!log.GetRingContent().empty() || log.DumpRing(dir / "none.log"))
+		{
+			std::printf("FAILED: memory-only log without ring\n");
+			ok = false;
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::remove_all(dir, ec);
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,193 @@
+// RotationBenchmark.cpp  SimpleLog  BenchmarkCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Writes from several threads into logs rotated by size, and measures the slowest message next to the average.
+// The rotated files must contain all messages exactly once, and binary log files must decode on their own.
+
+#include "Benchmark.h"
+
+#include "SimpleLog/SimpleLog.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr unsigned int threadCount = 4;
+	constexpr int retention = 200;
+
+	/// <summary>
+	/// Writes the messages from `threadCount` threads, and returns the measured result and the slowest single message
+	/// </summary>
+	benchmark::Result WriteFromThreads(sgrottel::SimpleLog& log, std::string const& mode, uint64_t messages, double& maxSeconds)
+	{
+		uint64_t const perThread = messages / threadCount;
+		std::vector<double> slowest(threadCount, 0.0);
+		std::vector<std::thread> threads;
+		auto const start = std::chrono::steady_clock::now();
+		for (unsigned int t = 0; t < threadCount; ++t)
+		{
+			threads.emplace_back([&log, &slowest, perThread, t]()
+				{
+					for (uint64_t i = 0; i < perThread; ++i)
+					{
+						auto const s = std::chrono::steady_clock::now();
+						log.Write(sgrottel::ISimpleLog::FlagLevelMessage, "thread %u message %llu of the rotation benchmark",
+							t, static_cast<unsigned long long>(i));
+						slowest[t] = std::max(slowest[t], std::chrono::duration<double>(std::chrono::steady_clock::now() - s).count());
+					}
+				});
+		}
+		for (std::thread& t : threads)
+		{
+			t.join();
+		}
+		auto const end = std::chrono::steady_clock::now();
+
+		benchmark::Result r;
+		r.name = mode;
+		r.iterations = perThread * threadCount;
+		r.seconds = std::chrono::duration<double>(end - start).count();
+		maxSeconds = *std::max_element(slowest.begin(), slowest.end());
+		return r;
+	}
+
+	/// <summary>
+	/// Collects all files of one log, from the oldest to the current file
+	/// </summary>
+	std::vector<std::filesystem::path> LogFiles(std::filesystem::path const& dir, std::string const& name, std::string const& ext)
+	{
+		std::vector<std::filesystem::path> files;
+		for (int i = retention - 1; i > 0; --i)
+		{
+			std::filesystem::path const p = dir / (name + "." + std::to_string(i) + ext);
+			if (std::filesystem::is_regular_file(p)) files.push_back(p);
+		}
+		if (std::filesystem::is_regular_file(dir / (name + ext))) files.push_back(dir / (name + ext));
+		return files;
+	}
+
+	/// <summary>
+	/// Checks that all lines are complete, and that each message is present exactly once
+	/// </summary>
+	bool CheckLines(std::string const& name, std::istream& in, std::vector<std::vector<bool>>& seen, uint64_t& lines)
+	{
+		std::string line;
+		while (std::getline(in, line))
+		{
+			unsigned int t = 0;
+			unsigned long long i = 0;
+			size_t const pos = line.find("| thread ");
+			if (pos == std::string::npos
+				|| std::sscanf(line.c_str() + pos, "| thread %u message %llu of the rotation benchmark", &t, &i) != 2
+				|| t >= seen.size() || i >= seen[t].size() || seen[t][i])
+			{
+				std::printf("FAILED: %s: unexpected line \"%s\"\n", name.c_str(), line.c_str());
+				return false;
+			}
+			seen[t][i] = true;
+			++lines;
+		}
+		return true;
+	}
+
+	bool RunCase(std::filesystem::path const& dir, bool binary, uint64_t messages, uint64_t maxBytes)
+	{
+		std::string const name = binary ? "binary" : "text";
+		std::string const ext = binary ? ".slb" : ".log";
+		double maxSeconds = 0.0;
+		{
+			sgrottel::SimpleLog log{ dir, name, retention, binary ? sgrottel::SimpleLog::Options::Binary() : sgrottel::SimpleLog::Options::File() };
+			log.SetFlushPolicy(sgrottel::SimpleLog::FlushPolicy::Never());
+			if (maxBytes > 0)
+			{
+				log.SetRotationPolicy(sgrottel::SimpleLog::RotationPolicy::MaxBytes(maxBytes));
+			}
+			benchmark::Result const r = WriteFromThreads(log, name + (maxBytes > 0 ? ", rotated" : ""), messages, maxSeconds);
+			benchmark::Print(r);
+			messages = r.iterations;
+		}
+
+		std::vector<std::filesystem::path> const files = LogFiles(dir, name, ext);
+		std::printf("%-48s %12.2f us max %10zu files\n", "", maxSeconds * 1e6, files.size());
+		if (std::filesystem::exists(dir / (name + ".next" + ext)))
+		{
+			std::printf("FAILED: %s: successor file left behind\n", name.c_str());
+			return false;
+		}
+		if (maxBytes > 0 && files.size() < 2)
+		{
+			std::printf("FAILED: %s: log was not rotated\n", name.c_str());
+			return false;
+		}
+
+		std::vector<std::vector<bool>> seen(threadCount, std::vector<bool>(messages / threadCount, false));
+		uint64_t lines = 0;
+		for (std::filesystem::path const& file : files)
+		{
+			std::ifstream in{ file, std::ios::binary };
+			if (binary)
+			{
+				std::stringstream decoded;
+				sgrottel::BinaryLogDecoder::Decode(in, decoded);
+				if (!CheckLines(file.string(), decoded, seen, lines)) return false;
+			}
+			else if (!CheckLines(file.string(), in, seen, lines))
+			{
+				return false;
+			}
+		}
+		if (lines != messages)
+		{
+			std::printf("FAILED: %s: %llu of %llu messages\n", name.c_str(), static_cast<unsigned long long>(lines), static_cast<unsigned long long>(messages));
+			return false;
+		}
+
+		for (std::filesystem::path const& file : files)
+		{
+			std::filesystem::remove(file);
+		}
+		return true;
+	}
+}
+
+int main(int argc, char const* argv[])
+{
+	uint64_t const messages = benchmark::ParseIterations(argc, argv, 400000);
+
+	std::filesystem::path const dir = std::filesystem::temp_directory_path() / ("simplelog_rotation_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+	std::filesystem::create_directories(dir);
+	bool ok = true;
+
+	// about 60 bytes per message, rotated into 20 to 40 files
+	uint64_t const maxBytes = std::max<uint64_t>(messages * 60 / 30, 4096);
+	for (bool binary : { false, true })
+	{
+		ok = RunCase(dir, binary, messages, 0) && ok;
+		ok = RunCase(dir, binary, messages, maxBytes) && ok;
+	}
+
+	std::error_code ec;
+	std::filesystem::remove_all(dir, ec);
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+// StartupBenchmark.cpp  SimpleLog  BenchmarkCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Measures the cost of creating logs, as it adds to the startup time of short-lived processes.
+// Logs opened lazily must not touch the file system until their first message.
+
+#include "Benchmark.h"
+
+#include "SimpleLog/SimpleLog.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+int main(int argc, char const* argv[])
+{
+	uint64_t const iterations = benchmark::ParseIterations(argc, argv, 10000);
+
+	std::filesystem::path const dir = std::filesystem::temp_directory_path() / ("simplelog_startup_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+	std::filesystem::create_directories(dir);
+	bool ok = true;
+
+	{
+		auto const start = std::chrono::steady_clock::now();
+		std::filesystem::path const first = sgrottel::SimpleLog::GetDefaultDirectory();
+		auto const end = std::chrono::steady_clock::now();
+		benchmark::Result r;
+		r.name = "GetDefaultDirectory, first call";
+		r.iterations = 1;
+		r.seconds = std::chrono::duration<double>(end - start).count();
+		benchmark::Print(r);
+
+		benchmark::Print(benchmark::Run("GetDefaultDirectory", iterations, [&first, &ok](uint64_t)
+			{
+				std::filesystem::path const p = sgrottel::SimpleLog::GetDefaultDirectory();
+				if (p != first) ok = false;
+				benchmark::DoNotOptimize(p);
+			}));
+		benchmark::Print(benchmark::Run("GetDefaultName", iterations, [](uint64_t)
+			{
+				benchmark::DoNotOptimize(sgrottel::SimpleLog::GetDefaultName());
+			}));
+	}
+
+	// creating a log renames all previous log files, so the retention is kept minimal
+	uint64_t const logs = iterations / 10 + 1;
+	benchmark::Print(benchmark::Run("construct", logs, [&dir](uint64_t)
+		{
+			sgrottel::SimpleLog log{ dir, "eager", 2 };
+		}));
+	benchmark::Print(benchmark::Run("construct, one message", logs, [&dir](uint64_t i)
+		{
+			sgrottel::SimpleLog log{ dir, "eager", 2 };
+			log.Write(sgrottel::ISimpleLog::FlagLevelMessage, "startup message %llu", static_cast<unsigned long long>(i));
+		}));
+	benchmark::Print(benchmark::Run("construct lazy", logs, [&dir](uint64_t)
+		{
+			sgrottel::SimpleLog log{ dir / "lazy", "lazy", 2, sgrottel::SimpleLog::Options::Lazy() };
+		}));
+	if (std::filesystem::exists(dir / "lazy"))
+	{
+		std::printf("FAILED: lazy log without messages created its directory\n");
+		ok = false;
+	}
+	benchmark::Print(benchmark::Run("construct lazy, one message", logs, [&dir](uint64_t i)
+		{
+			sgrottel::SimpleLog log{ dir / "lazy", "lazy", 2, sgrottel::SimpleLog::Options::Lazy() };
+			log.Write(sgrottel::ISimpleLog::FlagLevelMessage, "startup message %llu", static_cast<unsigned long long>(i));
+		}));
+
+	{
+		std::ifstream file{ dir / "lazy" / "lazy.log" };
+		std::string line;
+		if (!std::getline(file, line) || line.find("| startup message ") == std::string::npos)
+		{
+			std::printf("FAILED: lazy log did not write its message\n");
+			ok = false;
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::remove_all(dir, ec);
+
+	return ok ? 0 : 1;
+}
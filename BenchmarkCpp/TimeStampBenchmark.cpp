@@ -0,0 +1,90 @@
+// TimeStampBenchmark.cpp  SimpleLog  BenchmarkCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Compares the cached TimeStampFormatter with formatting each time stamp via the calendar functions,
+// and messages of logs with local and with UTC time stamps written alternately on one thread.
+
+#include "Benchmark.h"
+
+#include "SimpleLog/SimpleLog.hpp"
+
+#include <ctime>
+#include <string>
+
+namespace
+{
+	using Formatter = sgrottel::TimeStampFormatter;
+
+	/// <summary>
+	/// Formats a time stamp without caching, calling the calendar functions each time
+	/// </summary>
+	std::string Reference(std::chrono::system_clock::time_point time, bool utc, Formatter::Precision precision)
+	{
+		int64_t const micros = std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+		time_t const second = static_cast<time_t>(micros / 1000000);
+		uint32_t const fraction = static_cast<uint32_t>(micros % 1000000);
+		struct tm t {};
+#if defined(_WIN32)
+		if (utc) gmtime_s(&t, &second); else localtime_s(&t, &second);
+#else
+		if (utc) gmtime_r(&second, &t); else localtime_r(&second, &t);
+#endif
+		char buf[64];
+		size_t len = std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &t);
+		if (precision == Formatter::Precision::Milliseconds)
+		{
+			len += static_cast<size_t>(std::snprintf(buf + len, sizeof(buf) - len, ".%03u", fraction / 1000));
+		}
+		else if (precision == Formatter::Precision::Microseconds)
+		{
+			len += static_cast<size_t>(std::snprintf(buf + len, sizeof(buf) - len, ".%06u", fraction));
+		}
+		return std::string{ buf, len } + "Z";
+	}
+}
+
+int main(int argc, char const* argv[])
+{
+	uint64_t const iterations = benchmark::ParseIterations(argc, argv, 2000000);
+
+	Formatter formatter{ true, Formatter::Precision::Milliseconds };
+	benchmark::Print(benchmark::Run("cached time stamp, now", iterations, [&](uint64_t)
+		{
+			char buf[Formatter::MaxLength];
+			benchmark::DoNotOptimize(formatter.Format(buf));
+		}));
+	benchmark::Print(benchmark::Run("reference time stamp, now", iterations / 10, [&](uint64_t)
+		{
+			benchmark::DoNotOptimize(Reference(std::chrono::system_clock::now(), true, Formatter::Precision::Milliseconds));
+		}));
+
+	// memory-only logs with rings, so only the lines are assembled
+	sgrottel::SimpleLog local{ {}, {}, 0, sgrottel::SimpleLog::Options::Ring(64 * 1024) };
+	sgrottel::SimpleLog utc{ {}, {}, 0, sgrottel::SimpleLog::Options::Ring(64 * 1024) };
+	utc.SetUseUtcTimeStamps(true);
+	utc.SetTimeStampPrecision(Formatter::Precision::Microseconds);
+	benchmark::Print(benchmark::Run("message, one log", iterations, [&](uint64_t)
+		{
+			local.Write("message");
+		}));
+	benchmark::Print(benchmark::Run("message, local and UTC log alternately", iterations, [&](uint64_t i)
+		{
+			((i & 1) ? utc : local).Write("message");
+		}));
+
+	return 0;
+}
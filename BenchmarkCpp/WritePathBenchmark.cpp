@@ -0,0 +1,211 @@
+// WritePathBenchmark.cpp  SimpleLog  BenchmarkCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// Measures the single-threaded cost of the write path, per message, for every `Write` overload and level function,
+// the null log, a log file, chains of echoing logs in front of a log file, and several log files written via a tee.
+// Run with `--json FILE` to also write the results in a machine-readable form, e.g. to compare builds.
+// Wide printf-based formatting must discard messages with encoding errors without growing its buffer.
+
+#include "Benchmark.h"
+
+#include "SimpleLog/SimpleLog.hpp"
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace
+{
+	/// <summary>
+	/// Runs one case and adds its result to the report, named `target: call`
+	/// </summary>
+	template<typename FUNC>
+	void Case(benchmark::Report& report, char const* target, char const* call, uint64_t iterations, FUNC&& func)
+	{
+		std::string const name = std::string{ target } + ": " + call;
+		report.Add(benchmark::Run(name.c_str(), iterations, std::forward<FUNC>(func)));
+	}
+
+	/// <summary>
+	/// Measures all `Write` overloads, with and without printf arguments
+	/// </summary>
+	void WriteOverloads(benchmark::Report& report, char const* target, sgrottel::ISimpleLog const& log, uint64_t iterations)
+	{
+		using sgrottel::ISimpleLog;
+		std::string_view const view{ "string_view message of the write path benchmark" };
+		std::wstring_view const wview{ L"wstring_view message of the write path benchmark" };
+		std::string const str{ "string message of the write path benchmark" };
+		std::wstring const wstr{ L"wstring message of the write path benchmark" };
+		std::string_view const viewFormat{ "string_view message %llu of the write path benchmark" };
+		std::string const strFormat{ "string message %llu of the write path benchmark" };
+
+		Case(report, target, "Write(flags, char const*)", iterations,
+			[&](uint64_t) { log.Write(ISimpleLog::FlagLevelMessage, "char message of the write path benchmark"); });
+		Case(report, target, "Write(flags, wchar_t const*)", iterations,
+			[&](uint64_t) { log.Write(ISimpleLog::FlagLevelMessage, L"wchar_t message of the write path benchmark"); });
+		Case(report, target, "Write(flags, string_view)", iterations,
+			[&](uint64_t) { log.Write(ISimpleLog::FlagLevelMessage, view); });
+		Case(report, target, "Write(flags, wstring_view)", iterations,
+			[&](uint64_t) { log.Write(ISimpleLog::FlagLevelMessage, wview); });
+		Case(report, target, "Write(flags, string)", iterations,
+			[&](uint64_t) { log.Write(ISimpleLog::FlagLevelMessage, str); });
+		Case(report, target, "Write(flags, wstring)", iterations,
+			[&](uint64_t) { log.Write(ISimpleLog::FlagLevelMessage, wstr); });
+		Case(report, target, "Write(char const*)", iterations,
+			[&](uint64_t) { log.Write("char message of the write path benchmark"); });
+		Case(report, target, "Write(flags, char const*, args)", iterations,
+			[&](uint64_t i) { log.Write(ISimpleLog::FlagLevelMessage, "char message %llu of the %s benchmark", static_cast<unsigned long long>(i), "write path"); });
+		Case(report, target, "Write(flags, wchar_t const*, args)", iterations,
+			[&](uint64_t i) { log.Write(ISimpleLog::FlagLevelMessage, L"wchar_t message %llu of the %ls benchmark", static_cast<unsigned long long>(i), L"write path"); });
+		Case(report, target, "Write(flags, string_view, args)", iterations,
+			[&](uint64_t i) { log.Write(ISimpleLog::FlagLevelMessage, viewFormat, static_cast<unsigned long long>(i)); });
+		Case(report, target, "Write(flags, string, args)", iterations,
+			[&](uint64_t i) { log.Write(ISimpleLog::FlagLevelMessage, strFormat, static_cast<unsigned long long>(i)); });
+		Case(report, target, "WriteFormat(flags, format, args)", iterations,
+			[&](uint64_t i) { log.WriteFormat(ISimpleLog::FlagLevelMessage, "format message {} of the {} benchmark", i, "write path"); });
+	}
+
+	/// <summary>
+	/// Measures the level functions
+	/// </summary>
+	void LevelFunctions(benchmark::Report& report, char const* target, sgrottel::ISimpleLog const& log, uint64_t iterations)
+	{
+		Case(report, target, "Critical(char const*, args)", iterations,
+			[&](uint64_t i) { log.Critical("critical message %llu of the write path benchmark", static_cast<unsigned long long>(i)); });
+		Case(report, target, "Error(char const*, args)", iterations,
+			[&](uint64_t i) { log.Error("error message %llu of the write path benchmark", static_cast<unsigned long long>(i)); });
+		Case(report, target, "Warning(char const*, args)", iterations,
+			[&](uint64_t i) { log.Warning("warning message %llu of the write path benchmark", static_cast<unsigned long long>(i)); });
+		Case(report, target, "Message(char const*, args)", iterations,
+			[&](uint64_t i) { log.Message("message %llu of the write path benchmark", static_cast<unsigned long long>(i)); });
+		Case(report, target, "Detail(char const*, args)", iterations,
+			[&](uint64_t i) { log.Detail("detail message %llu of the write path benchmark", static_cast<unsigned long long>(i)); });
+	}
+
+	/// <summary>
+	/// Measures one formatted message through `log`
+	/// </summary>
+	void FormattedMessage(benchmark::Report& report, char const* target, sgrottel::ISimpleLog const& log, uint64_t iterations)
+	{
+		Case(report, target, "Write(flags, char const*, args)", iterations,
+			[&](uint64_t i) { log.Write(sgrottel::ISimpleLog::FlagLevelMessage, "char message %llu of the %s benchmark", static_cast<unsigned long long>(i), "write path"); });
+	}
+}
+
+int main(int argc, char const* argv[])
+{
+	uint64_t const iterations = benchmark::ParseIterations(argc, argv, 200000);
+
+	benchmark::Report report{ "WritePathBenchmark", argc, argv };
+	report.SetInfo("simplelog_version", std::to_string(SIMPLELOG_VER_MAJOR) + "." + std::to_string(SIMPLELOG_VER_MINOR) + "."
+		+ std::to_string(SIMPLELOG_VER_PATCH) + "." + std::to_string(SIMPLELOG_VER_BUILD));
+#if defined(SIMPLELOG_WINDOWS)
+	report.SetInfo("platform", "windows");
+#else
+	report.SetInfo("platform", "posix");
+#endif
+
+	std::filesystem::path const dir = std::filesystem::temp_directory_path() / ("simplelog_writepath_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+	std::filesystem::create_directories(dir);
+
+	{
+		sgrottel::NullLog log;
+		WriteOverloads(report, "null", log, iterations);
+		LevelFunctions(report, "null", log, iterations);
+	}
+
+	{
+		sgrottel::SimpleLog log{ dir, "file", 2 };
+		log.SetFlushPolicy(sgrottel::SimpleLog::FlushPolicy::Never());
+		WriteOverloads(report, "file", log, iterations);
+		LevelFunctions(report, "file", log, iterations);
+	}
+
+	{
+		// the default flush policy writes every message to the storage device
+		sgrottel::SimpleLog log{ dir, "flushed", 2 };
+		FormattedMessage(report, "file, flushed", log, iterations / 100 + 1);
+	}
+
+	{
+		sgrottel::SimpleLog log{ dir, "chains", 2 };
+		log.SetFlushPolicy(sgrottel::SimpleLog::FlushPolicy::Never());
+		sgrottel::EchoingSimpleLog echo{ log };
+		sgrottel::DebugOutputEchoingSimpleLog debugOutput{ log };
+		sgrottel::DebugOutputEchoingSimpleLog debugOutputOfEcho{ echo };
+
+		// the echoed messages are discarded, and so are the results printed meanwhile, which are added after
+		benchmark::Report chains{ "chains", 0, nullptr };
+		{
+			benchmark::SuppressStdout const suppress;
+			FormattedMessage(chains, "echoing(file)", echo, iterations);
+			FormattedMessage(chains, "debug output(file)", debugOutput, iterations);
+			FormattedMessage(chains, "debug output(echoing(file))", debugOutputOfEcho, iterations);
+		}
+		for (benchmark::Result const& r : chains.GetResults())
+		{
+			report.Add(r);
+		}
+	}
+
+	{
+		// formatting and, on POSIX systems, converting wide messages once for all logs, compared with writing each log
+		sgrottel::SimpleLog first{ dir, "first", 2 };
+		sgrottel::SimpleLog second{ dir, "second", 2 };
+		sgrottel::SimpleLog third{ dir, "third", 2 };
+		for (sgrottel::SimpleLog* log : { &first, &second, &third })
+		{
+			log->SetFlushPolicy(sgrottel::SimpleLog::FlushPolicy::Never());
+		}
+		sgrottel::TeeSimpleLog tee{ first, second, third };
+
+		Case(report, "3 files, each", "Write(flags, wchar_t const*, args)", iterations,
+			[&](uint64_t i)
+			{
+				for (sgrottel::SimpleLog const* log : { &first, &second, &third })
+				{
+					log->Write(sgrottel::ISimpleLog::FlagLevelMessage, L"wchar_t message %llu of the %ls benchmark", static_cast<unsigned long long>(i), L"write path");
+				}
+			});
+		Case(report, "tee(3 files)", "Write(flags, wchar_t const*, args)", iterations,
+			[&](uint64_t i) { tee.Write(sgrottel::ISimpleLog::FlagLevelMessage, L"wchar_t message %llu of the %ls benchmark", static_cast<unsigned long long>(i), L"write path"); });
+		FormattedMessage(report, "tee(3 files)", tee, iterations);
+	}
+
+	std::error_code ec;
+	std::filesystem::remove_all(dir, ec);
+
+	// an encoding error in wide printf-based formatting discards the message, without growing the buffer
+	{
+		sgrottel::MessageBuffer<wchar_t> out;
+		size_t const capacity = out.Capacity();
+		sgrottel::MessageFormatter<wchar_t>::Printf(out, L"invalid %s argument", "\xff\xfe");
+		if (out.Capacity() != capacity)
+		{
+			std::printf("FAILED: wide formatting with an encoding error grew the buffer to %llu characters\n", static_cast<unsigned long long>(out.Capacity()));
+			return 1;
+		}
+	}
+
+	if (!report.WriteJson())
+	{
+		std::printf("FAILED: could not write json file\n");
+		return 1;
+	}
+	return 0;
+}
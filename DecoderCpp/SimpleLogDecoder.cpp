@@ -0,0 +1,72 @@
+// SimpleLogDecoder.cpp  SimpleLog  DecoderCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Converts a binary log file, written with `SimpleLog::FileFormat::Binary`, into a text log file.
+// Usage: SimpleLogDecoder <input.slb> [output.log]
+// Without output file, the text lines are written to stdout.
+
+#include "SimpleLog/SimpleLog.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main(int argc, char const* argv[])
+{
+	if (argc < 2 || argc > 3)
+	{
+		std::fprintf(stderr, "Usage: %s <input.slb> [output.log]\n", argv[0]);
+		return 2;
+	}
+
+	std::ifstream in{ argv[1], std::ios::binary };
+	if (!in)
+	{
+		std::fprintf(stderr, "Failed to open \"%s\"\n", argv[1]);
+		return 1;
+	}
+
+	std::ofstream file;
+	if (argc == 3)
+	{
+		file.open(argv[2], std::ios::binary | std::ios::trunc);
+		if (!file)
+		{
+			std::fprintf(stderr, "Failed to create \"%s\"\n", argv[2]);
+			return 1;
+		}
+	}
+	std::ostream& out = (argc == 3) ? file : std::cout;
+
+	try
+	{
+		std::string diagnostic;
+		sgrottel::BinaryLogDecoder::Decode(in, out, &diagnostic);
+		if (!diagnostic.empty())
+		{
+			std::fprintf(stderr, "Decoding of \"%s\" stopped: %s\n", argv[1], diagnostic.c_str());
+		}
+	}
+	catch (std::exception const& ex)
+	{
+		std::fprintf(stderr, "Failed to decode \"%s\": %s\n", argv[1], ex.what());
+		return 1;
+	}
+	out.flush();
+	return out ? 0 : 1;
+}
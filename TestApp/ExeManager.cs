@@ -230,5 +230,22 @@ namespace SimpleLogTest
 			return true;
 		}
 
+		/// <summary>
+		/// Runs the executable with the arguments, and returns its exit code
+		/// </summary>
+		internal static int Run(string exe, params string[] args)
+		{
+			ProcessStartInfo psi = new(exe)
+			{
+				FileName = exe,
+				WorkingDirectory = Path.GetDirectoryName(exe)
+			};
+			foreach (string arg in args) psi.ArgumentList.Add(arg);
+
+			Process p = Process.Start(psi) ?? throw new Exception();
+			Assert.IsTrue(p.WaitForExit((int)TimeSpan.FromMinutes(5).TotalMilliseconds));
+			return p.ExitCode;
+		}
+
 	}
 }
@@ -54,5 +54,59 @@ namespace SimpleLogTest
 		{
 			TestImpl.MultiProcessLogFilesToDelete(ExeManager.TestCpp32);
 		}
+
+		[TestMethod]
+		public void AsyncProducers()
+		{
+			TestImpl.CppCheck(ExeManager.TestCpp32, "async-producers");
+		}
+
+		[TestMethod]
+		public void AsyncCopyFailure()
+		{
+			TestImpl.CppCheck(ExeManager.TestCpp32, "async-copy-failure");
+		}
+
+		[TestMethod]
+		public void BinaryArgs()
+		{
+			TestImpl.CppCheck(ExeManager.TestCpp32, "binary-args");
+		}
+
+		[TestMethod]
+		public void BinaryDecoder()
+		{
+			TestImpl.CppCheck(ExeManager.TestCpp32, "binary-decoder");
+		}
+
+		[TestMethod]
+		public void BinaryFormats()
+		{
+			TestImpl.CppCheck(ExeManager.TestCpp32, "binary-formats");
+		}
+
+		[TestMethod]
+		public void FlushPolicy()
+		{
+			TestImpl.CppCheck(ExeManager.TestCpp32, "flush-policy");
+		}
+
+		[TestMethod]
+		public void RingConcurrent()
+		{
+			TestImpl.CppCheck(ExeManager.TestCpp32, "ring-concurrent");
+		}
+
+		[TestMethod]
+		public void RotationLeftovers()
+		{
+			TestImpl.CppCheck(ExeManager.TestCpp32, "rotation-leftovers");
+		}
+
+		[TestMethod]
+		public void TimeStamp()
+		{
+			TestImpl.CppCheck(ExeManager.TestCpp32, "timestamp");
+		}
 	}
 }
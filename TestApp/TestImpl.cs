@@ -189,6 +189,16 @@ namespace SimpleLogTest
 			AssertLogFileContent(Path.Combine(LogDirManager.Dir, "TestSimpleLog.2.log"), null, "Run 0 Prep");
 		}
 
+		/// <summary>
+		/// Runs a behavior check of the Cpp implementation, see TestCpp/Checks.cpp
+		/// </summary>
+		internal static void CppCheck(string exe, string name)
+		{
+			Assert.IsFalse(string.IsNullOrEmpty(exe));
+			Assert.IsTrue(File.Exists(exe));
+			Assert.AreEqual(0, ExeManager.Run(exe, "-check", name));
+		}
+
 		private static void WaitForTestWaiting()
 		{
 			using (Semaphore waitSemaphore = new(0, 1, "SGROTTEL_SIMPLELOG_TEST_READY"))
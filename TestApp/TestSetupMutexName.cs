@@ -0,0 +1,39 @@
+// TestSetupMutexName.cs  SimpleLog  TestApp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+namespace SimpleLogTest
+{
+	/// <summary>
+	/// The names of the setup mutex must match the names derived by the Cpp implementation, see BenchmarkCpp/MultiProcessStartup.cpp
+	/// </summary>
+	[TestClass]
+	public class TestSetupMutexName
+	{
+		[TestMethod]
+		public void NonAsciiPath()
+		{
+			Assert.AreEqual("SGROTTEL_SIMPLELOG_4602b0092dfd3ec1", SGrottel.SimpleLog.GetSetupMutexName("C:\\Logs\\\u00dcber\\MyApp"));
+			Assert.AreEqual("SGROTTEL_SIMPLELOG_4f4e1c34c34ca1a1", SGrottel.SimpleLog.GetSetupMutexName("C:\\Logs\\\u00fcber\\MyApp"));
+			Assert.AreEqual("SGROTTEL_SIMPLELOG_71bb60f1ab95bc99", SGrottel.SimpleLog.GetSetupMutexName("C:\\Logs\\\U0001F600\\MyApp"));
+		}
+
+		[TestMethod]
+		public void AsciiCaseInsensitive()
+		{
+			Assert.AreEqual(SGrottel.SimpleLog.GetSetupMutexName("C:\\Logs\\\u00dcber\\MyApp"), SGrottel.SimpleLog.GetSetupMutexName("C:\\LOGS\\\u00dcber\\MYAPP"));
+		}
+	}
+}
@@ -0,0 +1,24 @@
+// CheckMain.cpp  SimpleLog  TestCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Entry point of the behavior checks on platforms without the Windows test application, see CMakeLists.txt
+
+#include "Checks.h"
+
+int main(int argc, char const* argv[])
+{
+	return RunChecks((argc > 1) ? argv[1] : "");
+}
@@ -0,0 +1,769 @@
+// Checks.cpp  SimpleLog  TestCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Checks.h"
+
+#include "SimpleLog/SimpleLog.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(SIMPLELOG_POSIX)
+#include <cstdlib>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	bool Expect(bool condition, char const* what)
+	{
+		if (!condition) std::cout << "FAILED: " << what << std::endl;
+		return condition;
+	}
+
+	/// <summary>
+	/// A new, empty directory in the temp directory, which is deleted with the object
+	/// </summary>
+	class TempDir
+	{
+	public:
+		explicit TempDir(char const* name)
+			: m_path{ std::filesystem::temp_directory_path()
+				/ (std::string{ "simplelog_" } + name + "_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count())) }
+		{
+			std::filesystem::create_directories(m_path);
+		}
+
+		~TempDir()
+		{
+			std::error_code ec;
+			std::filesystem::remove_all(m_path, ec);
+		}
+
+		TempDir(const TempDir&) = delete;
+		TempDir(TempDir&&) = delete;
+		TempDir& operator=(const TempDir&) = delete;
+		TempDir& operator=(TempDir&&) = delete;
+
+		std::filesystem::path const& Path() const { return m_path; }
+
+	private:
+		std::filesystem::path m_path;
+	};
+
+	std::vector<std::string> ReadLines(std::filesystem::path const& path)
+	{
+		std::ifstream file{ path, std::ios::binary };
+		std::vector<std::string> lines;
+		std::string line;
+		while (std::getline(file, line)) lines.push_back(line);
+		return lines;
+	}
+
+	std::string ReadFile(std::filesystem::path const& path)
+	{
+		std::ifstream file{ path, std::ios::binary };
+		return std::string{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+	}
+
+	/// <summary>
+	/// Checks the order of the messages of each producer, as they arrive from the writer thread of an AsyncSimpleLog
+	/// </summary>
+	class OrderCheckingLog : public sgrottel::ISimpleLog
+	{
+	public:
+		explicit OrderCheckingLog(unsigned int threadCount) : m_next(threadCount, 0) {}
+
+		uint64_t GetReceived() const
+		{
+			std::lock_guard<std::mutex> lock{ m_lock };
+			return m_received;
+		}
+
+		uint64_t GetOutOfOrder() const
+		{
+			std::lock_guard<std::mutex> lock{ m_lock };
+			return m_outOfOrder;
+		}
+
+	protected:
+		void WriteImpl(uint32_t, char const* message, size_t messageLength) const override
+		{
+			std::string const text{ message, messageLength };
+			unsigned int thread = 0;
+			unsigned long long index = 0;
+			std::lock_guard<std::mutex> lock{ m_lock };
+			++m_received;
+			if (std::sscanf(text.c_str(), "thread %u message %llu", &thread, &index) != 2 || thread >= m_next.size() || m_next[thread] != index)
+			{
+				++m_outOfOrder;
+				return;
+			}
+			++m_next[thread];
+		}
+
+		void WriteImpl(uint32_t, wchar_t const*, size_t) const override
+		{
+			std::lock_guard<std::mutex> lock{ m_lock };
+			++m_received;
+			++m_outOfOrder;
+		}
+
+	private:
+		mutable std::mutex m_lock;
+		mutable std::vector<uint64_t> m_next;
+		mutable uint64_t m_received{ 0 };
+		mutable uint64_t m_outOfOrder{ 0 };
+	};
+
+	/// <summary>
+	/// All messages of several producers arrive at the base log, in the order of each producer
+	/// </summary>
+	bool CheckAsyncProducers()
+	{
+		constexpr uint64_t perThread = 5000;
+		bool ok = true;
+		for (unsigned int threadCount : { 1u, 2u, 4u, 8u })
+		{
+			OrderCheckingLog base{ threadCount };
+			sgrottel::AsyncSimpleLog log{ base, 64 };
+			std::vector<std::thread> threads;
+			for (unsigned int t = 0; t < threadCount; ++t)
+			{
+				threads.emplace_back([&log, t]()
+					{
+						for (uint64_t i = 0; i < perThread; ++i)
+						{
+							log.Write(sgrottel::ISimpleLog::FlagLevelMessage, "thread %u message %llu", t, static_cast<unsigned long long>(i));
+						}
+					});
+			}
+			for (std::thread& t : threads) t.join();
+			log.Drain();
+			ok = Expect(base.GetReceived() == perThread * threadCount, "all messages of the producers received") && ok;
+			ok = Expect(base.GetOutOfOrder() == 0, "messages of each producer received in order") && ok;
+			ok = Expect(log.GetDroppedCount() == 0, "no message dropped") && ok;
+		}
+		return ok;
+	}
+
+	/// <summary>
+	/// A message which cannot be copied into the queue, after its slot was claimed, is dropped without stalling the writer thread
+	/// </summary>
+	bool CheckAsyncCopyFailure()
+	{
+		OrderCheckingLog base{ 1 };
+		sgrottel::AsyncSimpleLog log{ base, 64 };
+		log.Write(sgrottel::ISimpleLog::FlagLevelMessage, "thread %u message %llu", 0u, 0ull);
+		bool thrown = false;
+		try
+		{
+			// too long for std::string, so the copy throws without reading the message
+			log.Write(sgrottel::ISimpleLog::FlagLevelMessage, std::string_view{ "x", std::string{}.max_size() + 1 });
+		}
+		catch (std::exception const&)
+		{
+			thrown = true;
+		}
+		log.Write(sgrottel::ISimpleLog::FlagLevelMessage, "thread %u message %llu", 0u, 1ull);
+		log.Drain();
+		bool ok = Expect(thrown, "failed copy passed to the caller");
+		ok = Expect(base.GetReceived() == 2 && base.GetOutOfOrder() == 0, "messages around the failed copy received") && ok;
+		ok = Expect(log.GetDroppedCount() == 1, "failed copy counted as dropped") && ok;
+		return ok;
+	}
+
+	/// <summary>
+	/// Decodes a binary log file, and returns the messages without time stamps
+	/// </summary>
+	std::vector<std::string> DecodeMessages(std::filesystem::path const& path)
+	{
+		std::ifstream in{ path, std::ios::binary };
+		std::stringstream decoded;
+		sgrottel::BinaryLogDecoder::Decode(in, decoded);
+		std::vector<std::string> messages;
+		std::string line;
+		while (std::getline(decoded, line))
+		{
+			size_t const pos = line.find('|');
+			messages.push_back((pos == std::string::npos) ? line : line.substr(pos + 2));
+		}
+		return messages;
+	}
+
+	/// <summary>
+	/// Character pointers in binary logs are only recorded as strings for `%s`, and messages with `%n` are formatted as text
+	/// </summary>
+	bool CheckBinaryArgs()
+	{
+		TempDir dir{ "binary" };
+		sgrottel::SimpleLog::Options options = sgrottel::SimpleLog::Options::File();
+		options.fileFormat = sgrottel::SimpleLog::FileFormat::Binary;
+		std::filesystem::path path;
+		char const secret[] = "not a string argument";
+		int written = -1;
+		{
+			sgrottel::SimpleLog log{ dir.Path(), "binary", 2, options };
+			path = log.GetFilePath();
+			log.Write("name %s", "alpha");
+			log.Write("address %p", secret);
+			log.Write("%.*s|%5s|%ls", 3, "abcdef", "xy", L"wide");
+			log.Write("count %d %s", 7, static_cast<char const*>(nullptr));
+#if defined(SIMPLELOG_POSIX)
+			// printf of the Microsoft C runtime rejects `%n`
+			log.Write("abc%n", &written);
+#endif
+		}
+
+		std::vector<std::string> const messages = DecodeMessages(path);
+		bool ok = Expect(messages.size() >= 4, "all messages decoded");
+		if (!ok) return false;
+		ok = Expect(messages[0] == "name alpha", "string argument decoded") && ok;
+		ok = Expect(messages[1].rfind("address 0x", 0) == 0 && messages[1].find("string") == std::string::npos,
+			"character pointer of `%p` recorded as address") && ok;
+		ok = Expect(messages[2] == "abc|   xy|wide", "precision and width arguments decoded") && ok;
+		ok = Expect(messages[3] == "count 7 (null)", "null string decoded") && ok;
+#if defined(SIMPLELOG_POSIX)
+		ok = Expect(messages.size() == 5 && messages[4] == "abc", "message with `%n` decoded") && ok;
+		ok = Expect(written == 3, "message with `%n` formatted when written") && ok;
+#else
+		(void)written;
+#endif
+		return ok;
+	}
+
+	/// <summary>
+	/// Decoding stops with a diagnostic at a truncated record, or at a record length exceeding the input, without allocating that length
+	/// </summary>
+	bool CheckBinaryDecoder()
+	{
+		TempDir dir{ "decoder" };
+		sgrottel::SimpleLog::Options options = sgrottel::SimpleLog::Options::File();
+		options.fileFormat = sgrottel::SimpleLog::FileFormat::Binary;
+		std::filesystem::path path;
+		{
+			sgrottel::SimpleLog log{ dir.Path(), "binary", 2, options };
+			path = log.GetFilePath();
+			for (int i = 0; i < 10; ++i) log.Write("message %d", i);
+		}
+		std::string const content = ReadFile(path);
+
+		auto decode = [](std::string const& input, std::string& diagnostic)
+			{
+				std::istringstream in{ input };
+				std::ostringstream out;
+				return sgrottel::BinaryLogDecoder::Decode(in, out, &diagnostic);
+			};
+		std::string diagnostic = "not cleared";
+		bool ok = Expect(decode(content, diagnostic) == 10 && diagnostic.empty(), "complete file decoded without diagnostic");
+		ok = Expect(decode(content.substr(0, content.size() - 3), diagnostic) == 9 && !diagnostic.empty(),
+			"truncated record reported") && ok;
+
+		// a text record claiming almost 4 GiB
+		std::string corrupt = content;
+		corrupt.push_back(3);
+		uint32_t const len = 0xfffffff0u;
+		corrupt.append(reinterpret_cast<char const*>(&len), sizeof(len));
+		corrupt.append(16, 'x');
+		ok = Expect(decode(corrupt, diagnostic) == 10 && diagnostic.find("4294967285 bytes expected") != std::string::npos,
+			"corrupt record length reported") && ok;
+		return ok;
+	}
+
+	/// <summary>
+	/// Messages with more format strings than the binary log records are written as text records
+	/// </summary>
+	bool CheckBinaryFormats()
+	{
+		TempDir dir{ "formats" };
+		sgrottel::SimpleLog::Options options = sgrottel::SimpleLog::Options::File();
+		options.fileFormat = sgrottel::SimpleLog::FileFormat::Binary;
+		uint32_t const count = sgrottel::BinaryLogFormat::MaxFormats + 100;
+		std::vector<std::string> formats;
+		std::vector<std::string> expected;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			formats.push_back("format " + std::to_string(i) + ": %d");
+			expected.push_back("format " + std::to_string(i) + ": " + std::to_string(i * 2));
+		}
+		std::filesystem::path path;
+		{
+			sgrottel::SimpleLog log{ dir.Path(), "binary", 2, options };
+			path = log.GetFilePath();
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				log.Write(formats[i].c_str(), static_cast<int>(i * 2));
+			}
+			// known format strings are still recorded unformatted
+			log.Write(formats[0].c_str(), -1);
+			expected.push_back("format 0: -1");
+		}
+
+		// counts the format, message, and text records
+		std::string const content = ReadFile(path);
+		std::map<int, uint32_t> records;
+		for (size_t pos = sizeof(sgrottel::BinaryLogFormat::Magic); pos + sgrottel::BinaryLogFormat::RecordHeaderSize <= content.size();)
+		{
+			uint32_t len = 0;
+			std::memcpy(&len, content.data() + pos + 1, sizeof(len));
+			++records[content[pos]];
+			pos += sgrottel::BinaryLogFormat::RecordHeaderSize + len;
+		}
+		bool ok = Expect(DecodeMessages(path) == expected, "all messages decoded");
+		ok = Expect(records[1] == sgrottel::BinaryLogFormat::MaxFormats, "format records bounded") && ok;
+		ok = Expect(records[2] == sgrottel::BinaryLogFormat::MaxFormats + 1, "messages of known format strings recorded unformatted") && ok;
+		ok = Expect(records[3] == 100, "messages of further format strings recorded as text") && ok;
+		return ok;
+	}
+
+	/// <summary>
+	/// The flush calls counted in the log statistics match the flush policy, and the log file holds all messages
+	/// </summary>
+	bool CheckFlushPolicy()
+	{
+		constexpr uint64_t messages = 2000;
+		constexpr uint64_t errorInterval = 10;
+		constexpr size_t everyBytes = 4096;
+		TempDir dir{ "flush" };
+		bool ok = true;
+
+		sgrottel::SimpleLog::FlushPolicy const policies[] = {
+			sgrottel::SimpleLog::FlushPolicy::EveryMessage(),
+			sgrottel::SimpleLog::FlushPolicy::OnLevel(sgrottel::ISimpleLog::FlagLevelError),
+			sgrottel::SimpleLog::FlushPolicy::EveryBytes(everyBytes),
+			sgrottel::SimpleLog::FlushPolicy::Never(),
+		};
+		for (sgrottel::SimpleLog::FlushPolicy const& policy : policies)
+		{
+			sgrottel::LogStats before;
+			sgrottel::LogStats after;
+			std::filesystem::path path;
+			{
+				sgrottel::SimpleLog log{ dir.Path(), "flush", 2 };
+				log.SetFlushPolicy(policy);
+				path = log.GetFilePath();
+				before = log.GetStats();
+				for (uint64_t i = 0; i < messages; ++i)
+				{
+					// every tenth message is an error
+					uint32_t const flags = (i % errorInterval == 0) ? sgrottel::ISimpleLog::FlagLevelError : sgrottel::ISimpleLog::FlagLevelMessage;
+					log.Write(flags, "message %llu of the flush policy check", static_cast<unsigned long long>(i));
+				}
+				after = log.GetStats();
+			}
+
+			uint64_t const flushes = after.flushCalls - before.flushCalls;
+			uint64_t const bytes = after.bytesWritten - before.bytesWritten;
+			if (policy.everyMessage)
+			{
+				ok = Expect(flushes == messages, "flush after every message") && ok;
+			}
+			else if (policy.onLevel)
+			{
+				ok = Expect(flushes == messages / errorInterval, "flush after every error") && ok;
+			}
+			else if (policy.everyBytes > 0)
+			{
+				// each flush follows the message which reached the byte count
+				ok = Expect(flushes >= bytes / (everyBytes + 128) && flushes <= bytes / everyBytes, "flush after every 4 KiB") && ok;
+			}
+			else
+			{
+				ok = Expect(flushes == 0, "no flush") && ok;
+			}
+			ok = Expect(ReadLines(path).size() == messages, "all messages in the log file") && ok;
+		}
+		return ok;
+	}
+
+	void WriteFile(std::filesystem::path const& path, std::string const& content, std::filesystem::file_time_type time)
+	{
+		{
+			std::ofstream file{ path, std::ios::binary };
+			file << content;
+		}
+		std::filesystem::last_write_time(path, time);
+	}
+
+	/// <summary>
+	/// Successor files left over by terminated processes are moved into the retention chain when a log is created.
+	/// Successor files of running processes are kept, and empty ones are deleted. Rotation leaves no successor files behind.
+	/// </summary>
+	bool CheckRotationLeftovers()
+	{
+		TempDir dir{ "leftovers" };
+		std::filesystem::path const& d = dir.Path();
+#if defined(SIMPLELOG_WINDOWS)
+		std::string const ownPid = std::to_string(GetCurrentProcessId());
+#else
+		std::string const ownPid = std::to_string(::getpid());
+#endif
+		// no process runs with this id
+		std::string const deadPid = "2147483000";
+		auto const now = std::filesystem::file_time_type::clock::now();
+		WriteFile(d / "rot.log", "old\n", now - std::chrono::hours{ 3 });
+		WriteFile(d / "rot.next.log", "legacy\n", now - std::chrono::hours{ 2 });
+		WriteFile(d / ("rot.next." + deadPid + "-7.log"), "crashed\n", now - std::chrono::hours{ 1 });
+		WriteFile(d / ("rot.next." + deadPid + "-8.log"), "", now);
+		WriteFile(d / ("rot.next." + ownPid + "-999.log"), "running\n", now);
+
+		{
+			sgrottel::SimpleLog log{ d, "rot", 10 };
+			log.SetRotationPolicy(sgrottel::SimpleLog::RotationPolicy::MaxBytes(4096));
+			for (int i = 0; i < 200; ++i)
+			{
+				log.Write(sgrottel::ISimpleLog::FlagLevelMessage, "message %d of the rotation check", i);
+				// gives the maintenance thread time to open the successor file
+				if (i % 50 == 0) std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			}
+		}
+
+		std::vector<std::string> chain;
+		int nextFiles = 0;
+		for (std::filesystem::directory_entry const& entry : std::filesystem::directory_iterator{ d })
+		{
+			if (entry.path().filename().string().find(".next") != std::string::npos) ++nextFiles;
+		}
+		for (int i = 1; i < 10; ++i)
+		{
+			std::filesystem::path const path = d / ("rot." + std::to_string(i) + ".log");
+			if (std::filesystem::exists(path)) chain.push_back(ReadFile(path));
+		}
+		bool ok = Expect(nextFiles == 1 && std::filesystem::exists(d / ("rot.next." + ownPid + "-999.log")), "only the successor file of the running process kept");
+		ok = Expect(chain.size() >= 3 && chain[chain.size() - 3] == "crashed\n" && chain[chain.size() - 2] == "legacy\n" && chain.back() == "old\n",
+			"left-over successor files moved into the retention chain in the order of their time") && ok;
+		ok = Expect(chain.size() >= 4, "log rotated") && ok;
+		return ok;
+	}
+
+	/// <summary>
+	/// Checks that all lines in the content of a ring are complete, and that the numbers of each thread increase
+	/// </summary>
+	bool CheckRingContent(std::string const& content, unsigned int threadCount)
+	{
+		std::vector<long long> last(threadCount, -1);
+		size_t begin = 0;
+		while (begin < content.size())
+		{
+			size_t const end = content.find('\n', begin);
+			if (end == std::string::npos) return Expect(false, "ring content ends with a complete line");
+			std::string const line = content.substr(begin, end - begin);
+			unsigned int thread = 0;
+			long long index = 0;
+			char tail[16] = {};
+			if (std::sscanf(line.c_str(), "thread %u line %lld %15s", &thread, &index, tail) != 3 || thread >= threadCount
+				|| std::string{ tail } != "end" || index <= last[thread])
+			{
+				return Expect(false, ("complete lines in order in the ring, not \"" + line + "\"").c_str());
+			}
+			last[thread] = index;
+			begin = end + 1;
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// Lines written by several threads into a small ring, read while writing, are complete and in order
+	/// </summary>
+	bool CheckRingConcurrent()
+	{
+		constexpr unsigned int threadCount = 8;
+		constexpr int perThread = 20000;
+		sgrottel::LogRing ring{ 4096 };
+		std::atomic<int> running{ static_cast<int>(threadCount) };
+		std::vector<std::thread> threads;
+		for (unsigned int t = 0; t < threadCount; ++t)
+		{
+			threads.emplace_back([&ring, &running, t]()
+				{
+					char line[64];
+					for (int i = 0; i < perThread; ++i)
+					{
+						int const len = std::snprintf(line, sizeof(line), "thread %u line %d end\n", t, i);
+						ring.Append(line, static_cast<size_t>(len));
+					}
+					running.fetch_sub(1);
+				});
+		}
+		bool ok = true;
+		while (running.load() > 0 && ok)
+		{
+			ok = CheckRingContent(ring.GetContent(), threadCount);
+		}
+		for (std::thread& t : threads) t.join();
+
+		std::string const content = ring.GetContent();
+		std::string dumped;
+		ring.Dump([&dumped](char const* data, size_t len) { dumped.append(data, len); });
+		ok = CheckRingContent(content, threadCount) && ok;
+		ok = Expect(!content.empty() && content.size() <= ring.GetSize(), "ring content fits into the ring") && ok;
+		ok = Expect(dumped == content, "dumped ring matches the content") && ok;
+		return ok;
+	}
+
+#if defined(SIMPLELOG_POSIX)
+	std::atomic<bool> g_writerStalled{ false };
+	std::atomic<bool> g_releaseWriter{ false };
+
+	/// <summary>
+	/// Stops the interrupted thread, wherever it is, until it is released
+	/// </summary>
+	void StallWriter(int)
+	{
+		g_writerStalled.store(true);
+		struct timespec const pause { 0, 1000000 };
+		while (!g_releaseWriter.load()) ::nanosleep(&pause, nullptr);
+	}
+
+	/// <summary>
+	/// A writer stopped at any point while appending, e.g. by a crash, does not stop other writers, and its line is skipped by readers
+	/// </summary>
+	bool CheckRingStalledWriter()
+	{
+		sgrottel::LogRing ring{ 4096 };
+		std::atomic<bool> stop{ false };
+		struct sigaction action {};
+		action.sa_handler = &StallWriter;
+		sigemptyset(&action.sa_mask);
+		struct sigaction previous {};
+		::sigaction(SIGUSR1, &action, &previous);
+
+		bool ok = true;
+		for (int round = 0; round < 50 && ok; ++round)
+		{
+			g_writerStalled.store(false);
+			g_releaseWriter.store(false);
+			std::thread writer{ [&ring, &stop]()
+				{
+					char const line[] = "thread 1 line 0 end\n";
+					while (!stop.load(std::memory_order_relaxed)) ring.Append(line, sizeof(line) - 1);
+				} };
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			::pthread_kill(writer.native_handle(), SIGUSR1);
+			while (!g_writerStalled.load()) std::this_thread::yield();
+
+			// wraps around the ring several times, while the other writer is stopped
+			char line[64];
+			for (int i = 0; i < 1000; ++i)
+			{
+				int const len = std::snprintf(line, sizeof(line), "thread 0 line %d end\n", i);
+				ring.Append(line, static_cast<size_t>(len));
+			}
+			std::string const content = ring.GetContent();
+			ok = CheckRingContent(content, 1) && Expect(content.size() > ring.GetSize() / 2, "lines written while a writer is stopped") && ok;
+
+			stop.store(true);
+			g_releaseWriter.store(true);
+			writer.join();
+			stop.store(false);
+		}
+		::sigaction(SIGUSR1, &previous, nullptr);
+		return ok;
+	}
+#endif
+
+	/// <summary>
+	/// Formats a time stamp without caching, calling the calendar functions each time
+	/// </summary>
+	std::string ReferenceTimeStamp(std::chrono::system_clock::time_point time, bool utc, sgrottel::TimeStampFormatter::Precision precision)
+	{
+		int64_t const micros = std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+		time_t const second = static_cast<time_t>(micros / 1000000);
+		uint32_t const fraction = static_cast<uint32_t>(micros % 1000000);
+		struct tm t {};
+#if defined(SIMPLELOG_WINDOWS)
+		if (utc) gmtime_s(&t, &second); else localtime_s(&t, &second);
+#else
+		if (utc) gmtime_r(&second, &t); else localtime_r(&second, &t);
+#endif
+		char buf[64];
+		size_t len = std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &t);
+		if (precision == sgrottel::TimeStampFormatter::Precision::Milliseconds)
+		{
+			len += static_cast<size_t>(std::snprintf(buf + len, sizeof(buf) - len, ".%03u", fraction / 1000));
+		}
+		else if (precision == sgrottel::TimeStampFormatter::Precision::Microseconds)
+		{
+			len += static_cast<size_t>(std::snprintf(buf + len, sizeof(buf) - len, ".%06u", fraction));
+		}
+		return std::string{ buf, len } + "Z";
+	}
+
+	/// <summary>
+	/// The cached time stamps match the calendar functions, in UTC and local time, for all precisions,
+	/// also across changes of seconds, minutes, days, and years, and when the time goes backwards
+	/// </summary>
+	bool CheckTimeStamp()
+	{
+		using namespace std::chrono;
+		using Formatter = sgrottel::TimeStampFormatter;
+
+		std::vector<system_clock::time_point> times;
+		// 2023-12-31 23:59:55, 2024-02-28 23:59:58, 2026-10-16 12:00:00
+		for (int64_t start : { 1704067195ll, 1709164798ll, 1792152000ll })
+		{
+			system_clock::time_point const t0{ duration_cast<system_clock::duration>(seconds{ start }) };
+			for (int64_t k = 0; k < 2000; ++k)
+			{
+				times.push_back(t0 + duration_cast<system_clock::duration>(microseconds{ k * 123457 }));
+			}
+			for (int64_t jump : { 60ll, -60ll, -120ll, 3600ll, -86400ll, 86400ll * 366, 1ll, -1ll })
+			{
+				times.push_back(times.back() + duration_cast<system_clock::duration>(seconds{ jump }));
+			}
+		}
+
+		bool ok = true;
+		for (bool utc : { true, false })
+		{
+			for (Formatter::Precision precision : { Formatter::Precision::Seconds, Formatter::Precision::Milliseconds, Formatter::Precision::Microseconds })
+			{
+				Formatter formatter{ utc, precision };
+				for (system_clock::time_point const& time : times)
+				{
+					char buf[Formatter::MaxLength];
+					std::string const stamp{ buf, formatter.Format(buf, time) };
+					std::string const expected = ReferenceTimeStamp(time, utc, precision);
+					if (stamp != expected)
+					{
+						std::cout << "FAILED: time stamp \"" << stamp << "\" instead of \"" << expected << "\"" << std::endl;
+						ok = false;
+						break;
+					}
+				}
+			}
+		}
+		return ok;
+	}
+
+#if defined(SIMPLELOG_POSIX) && defined(__linux__)
+	/// <summary>
+	/// Finds the descriptor of this process which refers to `path`, or returns -1
+	/// </summary>
+	int FindDescriptor(std::filesystem::path const& path)
+	{
+		std::error_code ec;
+		std::filesystem::path const target = std::filesystem::canonical(path, ec);
+		if (ec) return -1;
+		for (std::filesystem::directory_entry const& entry : std::filesystem::directory_iterator{ "/proc/self/fd", ec })
+		{
+			std::error_code linkEc;
+			if (std::filesystem::read_symlink(entry.path(), linkEc) == target && !linkEc)
+			{
+				return std::atoi(entry.path().filename().c_str());
+			}
+		}
+		return -1;
+	}
+
+	/// <summary>
+	/// The POSIX backend: the default directory from XDG_STATE_HOME, the default name from the executable,
+	/// the flags of the log file descriptor, and the UTF8 encoding of wide messages
+	/// </summary>
+	bool CheckPosixBackend()
+	{
+		TempDir dir{ "posix" };
+		bool ok = true;
+
+		// the default directory is determined on the first call
+		::setenv("XDG_STATE_HOME", dir.Path().c_str(), 1);
+		ok = Expect(sgrottel::SimpleLog::GetDefaultDirectory() == dir.Path() / "sgrottel_simplelog", "default directory in XDG_STATE_HOME") && ok;
+		ok = Expect(sgrottel::SimpleLog::GetDefaultName() == std::filesystem::read_symlink("/proc/self/exe").filename(), "default name of the executable") && ok;
+
+		std::filesystem::path path;
+		{
+			sgrottel::SimpleLog log{ dir.Path(), "posix", 2 };
+			path = log.GetFilePath();
+			log.Write(sgrottel::ISimpleLog::FlagLevelMessage, L"wide \u00DCber \U0001F600");
+
+			int const fd = FindDescriptor(path);
+			ok = Expect(fd >= 0, "descriptor of the log file") && ok;
+			if (fd >= 0)
+			{
+				ok = Expect((::fcntl(fd, F_GETFL) & O_APPEND) != 0, "log file opened with O_APPEND") && ok;
+				ok = Expect((::fcntl(fd, F_GETFD) & FD_CLOEXEC) != 0, "log file opened with O_CLOEXEC") && ok;
+			}
+		}
+
+		std::vector<std::string> const lines = ReadLines(path);
+		std::string const suffix = "| wide \xC3\x9C" "ber \xF0\x9F\x98\x80";
+		ok = Expect(lines.size() == 1 && lines[0].size() > suffix.size()
+			&& lines[0].compare(lines[0].size() - suffix.size(), suffix.size(), suffix) == 0, "wide message encoded as UTF8") && ok;
+		return ok;
+	}
+#endif
+
+	struct Check
+	{
+		char const* name;
+		bool (*func)();
+	};
+
+	Check const checks[] = {
+		{ "async-producers", &CheckAsyncProducers },
+		{ "async-copy-failure", &CheckAsyncCopyFailure },
+		{ "binary-args", &CheckBinaryArgs },
+		{ "binary-decoder", &CheckBinaryDecoder },
+		{ "binary-formats", &CheckBinaryFormats },
+		{ "flush-policy", &CheckFlushPolicy },
+		{ "ring-concurrent", &CheckRingConcurrent },
+#if defined(SIMPLELOG_POSIX)
+		{ "ring-stalled-writer", &CheckRingStalledWriter },
+#endif
+		{ "rotation-leftovers", &CheckRotationLeftovers },
+		{ "timestamp", &CheckTimeStamp },
+#if defined(SIMPLELOG_POSIX) && defined(__linux__)
+		{ "posix-backend", &CheckPosixBackend },
+#endif
+	};
+}
+
+int RunChecks(std::string const& name)
+{
+	bool found = false;
+	bool ok = true;
+	for (Check const& check : checks)
+	{
+		if (!name.empty() && name != check.name) continue;
+		found = true;
+		bool const passed = check.func();
+		std::cout << (passed ? "passed: " : "FAILED: ") << check.name << std::endl;
+		ok = passed && ok;
+	}
+	if (!found)
+	{
+		std::cout << "Unknown check: " << name << std::endl;
+		return 2;
+	}
+	return ok ? 0 : 1;
+}
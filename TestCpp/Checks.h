@@ -0,0 +1,25 @@
+// Checks.h  SimpleLog  TestCpp
+//
+// Copyright 2022-2026 SGrottel (www.sgrottel.de)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+
+/// <summary>
+/// Runs one behavior check of SimpleLog by its name, or all checks if the name is empty
+/// </summary>
+/// <returns>0 if the checks passed, 1 if a check failed, 2 if there is no check with this name</returns>
+int RunChecks(std::string const& name);
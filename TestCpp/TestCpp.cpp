@@ -14,6 +14,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "Checks.h"
 #include "Second.h"
 
 #include "SimpleLog/SimpleLog.hpp"
@@ -32,6 +33,14 @@ int wmain(int argc, wchar_t const* argv[])
 	using sgrottel::ISimpleLog;
 	using namespace std::string_view_literals;
 
+	if (argc > 1 && wcscmp(argv[1], L"-check") == 0)
+	{
+		// check names are ASCII
+		std::string name;
+		for (wchar_t const* c = (argc > 2) ? argv[2] : L""; *c != 0; ++c) name.push_back(static_cast<char>(*c));
+		return RunChecks(name);
+	}
+
 	bool waitForSemaphore = (argc > 2 && wcscmp(argv[2], L"-wait") == 0);
 
 	wchar_t filenameBuf[MAX_PATH + 1];
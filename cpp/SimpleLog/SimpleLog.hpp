@@ -41,9 +41,37 @@
 #include <clocale>
 #include <stdexcept>
 #include <string_view>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <map>
+#include <charconv>
+#include <type_traits>
+#include <cmath>
+#include <cstring>
+#include <cwchar>
+#include <functional>
+#include <initializer_list>
+#include <cerrno>
 
 #include <iostream>
 
+// The platform backend is selected at compile time.
+// Define either `SIMPLELOG_WINDOWS` or `SIMPLELOG_POSIX` explicitly to override the detection.
+#if !defined(SIMPLELOG_WINDOWS) && !defined(SIMPLELOG_POSIX)
+#if defined(_WIN32)
+#define SIMPLELOG_WINDOWS
+#else
+#define SIMPLELOG_POSIX
+#endif
+#endif
+
+#if defined(SIMPLELOG_WINDOWS)
+
 #if !(defined(_WINDOWS_) || defined(_INC_WINDOWS))
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
@@ -60,912 +88,5972 @@
 
 #include <psapi.h>
 
+#elif defined(SIMPLELOG_POSIX)
+
+#include <cstring>
+#include <cwchar>
+#include <cctype>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <signal.h>
+#include <cerrno>
+#include <climits>
+
+#endif
+
+// SIMD kernels for the string encoding are selected at compile time, e.g. AVX2 with `/arch:AVX2` or `-mavx2`.
+// Define `SIMPLELOG_NO_SIMD` to only use the portable scalar implementation.
+#if !defined(SIMPLELOG_NO_SIMD)
+#if defined(__AVX2__)
+#define SIMPLELOG_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMPLELOG_SSE2
+#endif
+#endif
+
+#if defined(SIMPLELOG_AVX2)
+#include <immintrin.h>
+#elif defined(SIMPLELOG_SSE2)
+#include <emmintrin.h>
+#endif
+
+// Compile-time minimum message level.
+// Messages with a less severe level are removed at compile time, see `ISimpleLog::IsLevelCompiledIn`.
+// Define `SIMPLELOG_MIN_LEVEL` to one of the `SIMPLELOG_LEVEL_*` values, identically for all translation units of a program.
+#define SIMPLELOG_LEVEL_CRITICAL 0x7
+#define SIMPLELOG_LEVEL_ERROR 0x5
+#define SIMPLELOG_LEVEL_WARNING 0x3
+#define SIMPLELOG_LEVEL_MESSAGE 0x0
+#define SIMPLELOG_LEVEL_DETAIL 0x1
+
+#ifndef SIMPLELOG_MIN_LEVEL
+#define SIMPLELOG_MIN_LEVEL SIMPLELOG_LEVEL_DETAIL
+#endif
+
+// same ranking as `ISimpleLog::GetLevelSeverity`, usable in preprocessor conditions
+#define SIMPLELOG_LEVEL_SEVERITY(level) (((level) <= 1) ? (1 - (level)) : (level))
+
+// Logging macros which also remove the evaluation of all arguments, if the level is below `SIMPLELOG_MIN_LEVEL`.
+// Usage: `SIMPLELOG_DETAIL(log, "value %d", expensiveComputation());`
+#if SIMPLELOG_LEVEL_SEVERITY(SIMPLELOG_MIN_LEVEL) <= SIMPLELOG_LEVEL_SEVERITY(SIMPLELOG_LEVEL_CRITICAL)
+#define SIMPLELOG_CRITICAL(log, ...) (log).Critical(__VA_ARGS__)
+#else
+#define SIMPLELOG_CRITICAL(log, ...) ((void)0)
+#endif
+#if SIMPLELOG_LEVEL_SEVERITY(SIMPLELOG_MIN_LEVEL) <= SIMPLELOG_LEVEL_SEVERITY(SIMPLELOG_LEVEL_ERROR)
+#define SIMPLELOG_ERROR(log, ...) (log).Error(__VA_ARGS__)
+#else
+#define SIMPLELOG_ERROR(log, ...) ((void)0)
+#endif
+#if SIMPLELOG_LEVEL_SEVERITY(SIMPLELOG_MIN_LEVEL) <= SIMPLELOG_LEVEL_SEVERITY(SIMPLELOG_LEVEL_WARNING)
+#define SIMPLELOG_WARNING(log, ...) (log).Warning(__VA_ARGS__)
+#else
+#define SIMPLELOG_WARNING(log, ...) ((void)0)
+#endif
+#if SIMPLELOG_LEVEL_SEVERITY(SIMPLELOG_MIN_LEVEL) <= SIMPLELOG_LEVEL_SEVERITY(SIMPLELOG_LEVEL_MESSAGE)
+#define SIMPLELOG_MESSAGE(log, ...) (log).Message(__VA_ARGS__)
+#else
+#define SIMPLELOG_MESSAGE(log, ...) ((void)0)
+#endif
+#if SIMPLELOG_LEVEL_SEVERITY(SIMPLELOG_MIN_LEVEL) <= SIMPLELOG_LEVEL_SEVERITY(SIMPLELOG_LEVEL_DETAIL)
+#define SIMPLELOG_DETAIL(log, ...) (log).Detail(__VA_ARGS__)
+#else
+#define SIMPLELOG_DETAIL(log, ...) ((void)0)
+#endif
+
 namespace sgrottel
 {
 
 	/// <summary>
-	/// Abstract interface class for writing a message
+	/// Character buffer for formatting messages.
+	/// Small messages are stored in the inline storage, e.g. on the stack; only larger messages allocate heap memory.
 	/// </summary>
-	class ISimpleLog
+	/// <remarks>
+	/// The buffer always keeps room for a terminating zero after its content.
+	/// </remarks>
+	template<typename CHAR, size_t INLINE_CAPACITY = 512>
+	class MessageBuffer
 	{
 	public:
-		/// <summary>
-		/// Major version number constant
-		/// </summary>
-		static constexpr int const VERSION_MAJOR = 3;
+		MessageBuffer() noexcept = default;
 
-		/// <summary>
-		/// Minor version number constant
-		/// </summary>
-		static constexpr int const VERSION_MINOR = 3;
+		MessageBuffer(const MessageBuffer&) = delete;
+		MessageBuffer(MessageBuffer&&) = delete;
+		MessageBuffer& operator=(const MessageBuffer&) = delete;
+		MessageBuffer& operator=(MessageBuffer&&) = delete;
 
-		/// <summary>
-		/// Patch version number constant
-		/// </summary>
-		static constexpr int const VERSION_PATCH = 4;
+		inline CHAR* Data() noexcept { return m_data; }
+		inline CHAR const* Data() const noexcept { return m_data; }
+		inline size_t Size() const noexcept { return m_size; }
 
 		/// <summary>
-		/// Build version number constant
+		/// The number of characters the buffer can hold without reallocation, not including the terminating zero
 		/// </summary>
-		static constexpr int const VERSION_BUILD = 0;
+		inline size_t Capacity() const noexcept { return m_capacity; }
 
-		/// <summary>
-		/// Flag message as critical error
-		/// </summary>
-		static constexpr uint32_t const FlagLevelCritical = 0x00000007;
+		inline void Clear() noexcept { m_size = 0; }
 
 		/// <summary>
-		/// Flag message as critical error (deprecated)
+		/// Grows the buffer to hold at least `capacity` characters, keeping its content
 		/// </summary>
-		/// <remarks>Deprecated! Use `FlagLevelCritical` instead</remarks>
-		[[deprecated("Deprecated! Use `FlagLevelCritical` instead")]] 
-		static constexpr uint32_t const FlagLevelCritial = 0x00000007;
+		void Reserve(size_t capacity)
+		{
+			if (capacity <= m_capacity) return;
+			size_t newCapacity = std::max(capacity, m_capacity * 2);
+			std::unique_ptr<CHAR[]> heap{ new CHAR[newCapacity + 1] };
+			std::char_traits<CHAR>::copy(heap.get(), m_data, m_size);
+			m_heap = std::move(heap);
+			m_data = m_heap.get();
+			m_capacity = newCapacity;
+		}
 
 		/// <summary>
-		/// Flag message as error
+		/// Sets the size of the content; new characters are not initialized
 		/// </summary>
-		static constexpr uint32_t const FlagLevelError = 0x00000005;
+		inline void Resize(size_t size)
+		{
+			Reserve(size);
+			m_size = size;
+		}
 
-		/// <summary>
-		/// Flag message as warning
-		/// </summary>
-		static constexpr uint32_t const FlagLevelWarning = 0x0000003;
+		inline void Append(CHAR const* str, size_t len)
+		{
+			Reserve(m_size + len);
+			std::char_traits<CHAR>::copy(m_data + m_size, str, len);
+			m_size += len;
+		}
 
-		/// <summary>
-		/// Flag message as normal information message
-		/// </summary>
-		static constexpr uint32_t const FlagLevelMessage = 0x0000000;
+		inline void Append(size_t count, CHAR c)
+		{
+			Reserve(m_size + count);
+			std::char_traits<CHAR>::assign(m_data + m_size, count, c);
+			m_size += count;
+		}
 
-		/// <summary>
-		/// Flag message as detail information
-		/// </summary>
-		static constexpr uint32_t const FlagLevelDetail = 0x00000001;
+		inline void Push(CHAR c)
+		{
+			if (m_size == m_capacity) Reserve(m_size + 1);
+			m_data[m_size++] = c;
+		}
 
 		/// <summary>
-		/// Masks the bits of the flags field which are used to specify the message level
+		/// Gets the content as zero-terminated string
 		/// </summary>
-		static constexpr uint32_t const FlagLevelMask = 0x00000007;
+		inline CHAR const* CStr() noexcept
+		{
+			m_data[m_size] = 0;
+			return m_data;
+		}
 
-	protected:
+	private:
+		CHAR m_inline[INLINE_CAPACITY + 1];
+		std::unique_ptr<CHAR[]> m_heap;
+		CHAR* m_data{ m_inline };
+		size_t m_size{ 0 };
+		size_t m_capacity{ INLINE_CAPACITY };
+	};
 
-		/// <summary>
-		/// Write a message to the log
-		/// </summary>
-		/// <param name="flags">The message flags</param>
-		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
-		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.</param>
-		virtual void WriteImpl(uint32_t flags, char const* message, size_t messageLength) const = 0;
+	/// <summary>
+	/// Formats messages into a `MessageBuffer`, without intermediate allocations.
+	/// </summary>
+	/// <remarks>
+	/// Two formatting syntaxes are supported:
+	/// `Printf` follows the printf function family;
+	/// `Format` is a type-safe subset of the `std::format` syntax: "{}", "{1}", "{:x}", "{:>8.3f}", "{{", "}}".
+	/// Supported `Format` arguments are booleans, characters, integers, enums, floating point numbers, pointers,
+	/// and strings of the same character type as the format string.
+	/// Invalid placeholders, or placeholders without matching arguments, are copied to the output unchanged.
+	/// </remarks>
+	template<typename CHAR>
+	class MessageFormatter
+	{
+	public:
+		MessageFormatter() = delete;
 
 		/// <summary>
-		/// Write a message to the log
+		/// The largest buffer for wide printf-based formatting on platforms where the output cannot be measured, in characters.
+		/// Longer messages are discarded.
 		/// </summary>
-		/// <param name="flags">The message flags</param>
-		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
-		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.</param>
-		virtual void WriteImpl(uint32_t flags, wchar_t const* message, size_t messageLength) const = 0;
+		static constexpr size_t MaxWidePrintfCapacity = 1u << 20;
 
 		/// <summary>
-		/// Utility function to forward the write arguments to the implementation with another object (unknown class of this base).
+		/// Printf-based formatting. Formats in one pass if the output fits into the buffer's capacity.
 		/// </summary>
-		template<typename LOG, typename CHAR>
-		void ForwardWriteImpl(LOG& log, uint32_t flags, CHAR const* message, size_t messageLength) const
+		/// <param name="out">Receives the formatted string</param>
+		/// <param name="format">The printf format string; must be zero-terminated</param>
+		template<size_t INLINE_CAPACITY, typename ...PARAMS>
+		static void Printf(MessageBuffer<CHAR, INLINE_CAPACITY>& out, CHAR const* format, PARAMS&&... params)
 		{
-			log.WriteImpl(flags, message, messageLength);
+			out.Clear();
+			if constexpr (std::is_same_v<CHAR, char>)
+			{
+				int len = std::snprintf(out.Data(), out.Capacity() + 1, format, params...);
+				if (len < 0) return;
+				if (static_cast<size_t>(len) > out.Capacity())
+				{
+					// oversized output: second pass into a heap buffer of the exact size
+					out.Reserve(static_cast<size_t>(len));
+					len = std::snprintf(out.Data(), out.Capacity() + 1, format, params...);
+					if (len < 0) return;
+				}
+				out.Resize(static_cast<size_t>(len));
+			}
+			else
+			{
+				// Visual Cpp and the C standard differ in the meaning of `%s` in wide format strings.
+				// The platform's own function is used, so the behavior matches the platform's wprintf.
+				for (;;)
+				{
+					errno = 0;
+					int len = std::swprintf(out.Data(), out.Capacity() + 1, format, params...);
+					if (len >= 0)
+					{
+						out.Resize(static_cast<size_t>(len));
+						return;
+					}
+					// an encoding error fails with every buffer size
+					if (errno == EILSEQ) return;
+#if defined(_MSC_VER)
+					// Visual Cpp specific
+					len = _scwprintf(format, params...);
+					if (len < 0 || static_cast<size_t>(len) <= out.Capacity()) return;
+					out.Reserve(static_cast<size_t>(len));
+#else
+					// swprintf cannot measure the output, so the buffer grows until the output fits
+					if (out.Capacity() >= MaxWidePrintfCapacity) return;
+					out.Reserve(std::min(out.Capacity() * 4, MaxWidePrintfCapacity));
+#endif
+				}
+			}
 		}
 
 		/// <summary>
-		/// Printf-based formatting of a string; must be zero-terminated.
+		/// Type-safe formatting following a subset of the `std::format` syntax
 		/// </summary>
-		template<typename ...PARAMS>
-		static std::string formatString(char const* format, PARAMS&&... params)
+		/// <param name="out">Receives the formatted string</param>
+		/// <param name="format">The format string</param>
+		/// <param name="args">The formatting arguments</param>
+		template<size_t INLINE_CAPACITY, typename ...ARGS>
+		static void Format(MessageBuffer<CHAR, INLINE_CAPACITY>& out, std::basic_string_view<CHAR> format, ARGS const&... args)
 		{
-			// Visual Cpp specific
-			size_t bufSize = _scprintf(format, params...) + 1;
-			std::shared_ptr<char> buf{ new char[bufSize], [](char* p) { delete[] p; } };
-			size_t end = sprintf_s(buf.get(), bufSize, format, params...);
-			buf.get()[(end > 0 && end < bufSize) ? end : 0] = 0;
-			return buf.get();
+			Arg const argList[] = { makeArg(args)..., Arg{} };
+			out.Clear();
+			formatImpl(out, format, argList, sizeof...(ARGS));
 		}
 
+	private:
+
 		/// <summary>
-		/// Printf-based formatting of a wstring; must be zero-terminated.
+		/// Type-erased formatting argument
 		/// </summary>
-		template<typename ...PARAMS>
-		static std::wstring formatString(wchar_t const* format, PARAMS&&... params)
+		struct Arg
 		{
-			// Visual Cpp specific
-			size_t bufSize = _scwprintf(format, params...) + 1;
-			std::shared_ptr<wchar_t> buf{ new wchar_t[bufSize], [](wchar_t* p) { delete[] p; } };
-			size_t end = swprintf_s(buf.get(), bufSize, format, params...);
-			buf.get()[(end > 0 && end < bufSize) ? end : 0] = 0;
-			return buf.get();
-		}
+			enum class Type { None, Bool, Char, Int, UInt, Double, String, Pointer };
+			Type type{ Type::None };
+			union
+			{
+				bool b;
+				CHAR c;
+				long long i;
+				unsigned long long u;
+				double d;
+				void const* p;
+				struct
+				{
+					CHAR const* str;
+					size_t len;
+				} s;
+			};
+			Arg() noexcept : u{ 0 } {}
+		};
 
-	public:
+		template<typename T>
+		struct alwaysFalse : std::false_type {};
 
-		/// <summary>
-		/// Write a message to the log
-		/// </summary>
-		/// <param name="flags">The message flags</param>
-		/// <param name="message">The message string; must be zero-terminated. Expected to NOT contain a new line at the end.</param>
-		inline void Write(uint32_t flags, char const* message) const
+		template<typename T>
+		static Arg makeArg(T const& value)
 		{
-			this->WriteImpl(flags, message, std::strlen(message));
+			Arg a;
+			using V = std::remove_cv_t<T>;
+			if constexpr (std::is_same_v<V, bool>)
+			{
+				a.type = Arg::Type::Bool;
+				a.b = value;
+			}
+			else if constexpr (std::is_same_v<V, CHAR> || std::is_same_v<V, char>)
+			{
+				a.type = Arg::Type::Char;
+				a.c = static_cast<CHAR>(value);
+			}
+			else if constexpr (std::is_enum_v<V>)
+			{
+				return makeArg(static_cast<std::underlying_type_t<V>>(value));
+			}
+			else if constexpr (std::is_integral_v<V> && std::is_signed_v<V>)
+			{
+				a.type = Arg::Type::Int;
+				a.i = static_cast<long long>(value);
+			}
+			else if constexpr (std::is_integral_v<V>)
+			{
+				a.type = Arg::Type::UInt;
+				a.u = static_cast<unsigned long long>(value);
+			}
+			else if constexpr (std::is_floating_point_v<V>)
+			{
+				a.type = Arg::Type::Double;
+				a.d = static_cast<double>(value);
+			}
+			else if constexpr (std::is_array_v<V> && std::is_same_v<std::remove_cv_t<std::remove_extent_t<V>>, CHAR>)
+			{
+				a.type = Arg::Type::String;
+				a.s.str = value;
+				a.s.len = std::char_traits<CHAR>::length(value);
+			}
+			else if constexpr (std::is_same_v<V, CHAR const*> || std::is_same_v<V, CHAR*>)
+			{
+				a.type = Arg::Type::String;
+				a.s.str = (value != nullptr) ? value : nullString();
+				a.s.len = std::char_traits<CHAR>::length(a.s.str);
+			}
+			else if constexpr (std::is_convertible_v<V const&, std::basic_string_view<CHAR>>)
+			{
+				std::basic_string_view<CHAR> const sv = value;
+				a.type = Arg::Type::String;
+				a.s.str = sv.data();
+				a.s.len = sv.size();
+			}
+			else if constexpr (std::is_pointer_v<V> || std::is_null_pointer_v<V>)
+			{
+				a.type = Arg::Type::Pointer;
+				a.p = static_cast<void const*>(value);
+			}
+			else
+			{
+				static_assert(alwaysFalse<V>::value, "Unsupported formatting argument type");
+			}
+			return a;
 		}
 
-		/// <summary>
-		/// Write a message to the log
-		/// </summary>
-		/// <param name="flags">The message flags</param>
-		/// <param name="message">The message string; must be zero-terminated. Expected to NOT contain a new line at the end.</param>
-		inline void Write(uint32_t flags, wchar_t const* message) const
+		static CHAR const* nullString() noexcept
 		{
-			this->WriteImpl(flags, message, std::wcslen(message));
+			static CHAR const str[] = { '(', 'n', 'u', 'l', 'l', ')', 0 };
+			return str;
 		}
 
 		/// <summary>
-		/// Write a message to the log
+		/// Parsed format specification: [[fill]align][sign][#][0][width][.precision][type]
 		/// </summary>
-		/// <param name="flags">The message flags</param>
-		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
-		template<typename CHAR, typename TRAITS>
-		inline void Write(uint32_t flags, std::basic_string_view<CHAR, TRAITS> const& message) const
+		struct Spec
 		{
-			this->WriteImpl(flags, message.data(), message.length());
+			CHAR fill{ ' ' };
+			char align{ 0 };
+			char sign{ '-' };
+			bool alternate{ false };
+			bool zeroPad{ false };
+			size_t width{ 0 };
+			int precision{ -1 };
+			char type{ 0 };
+		};
+
+		static bool isDigit(CHAR c) noexcept { return c >= '0' && c <= '9'; }
+
+		static bool isAlign(CHAR c) noexcept { return c == '<' || c == '>' || c == '^'; }
+
+		static bool parseSpec(std::basic_string_view<CHAR> str, Spec& spec) noexcept
+		{
+			size_t i = 0;
+			if (str.size() >= 2 && isAlign(str[1]))
+			{
+				spec.fill = str[0];
+				spec.align = static_cast<char>(str[1]);
+				i = 2;
+			}
+			else if (str.size() >= 1 && isAlign(str[0]))
+			{
+				spec.align = static_cast<char>(str[0]);
+				i = 1;
+			}
+			if (i < str.size() && (str[i] == '+' || str[i] == '-' || str[i] == ' '))
+			{
+				spec.sign = static_cast<char>(str[i++]);
+			}
+			if (i < str.size() && str[i] == '#')
+			{
+				spec.alternate = true;
+				++i;
+			}
+			if (i < str.size() && str[i] == '0')
+			{
+				spec.zeroPad = true;
+				++i;
+			}
+			while (i < str.size() && isDigit(str[i]))
+			{
+				spec.width = spec.width * 10 + static_cast<size_t>(str[i++] - '0');
+				if (spec.width > 4096) return false;
+			}
+			if (i < str.size() && str[i] == '.')
+			{
+				++i;
+				if (i >= str.size() || !isDigit(str[i])) return false;
+				spec.precision = 0;
+				while (i < str.size() && isDigit(str[i]))
+				{
+					spec.precision = spec.precision * 10 + static_cast<int>(str[i++] - '0');
+					if (spec.precision > 1000) return false;
+				}
+			}
+			if (i < str.size())
+			{
+				CHAR const t = str[i++];
+				if (t > 0x7f || std::strchr("bBcdoxXeEfFgGsp", static_cast<char>(t)) == nullptr) return false;
+				spec.type = static_cast<char>(t);
+			}
+			return i == str.size();
 		}
 
-		/// <summary>
-		/// Write a message to the log
-		/// </summary>
-		/// <param name="flags">The message flags</param>
-		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
-		template<typename CHAR, typename TRAITS, typename ALLOCATOR>
-		inline void Write(uint32_t flags, std::basic_string<CHAR, TRAITS, ALLOCATOR> const& message) const
+		template<size_t INLINE_CAPACITY>
+		static void appendAscii(MessageBuffer<CHAR, INLINE_CAPACITY>& out, char const* str, size_t len)
 		{
-			this->WriteImpl(flags, message.data(), message.length());
+			if constexpr (std::is_same_v<CHAR, char>)
+			{
+				out.Append(str, len);
+			}
+			else
+			{
+				size_t const pos = out.Size();
+				out.Resize(pos + len);
+				for (size_t i = 0; i < len; ++i)
+				{
+					out.Data()[pos + i] = static_cast<CHAR>(str[i]);
+				}
+			}
 		}
 
 		/// <summary>
-		/// Write a message to the log
+		/// Appends the formatted field with padding.
+		/// `prefixLen` characters at the start of the field (sign and base prefix) stay in front of zero padding.
 		/// </summary>
-		/// <param name="flags">The message flags</param>
-		/// <param name="message">The message string; must be zero-terminated. Expected to NOT contain a new line at the end.
-		/// Formatting follows the specification of the printf function family.</param>
-		/// <param name="p1">The first formatting argument</param>
-		/// <param name="...params">Additional formatting arguments</param>
-		template<typename PARAM1, typename ...PARAMS>
-		inline void Write(uint32_t flags, char const* message, PARAM1&& p1, PARAMS&&... params) const
+		template<size_t INLINE_CAPACITY>
+		static void appendPadded(MessageBuffer<CHAR, INLINE_CAPACITY>& out, Spec const& spec, char defaultAlign,
+			char const* asciiField, CHAR const* field, size_t len, size_t prefixLen)
 		{
-			this->Write(flags, formatString(message, std::forward<PARAM1>(p1), std::forward<PARAMS>(params)...));
+			size_t const pad = (spec.width > len) ? (spec.width - len) : 0;
+			char const align = (spec.align != 0) ? spec.align : defaultAlign;
+			size_t padBefore = 0;
+			size_t padAfter = 0;
+			bool const zeroPad = spec.zeroPad && spec.align == 0 && asciiField != nullptr;
+			if (zeroPad || align == '>') padBefore = pad;
+			else if (align == '^') { padBefore = pad / 2; padAfter = pad - padBefore; }
+			else padAfter = pad;
+
+			if (zeroPad)
+			{
+				appendAscii(out, asciiField, prefixLen);
+				out.Append(padBefore, static_cast<CHAR>('0'));
+				appendAscii(out, asciiField + prefixLen, len - prefixLen);
+				return;
+			}
+			out.Append(padBefore, spec.fill);
+			if (asciiField != nullptr)
+			{
+				appendAscii(out, asciiField, len);
+			}
+			else
+			{
+				out.Append(field, len);
+			}
+			out.Append(padAfter, spec.fill);
 		}
 
-		/// <summary>
-		/// Write a message to the log
-		/// </summary>
-		/// <param name="flags">The message flags</param>
-		/// <param name="message">The message string; must be zero-terminated. Expected to NOT contain a new line at the end.
-		/// Formatting follows the specification of the printf function family.</param>
-		/// <param name="p1">The first formatting argument</param>
-		/// <param name="...params">Additional formatting arguments</param>
-		template<typename PARAM1, typename ...PARAMS>
-		inline void Write(uint32_t flags, wchar_t const* message, PARAM1&& p1, PARAMS&&... params) const
+		template<size_t INLINE_CAPACITY>
+		static bool formatInteger(MessageBuffer<CHAR, INLINE_CAPACITY>& out, Spec const& spec, bool negative, unsigned long long magnitude)
 		{
-			this->Write(flags, formatString(message, std::forward<PARAM1>(p1), std::forward<PARAMS>(params)...));
+			int base = 10;
+			char const* prefix = "";
+			switch (spec.type)
+			{
+			case 0: case 'd': break;
+			case 'x': base = 16; prefix = "0x"; break;
+			case 'X': base = 16; prefix = "0X"; break;
+			case 'b': base = 2; prefix = "0b"; break;
+			case 'B': base = 2; prefix = "0B"; break;
+			case 'o': base = 8; prefix = "0"; break;
+			default: return false;
+			}
+			char buf[80];
+			size_t len = 0;
+			if (negative) buf[len++] = '-';
+			else if (spec.sign == '+' || spec.sign == ' ') buf[len++] = spec.sign;
+			if (spec.alternate && !(base == 8 && magnitude == 0))
+			{
+				for (char const* p = prefix; *p != 0; ++p) buf[len++] = *p;
+			}
+			size_t const prefixLen = len;
+			auto r = std::to_chars(buf + len, buf + sizeof(buf), magnitude, base);
+			if (spec.type == 'X')
+			{
+				for (char* p = buf + len; p != r.ptr; ++p)
+				{
+					if (*p >= 'a' && *p <= 'f') *p = static_cast<char>(*p - 'a' + 'A');
+				}
+			}
+			len = static_cast<size_t>(r.ptr - buf);
+			appendPadded(out, spec, '>', buf, nullptr, len, prefixLen);
+			return true;
 		}
 
-		/// <summary>
-		/// Write a message to the log
-		/// </summary>
-		/// <param name="flags">The message flags</param>
-		/// <param name="message">The message string. Expected to NOT contain a new line at the end.
-		/// Formatting follows the specification of the printf function family.</param>
-		/// <param name="p1">The first formatting argument</param>
-		/// <param name="...params">Additional formatting arguments</param>
-		template<typename CHAR, typename TRAITS, typename PARAM1, typename ...PARAMS>
-		inline void Write(uint32_t flags, std::basic_string_view<CHAR, TRAITS> const& message, PARAM1&& p1, PARAMS&&... params) const
+		template<size_t INLINE_CAPACITY>
+		static bool formatDouble(MessageBuffer<CHAR, INLINE_CAPACITY>& out, Spec const& spec, double value)
 		{
-			this->Write(flags, formatString(std::basic_string<CHAR>{message}.c_str(), std::forward<PARAM1>(p1), std::forward<PARAMS>(params)...));
+			char buf[1200];
+			size_t len = 0;
+			if (!std::signbit(value) && (spec.sign == '+' || spec.sign == ' ')) buf[len++] = spec.sign;
+			std::to_chars_result r;
+			char* const first = buf + len;
+			char* const last = buf + sizeof(buf);
+			switch (spec.type)
+			{
+			case 0:
+				r = (spec.precision < 0)
+					? std::to_chars(first, last, value)
+					: std::to_chars(first, last, value, std::chars_format::general, spec.precision);
+				break;
+			case 'f': case 'F':
+				r = std::to_chars(first, last, value, std::chars_format::fixed, (spec.precision < 0) ? 6 : spec.precision);
+				break;
+			case 'e': case 'E':
+				r = std::to_chars(first, last, value, std::chars_format::scientific, (spec.precision < 0) ? 6 : spec.precision);
+				break;
+			case 'g': case 'G':
+				r = std::to_chars(first, last, value, std::chars_format::general, (spec.precision < 0) ? 6 : spec.precision);
+				break;
+			default:
+				return false;
+			}
+			if (r.ec != std::errc{}) return false;
+			if (spec.type == 'F' || spec.type == 'E' || spec.type == 'G')
+			{
+				for (char* p = first; p != r.ptr; ++p)
+				{
+					if (*p >= 'a' && *p <= 'z') *p = static_cast<char>(*p - 'a' + 'A');
+				}
+			}
+			len = static_cast<size_t>(r.ptr - buf);
+			size_t const prefixLen = (len > 0 && (buf[0] == '-' || buf[0] == '+' || buf[0] == ' ')) ? 1 : 0;
+			bool const finite = std::isfinite(value);
+			Spec s = spec;
+			if (!finite) s.zeroPad = false;
+			appendPadded(out, s, '>', buf, nullptr, len, prefixLen);
+			return true;
 		}
 
-		/// <summary>
-		/// Write a message to the log
-		/// </summary>
-		/// <param name="flags">The message flags</param>
-		/// <param name="message">The message string. Expected to NOT contain a new line at the end.
-		/// Formatting follows the specification of the printf function family.</param>
-		/// <param name="p1">The first formatting argument</param>
-		/// <param name="...params">Additional formatting arguments</param>
-		template<typename CHAR, typename TRAITS, typename ALLOCATOR, typename PARAM1, typename ...PARAMS>
-		inline void Write(uint32_t flags, std::basic_string<CHAR, TRAITS, ALLOCATOR> const& message, PARAM1&& p1, PARAMS&&... params) const
+		template<size_t INLINE_CAPACITY>
+		static bool formatArg(MessageBuffer<CHAR, INLINE_CAPACITY>& out, Arg const& arg, Spec const& spec)
+		{
+			switch (arg.type)
+			{
+			case Arg::Type::Bool:
+				if (spec.type == 0 || spec.type == 's')
+				{
+					char const* str = arg.b ? "true" : "false";
+					appendPadded(out, spec, '<', str, nullptr, arg.b ? 4 : 5, 0);
+					return true;
+				}
+				return formatInteger(out, spec, false, arg.b ? 1 : 0);
+			case Arg::Type::Char:
+				if (spec.type == 0 || spec.type == 'c')
+				{
+					appendPadded(out, spec, '<', nullptr, &arg.c, 1, 0);
+					return true;
+				}
+				return formatInteger(out, spec, false, static_cast<unsigned long long>(static_cast<std::make_unsigned_t<CHAR>>(arg.c)));
+			case Arg::Type::Int:
+				if (spec.type == 'c')
+				{
+					CHAR const c = static_cast<CHAR>(arg.i);
+					appendPadded(out, spec, '<', nullptr, &c, 1, 0);
+					return true;
+				}
+				return formatInteger(out, spec, arg.i < 0, (arg.i < 0) ? (0ull - static_cast<unsigned long long>(arg.i)) : static_cast<unsigned long long>(arg.i));
+			case Arg::Type::UInt:
+				if (spec.type == 'c')
+				{
+					CHAR const c = static_cast<CHAR>(arg.u);
+					appendPadded(out, spec, '<', nullptr, &c, 1, 0);
+					return true;
+				}
+				return formatInteger(out, spec, false, arg.u);
+			case Arg::Type::Double:
+				return formatDouble(out, spec, arg.d);
+			case Arg::Type::String:
+				if (spec.type == 0 || spec.type == 's')
+				{
+					size_t len = arg.s.len;
+					if (spec.precision >= 0 && static_cast<size_t>(spec.precision) < len) len = static_cast<size_t>(spec.precision);
+					appendPadded(out, spec, '<', nullptr, arg.s.str, len, 0);
+					return true;
+				}
+				return false;
+			case Arg::Type::Pointer:
+				if (spec.type == 0 || spec.type == 'p')
+				{
+					Spec s = spec;
+					s.type = 'x';
+					s.alternate = true;
+					return formatInteger(out, s, false, static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(arg.p)));
+				}
+				return false;
+			default:
+				return false;
+			}
+		}
+
+		template<size_t INLINE_CAPACITY>
+		static void formatImpl(MessageBuffer<CHAR, INLINE_CAPACITY>& out, std::basic_string_view<CHAR> format, Arg const* args, size_t argCount)
 		{
-			this->Write(flags, formatString(message.c_str(), std::forward<PARAM1>(p1), std::forward<PARAMS>(params)...));
+			size_t nextArg = 0;
+			size_t i = 0;
+			while (i < format.size())
+			{
+				CHAR const c = format[i];
+				if (c == '}')
+				{
+					out.Push(c);
+					i += (i + 1 < format.size() && format[i + 1] == '}') ? 2 : 1;
+					continue;
+				}
+				if (c != '{')
+				{
+					size_t end = i + 1;
+					while (end < format.size() && format[end] != '{' && format[end] != '}') ++end;
+					out.Append(format.data() + i, end - i);
+					i = end;
+					continue;
+				}
+				if (i + 1 < format.size() && format[i + 1] == '{')
+				{
+					out.Push(c);
+					i += 2;
+					continue;
+				}
+
+				size_t const close = format.find(static_cast<CHAR>('}'), i + 1);
+				if (close == std::basic_string_view<CHAR>::npos)
+				{
+					out.Append(format.data() + i, format.size() - i);
+					return;
+				}
+				std::basic_string_view<CHAR> field = format.substr(i + 1, close - i - 1);
+				std::basic_string_view<CHAR> const placeholder = format.substr(i, close - i + 1);
+				i = close + 1;
+
+				size_t argIndex = nextArg;
+				size_t p = 0;
+				if (p < field.size() && isDigit(field[p]))
+				{
+					argIndex = 0;
+					while (p < field.size() && isDigit(field[p]) && argIndex < argCount + 1)
+					{
+						argIndex = argIndex * 10 + static_cast<size_t>(field[p++] - '0');
+					}
+				}
+				else
+				{
+					++nextArg;
+				}
+				Spec spec;
+				bool valid = (argIndex < argCount);
+				if (valid && p < field.size())
+				{
+					valid = (field[p] == ':') && parseSpec(field.substr(p + 1), spec);
+				}
+				size_t const rollback = out.Size();
+				if (!valid || !formatArg(out, args[argIndex], spec))
+				{
+					out.Resize(rollback);
+					out.Append(placeholder.data(), placeholder.size());
+				}
+			}
 		}
+	};
+
+	/// <summary>
+	/// Definitions of the binary log file format, and encoding of unformatted printf arguments
+	/// </summary>
+	/// <remarks>
+	/// A binary log file starts with `Magic`, followed by records.
+	/// Each record starts with its type (one byte) and the length of its payload (four bytes).
+	/// All values are stored in the byte order of the writing system; the header record allows to detect it.
+	/// </remarks>
+	class BinaryLogFormat
+	{
+	public:
+		BinaryLogFormat() = delete;
+
+		static constexpr char const Magic[8] = { 'S', 'G', 'S', 'L', 'B', 'I', 'N', '\n' };
+		static constexpr uint8_t const Version = 1;
+		static constexpr uint32_t const ByteOrderMark = 0x01020304;
+		static constexpr size_t const RecordHeaderSize = 5;
 
 		/// <summary>
-		/// Write a message to the log
+		/// Maximum number of format strings of a binary log file; messages with further format strings are recorded as text
 		/// </summary>
-		/// <param name="message">The message string; must be zero-terminated. Expected to NOT contain a new line at the end.</param>
-		/// <param name="...params">Additional formatting arguments, if any. Formatting follows the specification of the printf function family.</param>
-		template<typename ...PARAMS>
-		inline void Write(char const* message, PARAMS&&... params) const
+		static constexpr uint32_t const MaxFormats = 4096;
+
+		enum class RecordType : uint8_t
 		{
-			this->Write(static_cast<uint32_t>(0), message, std::forward<PARAMS>(params)...);
-		}
+			/// <summary>
+			/// Payload: version (uint8), size of wchar_t (uint8), UTC time stamps (uint8), time stamp precision (uint8), `ByteOrderMark` (uint32)
+			/// </summary>
+			Header = 0,
+
+			/// <summary>
+			/// Payload: format id (uint32), format string (remaining bytes)
+			/// </summary>
+			Format = 1,
+
+			/// <summary>
+			/// Payload: time in nanoseconds since the epoch (int64), flags (uint32), format id (uint32), encoded arguments (remaining bytes)
+			/// </summary>
+			Message = 2,
+
+			/// <summary>
+			/// Payload: time in nanoseconds since the epoch (int64), flags (uint32), UTF8 message text (remaining bytes)
+			/// </summary>
+			Text = 3
+		};
 
 		/// <summary>
-		/// Write a message to the log
+		/// Type tag preceding each encoded argument
 		/// </summary>
-		/// <param name="message">The message string; must be zero-terminated. Expected to NOT contain a new line at the end.</param>
-		/// <param name="...params">Additional formatting arguments, if any. Formatting follows the specification of the printf function family.</param>
-		template<typename ...PARAMS>
-		inline void Write(wchar_t const* message, PARAMS&&... params) const
+		enum class ArgType : uint8_t
 		{
-			this->Write(static_cast<uint32_t>(0), message, std::forward<PARAMS>(params)...);
-		}
+			Int32 = 1,
+			UInt32 = 2,
+			Int64 = 3,
+			UInt64 = 4,
+			Double = 5,
+			String = 6, // length (uint32), characters
+			WideString = 7, // length in characters (uint32), characters
+			Pointer = 8 // uint64
+		};
 
 		/// <summary>
-		/// Write a message to the log
+		/// Tests if all argument types can be encoded, i.e. are numbers, enums, strings, or pointers
 		/// </summary>
-		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
-		/// <param name="...params">Additional formatting arguments, if any. Formatting follows the specification of the printf function family.</param>
-		template<typename CHAR, typename TRAITS, typename ...PARAMS>
-		inline void Write(std::basic_string_view<CHAR, TRAITS> const& message, PARAMS&&... params) const
+		template<typename ...ARGS>
+		static constexpr bool AreEncodable() noexcept
 		{
-			this->Write(static_cast<uint32_t>(0), message, std::forward<PARAMS>(params)...);
+			return (isEncodable<std::decay_t<ARGS>>() && ...);
 		}
 
 		/// <summary>
-		/// Write a message to the log
+		/// Encodes the arguments of a printf-based message.
+		/// Strings are copied. Integers and floating point numbers are encoded after the default argument promotions of printf.
 		/// </summary>
-		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
-		/// <param name="...params">Additional formatting arguments, if any. Formatting follows the specification of the printf function family.</param>
-		template<typename CHAR, typename TRAITS, typename ALLOCATOR, typename ...PARAMS>
-		inline void Write(std::basic_string<CHAR, TRAITS, ALLOCATOR> const& message, PARAMS&&... params) const
+		/// <param name="out">Receives the encoded arguments</param>
+		/// <param name="format">The printf format string; determines if character pointers are strings or pointers</param>
+		/// <returns>False if the message cannot be recorded unformatted, i.e. if the format contains `%n`</returns>
+		template<size_t INLINE_CAPACITY, typename ...ARGS>
+		static bool EncodeArgs(MessageBuffer<char, INLINE_CAPACITY>& out, char const* format, ARGS const&... args)
 		{
-			this->Write(static_cast<uint32_t>(0), message, std::forward<PARAMS>(params)...);
+			out.Clear();
+			if constexpr ((std::is_pointer_v<std::decay_t<ARGS>> || ...))
+			{
+				ConversionCursor cursor{ format };
+				return (encodeArg(out, cursor.Next(), args) && ...);
+			}
+			else
+			{
+				(encodeArg(out, args), ...);
+				return true;
+			}
 		}
 
 	private:
 
-		template<uint32_t LEVEL, typename ...PARAMS>
-		inline void Special(uint32_t flags, char const* message, PARAMS&&... params) const
+		/// <summary>
+		/// Walks the conversion specifications of a printf format string, one argument at a time
+		/// </summary>
+		class ConversionCursor
 		{
-			this->Write(LEVEL | (flags & ~ISimpleLog::FlagLevelMask), message, std::forward<PARAMS>(params)...);
-		}
+		public:
+			explicit ConversionCursor(char const* format) noexcept : m_pos{ format } {}
 
-		template<uint32_t LEVEL, typename ...PARAMS>
-		inline void Special(uint32_t flags, wchar_t const* message, PARAMS&&... params) const
-		{
-			this->Write(LEVEL | (flags & ~ISimpleLog::FlagLevelMask), message, std::forward<PARAMS>(params)...);
-		}
+			ConversionCursor(ConversionCursor const&) = delete;
+			ConversionCursor(ConversionCursor&&) = delete;
+			ConversionCursor& operator=(ConversionCursor const&) = delete;
+			ConversionCursor& operator=(ConversionCursor&&) = delete;
 
-		template<uint32_t LEVEL, typename CHAR, typename TRAITS, typename ...PARAMS>
-		inline void Special(uint32_t flags, std::basic_string_view<CHAR, TRAITS> const& message, PARAMS&&... params) const
-		{
-			this->Write(LEVEL | (flags & ~ISimpleLog::FlagLevelMask), message, std::forward<PARAMS>(params)...);
-		}
+			/// <summary>
+			/// Gets the conversion of the next argument; `*` for a width or precision argument, and 0 after the last conversion
+			/// </summary>
+			char Next() noexcept
+			{
+				if (m_stars == 0 && m_conversion == 0) parse();
+				if (m_stars > 0)
+				{
+					--m_stars;
+					return '*';
+				}
+				char const conversion = m_conversion;
+				m_conversion = 0;
+				return conversion;
+			}
 
-		template<uint32_t LEVEL, typename CHAR, typename TRAITS, typename ALLOCATOR, typename ...PARAMS>
-		inline void Special(uint32_t flags, std::basic_string<CHAR, TRAITS, ALLOCATOR> const& message, PARAMS&&... params) const
-		{
-			this->Write(LEVEL | (flags & ~ISimpleLog::FlagLevelMask), message, std::forward<PARAMS>(params)...);
-		}
+		private:
+			char const* m_pos;
+			int m_stars{ 0 };
+			char m_conversion{ 0 };
 
-		template<uint32_t LEVEL, typename ...PARAMS>
-		inline void Special(char const* message, PARAMS&&... params) const
+			void parse() noexcept
+			{
+				while (m_pos != nullptr && *m_pos != 0)
+				{
+					if (*m_pos++ != '%') continue;
+					if (*m_pos == '%')
+					{
+						++m_pos;
+						continue;
+					}
+					// flags, width, precision, and length
+					while (*m_pos != 0 && std::strchr("-+ #0'*.123456789hljztLqIw", *m_pos) != nullptr)
+					{
+						if (*m_pos++ == '*') ++m_stars;
+					}
+					if (*m_pos != 0)
+					{
+						m_conversion = *m_pos++;
+						return;
+					}
+				}
+			}
+		};
+
+		template<typename V>
+		static constexpr bool isEncodable() noexcept
 		{
-			this->Write(LEVEL, message, std::forward<PARAMS>(params)...);
+			return (std::is_arithmetic_v<V> && !std::is_same_v<V, long double>)
+				|| std::is_enum_v<V> || std::is_null_pointer_v<V>
+				|| (std::is_pointer_v<V> && !std::is_function_v<std::remove_pointer_t<V>>);
 		}
 
-		template<uint32_t LEVEL, typename ...PARAMS>
-		inline void Special(wchar_t const* message, PARAMS&&... params) const
+		template<size_t INLINE_CAPACITY, typename T>
+		static inline void put(MessageBuffer<char, INLINE_CAPACITY>& out, T value)
 		{
-			this->Write(LEVEL, message, std::forward<PARAMS>(params)...);
+			out.Append(reinterpret_cast<char const*>(&value), sizeof(T));
 		}
 
-		template<uint32_t LEVEL, typename CHAR, typename TRAITS, typename ...PARAMS>
-		inline void Special(std::basic_string_view<CHAR, TRAITS> const& message, PARAMS&&... params) const
+		template<size_t INLINE_CAPACITY, typename T>
+		static void encodeArg(MessageBuffer<char, INLINE_CAPACITY>& out, T const& value)
 		{
-			this->Write(LEVEL, message, std::forward<PARAMS>(params)...);
+			using V = std::decay_t<T>;
+			if constexpr (std::is_enum_v<V>)
+			{
+				encodeArg(out, static_cast<std::underlying_type_t<V>>(value));
+			}
+			else if constexpr (std::is_floating_point_v<V>)
+			{
+				out.Push(static_cast<char>(ArgType::Double));
+				put(out, static_cast<double>(value));
+			}
+			else if constexpr (std::is_integral_v<V> && sizeof(V) <= sizeof(int32_t))
+			{
+				// default argument promotions
+				if constexpr (std::is_signed_v<V> || sizeof(V) < sizeof(int32_t))
+				{
+					out.Push(static_cast<char>(ArgType::Int32));
+					put(out, static_cast<int32_t>(value));
+				}
+				else
+				{
+					out.Push(static_cast<char>(ArgType::UInt32));
+					put(out, static_cast<uint32_t>(value));
+				}
+			}
+			else if constexpr (std::is_integral_v<V>)
+			{
+				out.Push(static_cast<char>(std::is_signed_v<V> ? ArgType::Int64 : ArgType::UInt64));
+				put(out, static_cast<uint64_t>(value));
+			}
+			else if constexpr (std::is_same_v<V, char const*> || std::is_same_v<V, char*>)
+			{
+				char const* str = (value != nullptr) ? value : "(null)";
+				uint32_t const len = static_cast<uint32_t>(std::strlen(str));
+				out.Push(static_cast<char>(ArgType::String));
+				put(out, len);
+				out.Append(str, len);
+			}
+			else if constexpr (std::is_same_v<V, wchar_t const*> || std::is_same_v<V, wchar_t*>)
+			{
+				wchar_t const* str = (value != nullptr) ? value : L"(null)";
+				uint32_t const len = static_cast<uint32_t>(std::wcslen(str));
+				out.Push(static_cast<char>(ArgType::WideString));
+				put(out, len);
+				out.Append(reinterpret_cast<char const*>(str), len * sizeof(wchar_t));
+			}
+			else
+			{
+				out.Push(static_cast<char>(ArgType::Pointer));
+				put(out, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(static_cast<void const*>(value))));
+			}
 		}
 
-		template<uint32_t LEVEL, typename CHAR, typename TRAITS, typename ALLOCATOR, typename ...PARAMS>
-		inline void Special(std::basic_string<CHAR, TRAITS, ALLOCATOR> const& message, PARAMS&&... params) const
+		/// <summary>
+		/// Encodes an argument according to its conversion; character pointers are only encoded as strings for `%s`
+		/// </summary>
+		/// <returns>False for the pointer of `%n`, which would be written by printf</returns>
+		template<size_t INLINE_CAPACITY, typename T>
+		static bool encodeArg(MessageBuffer<char, INLINE_CAPACITY>& out, char conversion, T const& value)
 		{
-			this->Write(LEVEL, message, std::forward<PARAMS>(params)...);
+			using V = std::decay_t<T>;
+			if constexpr (std::is_pointer_v<V>)
+			{
+				if (conversion == 'n') return false;
+				if constexpr (std::is_same_v<std::remove_cv_t<std::remove_pointer_t<V>>, char>
+					|| std::is_same_v<std::remove_cv_t<std::remove_pointer_t<V>>, wchar_t>)
+				{
+					if (conversion != 's' && conversion != 'S')
+					{
+						out.Push(static_cast<char>(ArgType::Pointer));
+						put(out, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(static_cast<void const*>(value))));
+						return true;
+					}
+				}
+			}
+			encodeArg(out, value);
+			return true;
 		}
+	};
 
+	/// <summary>
+	/// Abstract interface class for writing a message
+	/// </summary>
+	class ISimpleLog
+	{
 	public:
+		/// <summary>
+		/// Major version number constant
+		/// </summary>
+		static constexpr int const VERSION_MAJOR = 3;
 
 		/// <summary>
-		/// Specialization of the Write function. Use the same arguments as with any of the write overloads.
-		/// The log level bits will be overwritten, and the message with be logged as critical error message.
+		/// Minor version number constant
 		/// </summary>
-		template<typename ...PARAMS>
-		inline void Critical(PARAMS&&... params) const
-		{
-			ISimpleLog::Special<ISimpleLog::FlagLevelCritical>(std::forward<PARAMS>(params)...);
-		}
+		static constexpr int const VERSION_MINOR = 3;
 
 		/// <summary>
-		/// Specialization of the Write function. Use the same arguments as with any of the write overloads.
-		/// The log level bits will be overwritten, and the message with be logged as error message.
+		/// Patch version number constant
 		/// </summary>
-		template<typename ...PARAMS>
-		inline void Error(PARAMS&&... params) const
-		{
-			ISimpleLog::Special<ISimpleLog::FlagLevelError>(std::forward<PARAMS>(params)...);
-		}
+		static constexpr int const VERSION_PATCH = 4;
 
 		/// <summary>
-		/// Specialization of the Write function. Use the same arguments as with any of the write overloads.
-		/// The log level bits will be overwritten, and the message with be logged as warning.
+		/// Build version number constant
 		/// </summary>
-		template<typename ...PARAMS>
-		inline void Warning(PARAMS&&... params) const
-		{
-			ISimpleLog::Special<ISimpleLog::FlagLevelWarning>(std::forward<PARAMS>(params)...);
-		}
+		static constexpr int const VERSION_BUILD = 0;
 
 		/// <summary>
-		/// Specialization of the Write function. Use the same arguments as with any of the write overloads.
-		/// The log level bits will be overwritten, and the message with be logged as message.
+		/// Flag message as critical error
 		/// </summary>
-		template<typename ...PARAMS>
-		inline void Message(PARAMS&&... params) const
+		static constexpr uint32_t const FlagLevelCritical = 0x00000007;
+
+		/// <summary>
+		/// Flag message as critical error (deprecated)
+		/// </summary>
+		/// <remarks>Deprecated! Use `FlagLevelCritical` instead</remarks>
+		[[deprecated("Deprecated! Use `FlagLevelCritical` instead")]] 
+		static constexpr uint32_t const FlagLevelCritial = 0x00000007;
+
+		/// <summary>
+		/// Flag message as error
+		/// </summary>
+		static constexpr uint32_t const FlagLevelError = 0x00000005;
+
+		/// <summary>
+		/// Flag message as warning
+		/// </summary>
+		static constexpr uint32_t const FlagLevelWarning = 0x0000003;
+
+		/// <summary>
+		/// Flag message as normal information message
+		/// </summary>
+		static constexpr uint32_t const FlagLevelMessage = 0x0000000;
+
+		/// <summary>
+		/// Flag message as detail information
+		/// </summary>
+		static constexpr uint32_t const FlagLevelDetail = 0x00000001;
+
+		/// <summary>
+		/// Masks the bits of the flags field which are used to specify the message level
+		/// </summary>
+		static constexpr uint32_t const FlagLevelMask = 0x00000007;
+
+		/// <summary>
+		/// Gets the severity rank of the level of a message.
+		/// The rank grows with the importance of the message: detail &lt; message &lt; warning &lt; error &lt; critical.
+		/// </summary>
+		/// <param name="flags">The message flags; only the level bits are evaluated</param>
+		/// <returns>The severity rank, useful to compare message levels</returns>
+		static constexpr uint32_t GetLevelSeverity(uint32_t flags) noexcept
 		{
-			ISimpleLog::Special<ISimpleLog::FlagLevelMessage>(std::forward<PARAMS>(params)...);
+			uint32_t const level = flags & FlagLevelMask;
+			// message and detail are the only levels which are not ordered by their bit values
+			return (level <= FlagLevelDetail) ? (FlagLevelDetail - level) : level;
 		}
 
 		/// <summary>
-		/// Specialization of the Write function. Use the same arguments as with any of the write overloads.
-		/// The log level bits will be overwritten, and the message with be logged as detail message.
+		/// The compile-time minimum message level, set by defining `SIMPLELOG_MIN_LEVEL`
 		/// </summary>
-		template<typename ...PARAMS>
-		inline void Detail(PARAMS&&... params) const
+		static constexpr uint32_t const MinLevel = SIMPLELOG_MIN_LEVEL;
+
+		/// <summary>
+		/// Checks if messages of a level are compiled in, i.e. are at least as severe as `MinLevel`.
+		/// Messages of other levels are discarded without being formatted.
+		/// </summary>
+		/// <param name="flags">The message flags; only the level bits are evaluated</param>
+		/// <returns>True if messages of this level are written</returns>
+		static constexpr bool IsLevelCompiledIn(uint32_t flags) noexcept
 		{
-			ISimpleLog::Special<ISimpleLog::FlagLevelDetail>(std::forward<PARAMS>(params)...);
+			return GetLevelSeverity(flags) >= GetLevelSeverity(MinLevel);
 		}
 
-		ISimpleLog(const ISimpleLog&) = delete;
-		ISimpleLog(ISimpleLog&&) = delete;
-		ISimpleLog& operator=(const ISimpleLog&) = delete;
-		ISimpleLog& operator=(ISimpleLog&&) = delete;
-
 	protected:
-		ISimpleLog() = default;
-		virtual ~ISimpleLog() = default;
-	};
+
+		/// <summary>
+		/// Write a message to the log
+		/// </summary>
+		/// <param name="flags">The message flags</param>
+		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
+		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.</param>
+		virtual void WriteImpl(uint32_t flags, char const* message, size_t messageLength) const = 0;
+
+		/// <summary>
+		/// Write a message to the log
+		/// </summary>
+		/// <param name="flags">The message flags</param>
+		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
+		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.</param>
+		virtual void WriteImpl(uint32_t flags, wchar_t const* message, size_t messageLength) const = 0;
+
+		/// <summary>
+		/// Checks if a message with these flags would be written at all.
+		/// Called before formatting, so it must be cheap, e.g. a single check of an atomic value.
+		/// </summary>
+		/// <param name="flags">The message flags</param>
+		/// <returns>False if the message would be discarded; true otherwise</returns>
+		virtual bool IsEnabledImpl(uint32_t /*flags*/) const
+		{
+			return true;
+		}
+
+		/// <summary>
+		/// Checks if the implementation records printf-based messages unformatted, via `WriteDeferredImpl`
+		/// </summary>
+		virtual bool IsDeferredFormattingImpl() const
+		{
+			return false;
+		}
+
+		/// <summary>
+		/// Writes a printf-based message unformatted; only called if `IsDeferredFormattingImpl` returns true.
+		/// </summary>
+		/// <param name="flags">The message flags</param>
+		/// <param name="format">The printf format string; zero-terminated</param>
+		/// <param name="args">The arguments, encoded by `BinaryLogFormat::EncodeArgs`</param>
+		/// <param name="argsLength">The length of the encoded arguments in bytes</param>
+		/// <returns>False if the message was not handled, and is to be formatted and written as text</returns>
+		virtual bool WriteDeferredImpl(uint32_t /*flags*/, char const* /*format*/, char const* /*args*/, size_t /*argsLength*/) const
+		{
+			return false;
+		}
+
+		/// <summary>
+		/// Utility function to forward the write arguments to the implementation with another object (unknown class of this base).
+		/// </summary>
+		template<typename LOG, typename CHAR>
+		void ForwardWriteImpl(LOG& log, uint32_t flags, CHAR const* message, size_t messageLength) const
+		{
+			log.WriteImpl(flags, message, messageLength);
+		}
+
+		/// <summary>
+		/// Printf-based formatting of a string; must be zero-terminated.
+		/// </summary>
+		template<typename ...PARAMS>
+		static std::string formatString(char const* format, PARAMS&&... params)
+		{
+			MessageBuffer<char> buf;
+			MessageFormatter<char>::Printf(buf, format, std::forward<PARAMS>(params)...);
+			return std::string{ buf.Data(), buf.Size() };
+		}
+
+		/// <summary>
+		/// Printf-based formatting of a wstring; must be zero-terminated.
+		/// </summary>
+		template<typename ...PARAMS>
+		static std::wstring formatString(wchar_t const* format, PARAMS&&... params)
+		{
+			MessageBuffer<wchar_t> buf;
+			MessageFormatter<wchar_t>::Printf(buf, format, std::forward<PARAMS>(params)...);
+			return std::wstring{ buf.Data(), buf.Size() };
+		}
+
+		/// <summary>
+		/// Printf-based formatting into a stack buffer, and writing of the result.
+		/// </summary>
+		template<typename CHAR, typename ...PARAMS>
+		inline void writePrintf(uint32_t flags, CHAR const* format, PARAMS&&... params) const
+		{
+			MessageBuffer<CHAR> buf;
+			MessageFormatter<CHAR>::Printf(buf, format, std::forward<PARAMS>(params)...);
+			this->WriteImpl(flags, buf.CStr(), buf.Size());
+		}
+
+	public:
+
+		/// <summary>
+		/// Checks if a message with these flags would be written at all.
+		/// Use this to skip expensive preparations of messages which would be discarded anyway.
+		/// </summary>
+		/// <param name="flags">The message flags</param>
+		/// <returns>False if the message would be discarded; true otherwise</returns>
+		inline bool IsEnabled(uint32_t flags) const
+		{
+			return IsLevelCompiledIn(flags) && this->IsEnabledImpl(flags);
+		}
+
+		/// <summary>
+		/// Write a message to the log
+		/// </summary>
+		/// <param name="flags">The message flags</param>
+		/// <param name="message">The message string; must be zero-terminated. Expected to NOT contain a new line at the end.</param>
+		inline void Write(uint32_t flags, char const* message) const
+		{
+			if (!IsLevelCompiledIn(flags)) return;
+			this->WriteImpl(flags, message, std::strlen(message));
+		}
+
+		/// <summary>
+		/// Write a message to the log
+		/// </summary>
+		/// <param name="flags">The message flags</param>
+		/// <param name="message">The message string; must be zero-terminated. Expected to NOT contain a new line at the end.</param>
+		inline void Write(uint32_t flags, wchar_t const* message) const
+		{
+			if (!IsLevelCompiledIn(flags)) return;
+			this->WriteImpl(flags, message, std::wcslen(message));
+		}
+
+		/// <summary>
+		/// Write a message to the log
+		/// </summary>
+		/// <param name="flags">The message flags</param>
+		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
+		template<typename CHAR, typename TRAITS>
+		inline void Write(uint32_t flags, std::basic_string_view<CHAR, TRAITS> const& message) const
+		{
+			if (!IsLevelCompiledIn(flags)) return;
+			this->WriteImpl(flags, message.data(), message.length());
+		}
+
+		/// <summary>
+		/// Write a message to the log
+		/// </summary>
+		/// <param name="flags">The message flags</param>
+		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
+		template<typename CHAR, typename TRAITS, typename ALLOCATOR>
+		inline void Write(uint32_t flags, std::basic_string<CHAR, TRAITS, ALLOCATOR> const& message) const
+		{
+			if (!IsLevelCompiledIn(flags)) return;
+			this->WriteImpl(flags, message.data(), message.length());
+		}
+
+		/// <summary>
+		/// Write a message to the log
+		/// </summary>
+		/// <param name="flags">The message flags</param>
+		/// <param name="message">The message string; must be zero-terminated. Expected to NOT contain a new line at the end.
+		/// Formatting follows the specification of the printf function family.</param>
+		/// <param name="p1">The first formatting argument</param>
+		/// <param name="...params">Additional formatting arguments</param>
+		template<typename PARAM1, typename ...PARAMS>
+		inline void Write(uint32_t flags, char const* message, PARAM1&& p1, PARAMS&&... params) const
+		{
+			if (!IsEnabled(flags)) return;
+			if constexpr (BinaryLogFormat::AreEncodable<PARAM1, PARAMS...>())
+			{
+				if (this->IsDeferredFormattingImpl())
+				{
+					MessageBuffer<char> args;
+					if (BinaryLogFormat::EncodeArgs(args, message, p1, params...)
+						&& this->WriteDeferredImpl(flags, message, args.Data(), args.Size()))
+					{
+						return;
+					}
+				}
+			}
+			writePrintf(flags, message, std::forward<PARAM1>(p1), std::forward<PARAMS>(params)...);
+		}
+
+		/// <summary>
+		/// Write a message to the log
+		/// </summary>
+		/// <param name="flags">The message flags</param>
+		/// <param name="message">The message string; must be zero-terminated. Expected to NOT contain a new line at the end.
+		/// Formatting follows the specification of the printf function family.</param>
+		/// <param name="p1">The first formatting argument</param>
+		/// <param name="...params">Additional formatting arguments</param>
+		template<typename PARAM1, typename ...PARAMS>
+		inline void Write(uint32_t flags, wchar_t const* message, PARAM1&& p1, PARAMS&&... params) const
+		{
+			if (!IsEnabled(flags)) return;
+			writePrintf(flags, message, std::forward<PARAM1>(p1), std::forward<PARAMS>(params)...);
+		}
+
+		/// <summary>
+		/// Write a message to the log
+		/// </summary>
+		/// <param name="flags">The message flags</param>
+		/// <param name="message">The message string. Expected to NOT contain a new line at the end.
+		/// Formatting follows the specification of the printf function family.</param>
+		/// <param name="p1">The first formatting argument</param>
+		/// <param name="...params">Additional formatting arguments</param>
+		template<typename CHAR, typename TRAITS, typename PARAM1, typename ...PARAMS>
+		inline void Write(uint32_t flags, std::basic_string_view<CHAR, TRAITS> const& message, PARAM1&& p1, PARAMS&&... params) const
+		{
+			if (!IsEnabled(flags)) return;
+			MessageBuffer<CHAR> format;
+			format.Append(message.data(), message.size());
+			writePrintf(flags, format.CStr(), std::forward<PARAM1>(p1), std::forward<PARAMS>(params)...);
+		}
+
+		/// <summary>
+		/// Write a message to the log
+		/// </summary>
+		/// <param name="flags">The message flags</param>
+		/// <param name="message">The message string. Expected to NOT contain a new line at the end.
+		/// Formatting follows the specification of the printf function family.</param>
+		/// <param name="p1">The first formatting argument</param>
+		/// <param name="...params">Additional formatting arguments</param>
+		template<typename CHAR, typename TRAITS, typename ALLOCATOR, typename PARAM1, typename ...PARAMS>
+		inline void Write(uint32_t flags, std::basic_string<CHAR, TRAITS, ALLOCATOR> const& message, PARAM1&& p1, PARAMS&&... params) const
+		{
+			if (!IsEnabled(flags)) return;
+			writePrintf(flags, message.c_str(), std::forward<PARAM1>(p1), std::forward<PARAMS>(params)...);
+		}
+
+		/// <summary>
+		/// Write a message to the log
+		/// </summary>
+		/// <param name="message">The message string; must be zero-terminated. Expected to NOT contain a new line at the end.</param>
+		/// <param name="...params">Additional formatting arguments, if any. Formatting follows the specification of the printf function family.</param>
+		template<typename ...PARAMS>
+		inline void Write(char const* message, PARAMS&&... params) const
+		{
+			this->Write(static_cast<uint32_t>(0), message, std::forward<PARAMS>(params)...);
+		}
+
+		/// <summary>
+		/// Write a message to the log
+		/// </summary>
+		/// <param name="message">The message string; must be zero-terminated. Expected to NOT contain a new line at the end.</param>
+		/// <param name="...params">Additional formatting arguments, if any. Formatting follows the specification of the printf function family.</param>
+		template<typename ...PARAMS>
+		inline void Write(wchar_t const* message, PARAMS&&... params) const
+		{
+			this->Write(static_cast<uint32_t>(0), message, std::forward<PARAMS>(params)...);
+		}
+
+		/// <summary>
+		/// Write a message to the log
+		/// </summary>
+		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
+		/// <param name="...params">Additional formatting arguments, if any. Formatting follows the specification of the printf function family.</param>
+		template<typename CHAR, typename TRAITS, typename ...PARAMS>
+		inline void Write(std::basic_string_view<CHAR, TRAITS> const& message, PARAMS&&... params) const
+		{
+			this->Write(static_cast<uint32_t>(0), message, std::forward<PARAMS>(params)...);
+		}
+
+		/// <summary>
+		/// Write a message to the log
+		/// </summary>
+		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
+		/// <param name="...params">Additional formatting arguments, if any. Formatting follows the specification of the printf function family.</param>
+		template<typename CHAR, typename TRAITS, typename ALLOCATOR, typename ...PARAMS>
+		inline void Write(std::basic_string<CHAR, TRAITS, ALLOCATOR> const& message, PARAMS&&... params) const
+		{
+			this->Write(static_cast<uint32_t>(0), message, std::forward<PARAMS>(params)...);
+		}
+
+		/// <summary>
+		/// Write a message to the log, with type-safe formatting
+		/// </summary>
+		/// <param name="flags">The message flags</param>
+		/// <param name="format">The message format string. Expected to NOT contain a new line at the end.
+		/// Formatting follows a subset of the std::format specification, e.g. "{}", "{1}", "{:08x}", or "{:.3f}".</param>
+		/// <param name="...args">The formatting arguments</param>
+		/// <remarks>The message is formatted on the stack; only long messages allocate memory.</remarks>
+		template<typename ...ARGS>
+		inline void WriteFormat(uint32_t flags, std::string_view format, ARGS const&... args) const
+		{
+			if (!IsEnabled(flags)) return;
+			MessageBuffer<char> buf;
+			MessageFormatter<char>::Format(buf, format, args...);
+			this->WriteImpl(flags, buf.CStr(), buf.Size());
+		}
+
+		/// <summary>
+		/// Write a message to the log, with type-safe formatting
+		/// </summary>
+		/// <param name="flags">The message flags</param>
+		/// <param name="format">The message format string. Expected to NOT contain a new line at the end.
+		/// Formatting follows a subset of the std::format specification, e.g. "{}", "{1}", "{:08x}", or "{:.3f}".</param>
+		/// <param name="...args">The formatting arguments</param>
+		/// <remarks>The message is formatted on the stack; only long messages allocate memory.</remarks>
+		template<typename ...ARGS>
+		inline void WriteFormat(uint32_t flags, std::wstring_view format, ARGS const&... args) const
+		{
+			if (!IsEnabled(flags)) return;
+			MessageBuffer<wchar_t> buf;
+			MessageFormatter<wchar_t>::Format(buf, format, args...);
+			this->WriteImpl(flags, buf.CStr(), buf.Size());
+		}
+
+	private:
+
+		template<uint32_t LEVEL, typename ...PARAMS>
+		inline void Special(uint32_t flags, char const* message, PARAMS&&... params) const
+		{
+			if constexpr (IsLevelCompiledIn(LEVEL))
+			{
+				this->Write(LEVEL | (flags & ~ISimpleLog::FlagLevelMask), message, std::forward<PARAMS>(params)...);
+			}
+		}
+
+		template<uint32_t LEVEL, typename ...PARAMS>
+		inline void Special(uint32_t flags, wchar_t const* message, PARAMS&&... params) const
+		{
+			if constexpr (IsLevelCompiledIn(LEVEL))
+			{
+				this->Write(LEVEL | (flags & ~ISimpleLog::FlagLevelMask), message, std::forward<PARAMS>(params)...);
+			}
+		}
+
+		template<uint32_t LEVEL, typename CHAR, typename TRAITS, typename ...PARAMS>
+		inline void Special(uint32_t flags, std::basic_string_view<CHAR, TRAITS> const& message, PARAMS&&... params) const
+		{
+			if constexpr (IsLevelCompiledIn(LEVEL))
+			{
+				this->Write(LEVEL | (flags & ~ISimpleLog::FlagLevelMask), message, std::forward<PARAMS>(params)...);
+			}
+		}
+
+		template<uint32_t LEVEL, typename CHAR, typename TRAITS, typename ALLOCATOR, typename ...PARAMS>
+		inline void Special(uint32_t flags, std::basic_string<CHAR, TRAITS, ALLOCATOR> const& message, PARAMS&&... params) const
+		{
+			if constexpr (IsLevelCompiledIn(LEVEL))
+			{
+				this->Write(LEVEL | (flags & ~ISimpleLog::FlagLevelMask), message, std::forward<PARAMS>(params)...);
+			}
+		}
+
+		template<uint32_t LEVEL, typename ...PARAMS>
+		inline void Special(char const* message, PARAMS&&... params) const
+		{
+			if constexpr (IsLevelCompiledIn(LEVEL))
+			{
+				this->Write(LEVEL, message, std::forward<PARAMS>(params)...);
+			}
+		}
+
+		template<uint32_t LEVEL, typename ...PARAMS>
+		inline void Special(wchar_t const* message, PARAMS&&... params) const
+		{
+			if constexpr (IsLevelCompiledIn(LEVEL))
+			{
+				this->Write(LEVEL, message, std::forward<PARAMS>(params)...);
+			}
+		}
+
+		template<uint32_t LEVEL, typename CHAR, typename TRAITS, typename ...PARAMS>
+		inline void Special(std::basic_string_view<CHAR, TRAITS> const& message, PARAMS&&... params) const
+		{
+			if constexpr (IsLevelCompiledIn(LEVEL))
+			{
+				this->Write(LEVEL, message, std::forward<PARAMS>(params)...);
+			}
+		}
+
+		template<uint32_t LEVEL, typename CHAR, typename TRAITS, typename ALLOCATOR, typename ...PARAMS>
+		inline void Special(std::basic_string<CHAR, TRAITS, ALLOCATOR> const& message, PARAMS&&... params) const
+		{
+			if constexpr (IsLevelCompiledIn(LEVEL))
+			{
+				this->Write(LEVEL, message, std::forward<PARAMS>(params)...);
+			}
+		}
+
+	public:
+
+		/// <summary>
+		/// Specialization of the Write function. Use the same arguments as with any of the write overloads.
+		/// The log level bits will be overwritten, and the message with be logged as critical error message.
+		/// </summary>
+		template<typename ...PARAMS>
+		inline void Critical(PARAMS&&... params) const
+		{
+			ISimpleLog::Special<ISimpleLog::FlagLevelCritical>(std::forward<PARAMS>(params)...);
+		}
+
+		/// <summary>
+		/// Specialization of the Write function. Use the same arguments as with any of the write overloads.
+		/// The log level bits will be overwritten, and the message with be logged as error message.
+		/// </summary>
+		template<typename ...PARAMS>
+		inline void Error(PARAMS&&... params) const
+		{
+			ISimpleLog::Special<ISimpleLog::FlagLevelError>(std::forward<PARAMS>(params)...);
+		}
+
+		/// <summary>
+		/// Specialization of the Write function. Use the same arguments as with any of the write overloads.
+		/// The log level bits will be overwritten, and the message with be logged as warning.
+		/// </summary>
+		template<typename ...PARAMS>
+		inline void Warning(PARAMS&&... params) const
+		{
+			ISimpleLog::Special<ISimpleLog::FlagLevelWarning>(std::forward<PARAMS>(params)...);
+		}
+
+		/// <summary>
+		/// Specialization of the Write function. Use the same arguments as with any of the write overloads.
+		/// The log level bits will be overwritten, and the message with be logged as message.
+		/// </summary>
+		template<typename ...PARAMS>
+		inline void Message(PARAMS&&... params) const
+		{
+			ISimpleLog::Special<ISimpleLog::FlagLevelMessage>(std::forward<PARAMS>(params)...);
+		}
+
+		/// <summary>
+		/// Specialization of the Write function. Use the same arguments as with any of the write overloads.
+		/// The log level bits will be overwritten, and the message with be logged as detail message.
+		/// </summary>
+		template<typename ...PARAMS>
+		inline void Detail(PARAMS&&... params) const
+		{
+			ISimpleLog::Special<ISimpleLog::FlagLevelDetail>(std::forward<PARAMS>(params)...);
+		}
+
+		ISimpleLog(const ISimpleLog&) = delete;
+		ISimpleLog(ISimpleLog&&) = delete;
+		ISimpleLog& operator=(const ISimpleLog&) = delete;
+		ISimpleLog& operator=(ISimpleLog&&) = delete;
+
+	protected:
+		ISimpleLog() = default;
+		virtual ~ISimpleLog() = default;
+	};
 
 #ifndef SIMPLELOG_INTERFACE_ONLY
 
-	/// <summary>
-	/// A null implementation of ISimpleLog
-	/// </summary>
-	class NullLog : public ISimpleLog
-	{
-	public:
-		NullLog() = default;
+	/// <summary>
+	/// A null implementation of ISimpleLog
+	/// </summary>
+	class NullLog : public ISimpleLog
+	{
+	public:
+		NullLog() = default;
+
+		NullLog(const NullLog&) = delete;
+		NullLog(NullLog&&) = delete;
+		NullLog& operator=(const NullLog&) = delete;
+		NullLog& operator=(NullLog&&) = delete;
+
+	protected:
+		void WriteImpl(uint32_t /*flags*/, char const* /*message*/, size_t /*messageLength*/) const override
+		{
+			// intentionally empty
+			// omitting all messages
+		}
+		void WriteImpl(uint32_t /*flags*/, wchar_t const* /*message*/, size_t /*messageLength*/) const override
+		{
+			// intentionally empty
+			// omitting all messages
+		}
+		bool IsEnabledImpl(uint32_t /*flags*/) const override
+		{
+			// omitting all messages, so nothing needs to be formatted
+			return false;
+		}
+	};
+
+	/// <summary>
+	/// Snapshot of the runtime statistics of a log, see `GetStats()` of the log implementations.
+	/// All values accumulate from the creation of the log object.
+	/// </summary>
+	struct LogStats
+	{
+		/// <summary>
+		/// Number of messages written, indexed by the level bits of their flags, e.g. `messages[ISimpleLog::FlagLevelWarning]`
+		/// </summary>
+		uint64_t messages[ISimpleLog::FlagLevelMask + 1]{};
+
+		/// <summary>
+		/// Number of bytes written, including time stamps, level tags, and new lines
+		/// </summary>
+		uint64_t bytesWritten{ 0 };
+
+		/// <summary>
+		/// Number of write calls to the operating system, and their total duration
+		/// </summary>
+		uint64_t writeCalls{ 0 };
+		uint64_t writeNanoseconds{ 0 };
+
+		/// <summary>
+		/// Number of flushes to the storage device, and their total duration
+		/// </summary>
+		uint64_t flushCalls{ 0 };
+		uint64_t flushNanoseconds{ 0 };
+
+		/// <summary>
+		/// Number of times a writing thread found the lock of the log taken, and the total time it waited
+		/// </summary>
+		uint64_t lockWaits{ 0 };
+		uint64_t lockWaitNanoseconds{ 0 };
+
+		/// <summary>
+		/// Number of narrow messages which were not ASCII and were converted via the system code page, on Windows
+		/// </summary>
+		uint64_t transcodingFallbacks{ 0 };
+
+		/// <summary>
+		/// Number of messages passed to the log and discarded because of their level, or because they were not to be echoed.
+		/// Messages discarded by the write functions before formatting, after `IsEnabled` returned false, are not counted.
+		/// </summary>
+		uint64_t suppressedMessages{ 0 };
+
+		/// <summary>
+		/// Number of messages lost, e.g. because the log file could not be opened
+		/// </summary>
+		uint64_t droppedMessages{ 0 };
+
+		/// <summary>
+		/// Gets the number of messages written of all levels
+		/// </summary>
+		uint64_t TotalMessages() const noexcept
+		{
+			uint64_t total = 0;
+			for (uint64_t m : messages) total += m;
+			return total;
+		}
+	};
+
+	/// <summary>
+	/// The counters of `LogStats`, updated by the log implementations with relaxed atomic operations
+	/// </summary>
+	class LogStatsCounters
+	{
+	public:
+		LogStatsCounters() = default;
+
+		LogStatsCounters(const LogStatsCounters&) = delete;
+		LogStatsCounters(LogStatsCounters&&) = delete;
+		LogStatsCounters& operator=(const LogStatsCounters&) = delete;
+		LogStatsCounters& operator=(LogStatsCounters&&) = delete;
+
+		inline void CountMessage(uint32_t flags) noexcept { add(m_messages[flags & ISimpleLog::FlagLevelMask], 1); }
+		inline void CountBytes(size_t bytes) noexcept { add(m_bytesWritten, bytes); }
+		inline void CountWrite(std::chrono::steady_clock::duration duration) noexcept { add(m_writeCalls, 1); add(m_writeNanoseconds, nanoseconds(duration)); }
+		inline void CountFlush(std::chrono::steady_clock::duration duration) noexcept { add(m_flushCalls, 1); add(m_flushNanoseconds, nanoseconds(duration)); }
+		inline void CountLockWait(std::chrono::steady_clock::duration duration) noexcept { add(m_lockWaits, 1); add(m_lockWaitNanoseconds, nanoseconds(duration)); }
+		inline void CountTranscodingFallback() noexcept { add(m_transcodingFallbacks, 1); }
+		inline void CountSuppressed() noexcept { add(m_suppressedMessages, 1); }
+		inline void CountDropped() noexcept { add(m_droppedMessages, 1); }
+
+		/// <summary>
+		/// Locks `mutex`, and only measures the time if the lock is taken by another thread
+		/// </summary>
+		inline std::unique_lock<std::mutex> Lock(std::mutex& mutex)
+		{
+			std::unique_lock<std::mutex> lock{ mutex, std::try_to_lock };
+			if (!lock.owns_lock())
+			{
+				auto const start = std::chrono::steady_clock::now();
+				lock.lock();
+				CountLockWait(std::chrono::steady_clock::now() - start);
+			}
+			return lock;
+		}
+
+		LogStats Snapshot() const noexcept
+		{
+			LogStats stats;
+			for (size_t i = 0; i <= ISimpleLog::FlagLevelMask; ++i)
+			{
+				stats.messages[i] = m_messages[i].load(std::memory_order_relaxed);
+			}
+			stats.bytesWritten = m_bytesWritten.load(std::memory_order_relaxed);
+			stats.writeCalls = m_writeCalls.load(std::memory_order_relaxed);
+			stats.writeNanoseconds = m_writeNanoseconds.load(std::memory_order_relaxed);
+			stats.flushCalls = m_flushCalls.load(std::memory_order_relaxed);
+			stats.flushNanoseconds = m_flushNanoseconds.load(std::memory_order_relaxed);
+			stats.lockWaits = m_lockWaits.load(std::memory_order_relaxed);
+			stats.lockWaitNanoseconds = m_lockWaitNanoseconds.load(std::memory_order_relaxed);
+			stats.transcodingFallbacks = m_transcodingFallbacks.load(std::memory_order_relaxed);
+			stats.suppressedMessages = m_suppressedMessages.load(std::memory_order_relaxed);
+			stats.droppedMessages = m_droppedMessages.load(std::memory_order_relaxed);
+			return stats;
+		}
+
+	private:
+		static inline void add(std::atomic<uint64_t>& counter, uint64_t value) noexcept
+		{
+			counter.fetch_add(value, std::memory_order_relaxed);
+		}
+
+		static inline uint64_t nanoseconds(std::chrono::steady_clock::duration duration) noexcept
+		{
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+		}
+
+		std::atomic<uint64_t> m_messages[ISimpleLog::FlagLevelMask + 1]{};
+		std::atomic<uint64_t> m_bytesWritten{ 0 };
+		std::atomic<uint64_t> m_writeCalls{ 0 };
+		std::atomic<uint64_t> m_writeNanoseconds{ 0 };
+		std::atomic<uint64_t> m_flushCalls{ 0 };
+		std::atomic<uint64_t> m_flushNanoseconds{ 0 };
+		std::atomic<uint64_t> m_lockWaits{ 0 };
+		std::atomic<uint64_t> m_lockWaitNanoseconds{ 0 };
+		std::atomic<uint64_t> m_transcodingFallbacks{ 0 };
+		// written by threads of suppressed messages, which otherwise do not touch the log state
+		alignas(64) std::atomic<uint64_t> m_suppressedMessages{ 0 };
+		std::atomic<uint64_t> m_droppedMessages{ 0 };
+	};
+
+	/// <summary>
+	/// Utility functions to convert message strings to UTF8, used by the log implementations
+	/// </summary>
+	class Utf8Encoding
+	{
+	public:
+		Utf8Encoding() = delete;
+
+		/// <summary>
+		/// Converts a wide string to UTF8.
+		/// Invalid code units are replaced by the unicode replacement character.
+		/// </summary>
+		/// <param name="outUtf8">Receives the UTF8 string. The object is reused to avoid reallocations.</param>
+		/// <param name="str">The wide string. Does not need to be zero-terminated.</param>
+		/// <param name="len">The length of the wide string in characters</param>
+		static inline void FromWide(std::string& outUtf8, wchar_t const* str, size_t len)
+		{
+			outUtf8.clear();
+			AppendFromWide(outUtf8, str, len);
+		}
+
+		/// <summary>
+		/// Converts a wide string to UTF8, and appends it.
+		/// Invalid code units are replaced by the unicode replacement character.
+		/// </summary>
+		/// <param name="outUtf8">The UTF8 string to append to</param>
+		/// <param name="str">The wide string. Does not need to be zero-terminated.</param>
+		/// <param name="len">The length of the wide string in characters</param>
+		static void AppendFromWide(std::string& outUtf8, wchar_t const* str, size_t len)
+		{
+			// 16 bit code units encode to at most 3 bytes, or a pair of them to 4 bytes. 32 bit code units encode to at most 4 bytes.
+			size_t o = outUtf8.size();
+			outUtf8.resize(o + len * ((sizeof(wchar_t) == 2) ? 3 : 4));
+			char* out = outUtf8.data();
+			size_t i = 0;
+			while (i < len)
+			{
+				// runs of 7 bit characters are copied by the vectorized kernel
+				size_t const ascii = copyAsciiBlocks(out + o, str + i, len - i);
+				i += ascii;
+				o += ascii;
+
+				// the scalar encoder processes at least one block, before the vectorized kernel is tried again
+				size_t const end = std::min(len, i + wideBlockSize);
+				for (; i < end; ++i)
+				{
+					uint32_t c = static_cast<uint32_t>(str[i]);
+					if constexpr (sizeof(wchar_t) == 2)
+					{
+						c &= 0xffff;
+						if (c >= 0xd800 && c <= 0xdbff && i + 1 < len)
+						{
+							uint32_t const c2 = static_cast<uint32_t>(str[i + 1]) & 0xffff;
+							if (c2 >= 0xdc00 && c2 <= 0xdfff)
+							{
+								c = 0x10000 + ((c - 0xd800) << 10) + (c2 - 0xdc00);
+								++i;
+							}
+						}
+					}
+					if ((c >= 0xd800 && c <= 0xdfff) || c > 0x10ffff)
+					{
+						c = 0xfffd;
+					}
+					o += EncodeCodePoint(out + o, c);
+				}
+			}
+			outUtf8.resize(o);
+		}
+
+		/// <summary>
+		/// Gets the number of leading 7 bit ASCII characters
+		/// </summary>
+		/// <param name="str">The string. Does not need to be zero-terminated.</param>
+		/// <param name="len">The length of the string in bytes</param>
+		/// <returns>The index of the first byte which is not 7 bit ASCII, or `len` if all are</returns>
+		static size_t AsciiPrefixLength(char const* str, size_t len) noexcept
+		{
+			size_t i = 0;
+#if defined(SIMPLELOG_AVX2)
+			for (; i + 32 <= len; i += 32)
+			{
+				__m256i const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(str + i));
+				if (_mm256_movemask_epi8(v) != 0) break;
+			}
+#endif
+#if defined(SIMPLELOG_SSE2)
+			for (; i + 16 <= len; i += 16)
+			{
+				__m128i const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(str + i));
+				if (_mm_movemask_epi8(v) != 0) break;
+			}
+#endif
+			for (; i + 8 <= len; i += 8)
+			{
+				uint64_t w;
+				std::memcpy(&w, str + i, 8);
+				if ((w & 0x8080808080808080ull) != 0) break;
+			}
+			for (; i < len; ++i)
+			{
+				if (static_cast<unsigned char>(str[i]) >= 0x80) break;
+			}
+			return i;
+		}
+
+		/// <summary>
+		/// Tests if all characters are 7 bit ASCII
+		/// </summary>
+		static inline bool IsAscii(char const* str, size_t len) noexcept
+		{
+			return AsciiPrefixLength(str, len) == len;
+		}
+
+		/// <summary>
+		/// Writes the UTF8 encoding of one valid unicode code point
+		/// </summary>
+		/// <param name="out">Receives the encoded bytes; must have room for four bytes</param>
+		/// <param name="c">The unicode code point</param>
+		/// <returns>The number of bytes written</returns>
+		static inline size_t EncodeCodePoint(char* out, uint32_t c) noexcept
+		{
+			if (c < 0x80)
+			{
+				out[0] = static_cast<char>(c);
+				return 1;
+			}
+			if (c < 0x800)
+			{
+				out[0] = static_cast<char>(0xc0 | (c >> 6));
+				out[1] = static_cast<char>(0x80 | (c & 0x3f));
+				return 2;
+			}
+			if (c < 0x10000)
+			{
+				out[0] = static_cast<char>(0xe0 | (c >> 12));
+				out[1] = static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+				out[2] = static_cast<char>(0x80 | (c & 0x3f));
+				return 3;
+			}
+			out[0] = static_cast<char>(0xf0 | (c >> 18));
+			out[1] = static_cast<char>(0x80 | ((c >> 12) & 0x3f));
+			out[2] = static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+			out[3] = static_cast<char>(0x80 | (c & 0x3f));
+			return 4;
+		}
+
+	private:
+
+		/// <summary>
+		/// Number of wide characters processed by one iteration of the vectorized kernels
+		/// </summary>
+#if defined(SIMPLELOG_AVX2)
+		static constexpr size_t const wideBlockSize = 32;
+#else
+		static constexpr size_t const wideBlockSize = 16;
+#endif
+
+		/// <summary>
+		/// Copies leading blocks of 7 bit ASCII wide characters as bytes
+		/// </summary>
+		/// <returns>The number of characters copied; a multiple of the block size</returns>
+		static size_t copyAsciiBlocks(char* out, wchar_t const* str, size_t len) noexcept
+		{
+			size_t i = 0;
+#if defined(SIMPLELOG_AVX2)
+			if constexpr (sizeof(wchar_t) == 2)
+			{
+				__m256i const nonAscii = _mm256_set1_epi16(static_cast<short>(0xff80));
+				for (; i + 32 <= len; i += 32)
+				{
+					__m256i const a = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(str + i));
+					__m256i const b = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(str + i + 16));
+					if (!_mm256_testz_si256(_mm256_or_si256(a, b), nonAscii)) break;
+					// packing works per 128 bit lane; the permutation restores the character order
+					__m256i const bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xd8);
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), bytes);
+				}
+			}
+			else
+			{
+				__m256i const nonAscii = _mm256_set1_epi32(static_cast<int>(0xffffff80));
+				__m256i const order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+				for (; i + 32 <= len; i += 32)
+				{
+					__m256i const a = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(str + i));
+					__m256i const b = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(str + i + 8));
+					__m256i const c = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(str + i + 16));
+					__m256i const d = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(str + i + 24));
+					if (!_mm256_testz_si256(_mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d)), nonAscii)) break;
+					__m256i const bytes = _mm256_packus_epi16(_mm256_packs_epi32(a, b), _mm256_packs_epi32(c, d));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permutevar8x32_epi32(bytes, order));
+				}
+			}
+#elif defined(SIMPLELOG_SSE2)
+			__m128i const zero = _mm_setzero_si128();
+			if constexpr (sizeof(wchar_t) == 2)
+			{
+				__m128i const nonAscii = _mm_set1_epi16(static_cast<short>(0xff80));
+				for (; i + 16 <= len; i += 16)
+				{
+					__m128i const a = _mm_loadu_si128(reinterpret_cast<__m128i const*>(str + i));
+					__m128i const b = _mm_loadu_si128(reinterpret_cast<__m128i const*>(str + i + 8));
+					__m128i const test = _mm_and_si128(_mm_or_si128(a, b), nonAscii);
+					if (_mm_movemask_epi8(_mm_cmpeq_epi8(test, zero)) != 0xffff) break;
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(a, b));
+				}
+			}
+			else
+			{
+				__m128i const nonAscii = _mm_set1_epi32(static_cast<int>(0xffffff80));
+				for (; i + 16 <= len; i += 16)
+				{
+					__m128i const a = _mm_loadu_si128(reinterpret_cast<__m128i const*>(str + i));
+					__m128i const b = _mm_loadu_si128(reinterpret_cast<__m128i const*>(str + i + 4));
+					__m128i const c = _mm_loadu_si128(reinterpret_cast<__m128i const*>(str + i + 8));
+					__m128i const d = _mm_loadu_si128(reinterpret_cast<__m128i const*>(str + i + 12));
+					__m128i const test = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), nonAscii);
+					if (_mm_movemask_epi8(_mm_cmpeq_epi8(test, zero)) != 0xffff) break;
+					__m128i const bytes = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), bytes);
+				}
+			}
+#else
+			for (; i + wideBlockSize <= len; i += wideBlockSize)
+			{
+				uint32_t any = 0;
+				for (size_t j = 0; j < wideBlockSize; ++j)
+				{
+					any |= static_cast<uint32_t>(str[i + j]);
+				}
+				if (any >= 0x80) break;
+				for (size_t j = 0; j < wideBlockSize; ++j)
+				{
+					out[i + j] = static_cast<char>(str[i + j]);
+				}
+			}
+#endif
+			return i;
+		}
+	};
+
+	/// <summary>
+	/// Formats time stamps for log lines, e.g. "2024-06-30 14:05:09Z" or "2024-06-30 14:05:09.123456Z"
+	/// </summary>
+	/// <remarks>
+	/// The formatted date and time prefix is cached. Calendar functions are only called when the minute changes;
+	/// within a minute only the digits of the seconds and of the fraction are patched in.
+	/// Formatting does not allocate memory.
+	/// An object is not thread-safe; each thread or log must use its own object or synchronize the calls.
+	/// </remarks>
+	class TimeStampFormatter
+	{
+	public:
+
+		/// <summary>
+		/// The resolution of formatted time stamps
+		/// </summary>
+		enum class Precision
+		{
+			Seconds,
+			Milliseconds,
+			Microseconds
+		};
+
+		/// <summary>
+		/// The maximum number of characters written by `Format`, i.e. "YYYY-MM-DD hh:mm:ss.ffffffZ"
+		/// </summary>
+		static constexpr size_t const MaxLength = 27;
+
+		/// <summary>
+		/// Creates a formatter
+		/// </summary>
+		/// <param name="utc">If true, the time stamps are in UTC; otherwise in local time</param>
+		/// <param name="precision">The resolution of the time stamps</param>
+		/// <remarks>
+		/// Local time stamps also end with "Z" to stay compatible with existing log files and parsers.
+		/// </remarks>
+		explicit TimeStampFormatter(bool utc = false, Precision precision = Precision::Seconds) noexcept
+			: m_utc{ utc }, m_precision{ precision }
+		{
+		}
+
+		inline bool GetUtc() const noexcept { return m_utc; }
+
+		inline void SetUtc(bool utc) noexcept
+		{
+			if (m_utc == utc) return;
+			m_utc = utc;
+			m_cachedMinute = invalidTime;
+			m_cachedSecond = invalidTime;
+		}
+
+		inline Precision GetPrecision() const noexcept { return m_precision; }
+
+		inline void SetPrecision(Precision precision) noexcept { m_precision = precision; }
+
+		/// <summary>
+		/// Formats the time stamp of the current time
+		/// </summary>
+		/// <param name="out">Receives the time stamp; must have room for `MaxLength` characters. No terminating zero is written.</param>
+		/// <returns>The number of characters written</returns>
+		inline size_t Format(char* out) noexcept
+		{
+			return Format(out, std::chrono::system_clock::now());
+		}
+
+		/// <summary>
+		/// Formats a time stamp
+		/// </summary>
+		/// <param name="out">Receives the time stamp; must have room for `MaxLength` characters. No terminating zero is written.</param>
+		/// <param name="time">The time to format</param>
+		/// <returns>The number of characters written</returns>
+		size_t Format(char* out, std::chrono::system_clock::time_point time) noexcept
+		{
+			int64_t const micros = std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+			int64_t second = micros / 1000000;
+			int64_t fraction = micros % 1000000;
+			if (fraction < 0)
+			{
+				fraction += 1000000;
+				--second;
+			}
+
+			if (second != m_cachedSecond)
+			{
+				int64_t const minute = (second >= 0) ? (second / 60) : ((second - 59) / 60);
+				if (minute != m_cachedMinute)
+				{
+					updateMinute(static_cast<time_t>(minute * 60));
+					m_cachedMinute = minute;
+				}
+				// time zone offsets are whole minutes, so the seconds are the same in local time
+				putTwoDigits(m_prefix + 17, static_cast<uint32_t>(second - minute * 60));
+				m_cachedSecond = second;
+			}
+
+			memcpy(out, m_prefix, prefixLength);
+			size_t len = prefixLength;
+			if (m_precision == Precision::Milliseconds)
+			{
+				uint32_t const ms = static_cast<uint32_t>(fraction / 1000);
+				out[len++] = '.';
+				out[len++] = static_cast<char>('0' + ms / 100);
+				putTwoDigits(out + len, ms % 100);
+				len += 2;
+			}
+			else if (m_precision == Precision::Microseconds)
+			{
+				uint32_t const us = static_cast<uint32_t>(fraction);
+				out[len++] = '.';
+				putTwoDigits(out + len, us / 10000);
+				putTwoDigits(out + len + 2, (us / 100) % 100);
+				putTwoDigits(out + len + 4, us % 100);
+				len += 6;
+			}
+			out[len++] = 'Z';
+			return len;
+		}
+
+	private:
+
+		static constexpr int64_t const invalidTime = std::numeric_limits<int64_t>::min();
+
+		/// <summary>
+		/// Length of "YYYY-MM-DD hh:mm:ss"
+		/// </summary>
+		static constexpr size_t const prefixLength = 19;
+
+		static inline void putTwoDigits(char* out, uint32_t value) noexcept
+		{
+			static constexpr char const digits[] =
+				"00010203040506070809"
+				"10111213141516171819"
+				"20212223242526272829"
+				"30313233343536373839"
+				"40414243444546474849"
+				"50515253545556575859"
+				"60616263646566676869"
+				"70717273747576777879"
+				"80818283848586878889"
+				"90919293949596979899";
+			memcpy(out, digits + (value % 100) * 2, 2);
+		}
+
+		/// <summary>
+		/// Formats the date, hours, and minutes into the cached prefix
+		/// </summary>
+		void updateMinute(time_t t) noexcept
+		{
+			struct tm now {};
+#if defined(SIMPLELOG_WINDOWS)
+			if (m_utc) gmtime_s(&now, &t); else localtime_s(&now, &t);
+#else
+			if (m_utc) gmtime_r(&t, &now); else localtime_r(&t, &now);
+#endif
+			uint32_t const year = static_cast<uint32_t>(now.tm_year + 1900);
+			putTwoDigits(m_prefix, year / 100);
+			putTwoDigits(m_prefix + 2, year % 100);
+			m_prefix[4] = '-';
+			putTwoDigits(m_prefix + 5, static_cast<uint32_t>(now.tm_mon + 1));
+			m_prefix[7] = '-';
+			putTwoDigits(m_prefix + 8, static_cast<uint32_t>(now.tm_mday));
+			m_prefix[10] = ' ';
+			putTwoDigits(m_prefix + 11, static_cast<uint32_t>(now.tm_hour));
+			m_prefix[13] = ':';
+			putTwoDigits(m_prefix + 14, static_cast<uint32_t>(now.tm_min));
+			m_prefix[16] = ':';
+		}
+
+		bool m_utc;
+		Precision m_precision;
+		int64_t m_cachedMinute{ invalidTime };
+		int64_t m_cachedSecond{ invalidTime };
+		char m_prefix[prefixLength]{};
+	};
+
+	/// <summary>
+	/// Appends to a file through memory-mapped segments, used by SimpleLog in memory-mapped mode
+	/// </summary>
+	/// <remarks>
+	/// The file is extended and mapped in segments of fixed size.
+	/// Writers reserve space with an atomic fetch-add, and copy their data directly into the mapped memory.
+	/// A lock is only taken to map or unmap a segment, i.e. once per segment.
+	/// The segment following the one currently being written is mapped ahead of time.
+	/// The file contains zero bytes after the written data, until `Close` trims it.
+	/// </remarks>
+	class MappedLogFile
+	{
+	public:
+#if defined(SIMPLELOG_WINDOWS)
+		using file_t = HANDLE;
+#else
+		using file_t = int;
+#endif
+
+		static constexpr size_t const DefaultSegmentSize = 4 * 1024 * 1024;
+
+		/// <summary>
+		/// Starts appending to a file
+		/// </summary>
+		/// <param name="file">The file, opened for reading and writing. The object does not take ownership.</param>
+		/// <param name="segmentSize">The size of the mapped segments in bytes; rounded up to the mapping granularity of the system</param>
+		MappedLogFile(file_t file, size_t segmentSize)
+			: m_file{ file }
+		{
+#if defined(SIMPLELOG_WINDOWS)
+			SYSTEM_INFO info;
+			GetSystemInfo(&info);
+			size_t const granularity = static_cast<size_t>(info.dwAllocationGranularity);
+			LARGE_INTEGER size;
+			if (!GetFileSizeEx(m_file, &size))
+			{
+				throw std::runtime_error("Failed to get log file size");
+			}
+			m_fileSize = static_cast<uint64_t>(size.QuadPart);
+#else
+			long const pageSize = ::sysconf(_SC_PAGESIZE);
+			size_t const granularity = (pageSize > 0) ? static_cast<size_t>(pageSize) : 4096;
+			struct stat st;
+			if (::fstat(m_file, &st) != 0)
+			{
+				throw std::runtime_error("Failed to get log file size");
+			}
+			m_fileSize = static_cast<uint64_t>(st.st_size);
+#endif
+			m_segmentSize = std::max<size_t>(1, (segmentSize + granularity - 1) / granularity) * granularity;
+
+			// existing content is kept; new data is appended after it
+			m_offset.store(m_fileSize, std::memory_order_relaxed);
+			uint64_t const first = m_fileSize / m_segmentSize;
+			std::lock_guard<std::mutex> lock{ m_mapLock };
+			if (mapSegmentUnderLock(first) == nullptr)
+			{
+				throw std::runtime_error("Failed to map log file");
+			}
+			// bytes before the start offset are never reserved, but count as written to complete the segment
+			size_t const existing = static_cast<size_t>(m_fileSize % m_segmentSize);
+			if (existing > 0)
+			{
+				m_slots[first % SlotCount].written.store(existing, std::memory_order_relaxed);
+			}
+			mapSegmentUnderLock(first + 1);
+		}
+
+		MappedLogFile(const MappedLogFile&) = delete;
+		MappedLogFile(MappedLogFile&&) = delete;
+		MappedLogFile& operator=(const MappedLogFile&) = delete;
+		MappedLogFile& operator=(MappedLogFile&&) = delete;
+
+		~MappedLogFile()
+		{
+			try
+			{
+				Close();
+			}
+			catch (...) {}
+		}
+
+		/// <summary>
+		/// Gets the size of the mapped segments in bytes
+		/// </summary>
+		inline size_t GetSegmentSize() const noexcept
+		{
+			return m_segmentSize;
+		}
+
+		/// <summary>
+		/// Gets the size of the file content, including space reserved by writers which are still copying their data
+		/// </summary>
+		inline uint64_t GetSize() const noexcept
+		{
+			return m_offset.load(std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		/// Gets the number of bytes lost because their segment could not be mapped
+		/// </summary>
+		inline uint64_t GetLostBytes() const noexcept
+		{
+			return m_lostBytes.load(std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		/// Appends data to the file; thread-safe
+		/// </summary>
+		/// <param name="data">The data</param>
+		/// <param name="len">The length of the data in bytes</param>
+		/// <returns>False if data was lost, see remarks</returns>
+		/// <remarks>
+		/// Data is dropped if the file cannot be extended or mapped, e.g. because the storage device is full.
+		/// The file then holds zero bytes in place of the whole segment.
+		/// </remarks>
+		bool Append(char const* data, size_t len)
+		{
+			bool complete = true;
+			uint64_t pos = m_offset.fetch_add(len, std::memory_order_relaxed);
+			while (len > 0)
+			{
+				uint64_t const index = pos / m_segmentSize;
+				size_t const inSegment = static_cast<size_t>(pos % m_segmentSize);
+				size_t const chunk = std::min(len, m_segmentSize - inSegment);
+
+				Segment& segment = m_slots[index % SlotCount];
+				char* base = (segment.index.load(std::memory_order_acquire) == index + 1)
+					? segment.base.load(std::memory_order_relaxed)
+					: acquireSegment(index);
+				if (base != nullptr)
+				{
+					std::memcpy(base + inSegment, data, chunk);
+				}
+				else
+				{
+					m_lostBytes.fetch_add(chunk, std::memory_order_relaxed);
+					complete = false;
+				}
+				// chunks of segments which failed to map are counted as well, so the slot gets released
+				if (segment.index.load(std::memory_order_acquire) == index + 1
+					&& segment.written.fetch_add(chunk, std::memory_order_acq_rel) + chunk == m_segmentSize)
+				{
+					// all bytes of the segment are written
+					releaseSegment(index);
+				}
+				if (inSegment == 0)
+				{
+					// exactly one writer starts each segment, and maps the next one ahead
+					prepareSegment(index + 1);
+				}
+
+				pos += chunk;
+				data += chunk;
+				len -= chunk;
+			}
+			return complete;
+		}
+
+		/// <summary>
+		/// Writes the mapped memory to the storage device
+		/// </summary>
+		void Flush()
+		{
+			std::lock_guard<std::mutex> lock{ m_mapLock };
+			for (Segment& segment : m_slots)
+			{
+				char* base = segment.base.load(std::memory_order_relaxed);
+				if (base == nullptr) continue;
+#if defined(SIMPLELOG_WINDOWS)
+				FlushViewOfFile(base, m_segmentSize);
+#else
+				::msync(base, m_segmentSize, MS_SYNC);
+#endif
+			}
+#if defined(SIMPLELOG_WINDOWS)
+			FlushFileBuffers(m_file);
+#endif
+		}
+
+		/// <summary>
+		/// Unmaps all segments and trims the file to its content.
+		/// No `Append` call may be running or follow.
+		/// </summary>
+		void Close()
+		{
+			std::lock_guard<std::mutex> lock{ m_mapLock };
+			if (m_closed) return;
+			m_closed = true;
+			for (Segment& segment : m_slots)
+			{
+				unmapUnderLock(segment);
+			}
+			uint64_t const size = m_offset.load(std::memory_order_relaxed);
+#if defined(SIMPLELOG_WINDOWS)
+			LARGE_INTEGER li;
+			li.QuadPart = static_cast<LONGLONG>(size);
+			if (SetFilePointerEx(m_file, li, nullptr, FILE_BEGIN))
+			{
+				SetEndOfFile(m_file);
+			}
+			FlushFileBuffers(m_file);
+#else
+			while (::ftruncate(m_file, static_cast<off_t>(size)) != 0 && errno == EINTR) {}
+#if defined(__APPLE__)
+			::fsync(m_file);
+#else
+			::fdatasync(m_file);
+#endif
+#endif
+			m_fileSize = size;
+		}
+
+	private:
+
+		/// <summary>
+		/// A mapped segment. Segment `index` uses slot `index % SlotCount`.
+		/// </summary>
+		struct Segment
+		{
+			/// <summary>
+			/// The segment index plus one, or zero if the slot is not mapped
+			/// </summary>
+			std::atomic<uint64_t> index{ 0 };
+			std::atomic<char*> base{ nullptr };
+
+			/// <summary>
+			/// The number of bytes written; the segment is unmapped when all bytes are written
+			/// </summary>
+			std::atomic<size_t> written{ 0 };
+#if defined(SIMPLELOG_WINDOWS)
+			HANDLE mapping{ NULL };
+#endif
+		};
+
+		static constexpr size_t const SlotCount = 4;
+
+		file_t m_file;
+		size_t m_segmentSize{ DefaultSegmentSize };
+		std::atomic<uint64_t> m_offset{ 0 };
+		std::atomic<uint64_t> m_lostBytes{ 0 };
+		Segment m_slots[SlotCount];
+
+		/// <summary>
+		/// Lock to map and unmap segments; all following members are only used under this lock
+		/// </summary>
+		std::mutex m_mapLock;
+		uint64_t m_fileSize{ 0 };
+		bool m_closed{ false };
+
+		/// <summary>
+		/// Gets the mapping of a segment, mapping it if needed
+		/// </summary>
+		/// <returns>The mapped memory, or nullptr if the segment cannot be mapped</returns>
+		/// <remarks>
+		/// A segment which cannot be mapped occupies its slot without memory, until all its bytes are counted as written.
+		/// Writers do not retry to map it, as the bytes skipped before could not be counted otherwise.
+		/// </remarks>
+		char* acquireSegment(uint64_t index)
+		{
+			for (;;)
+			{
+				{
+					std::lock_guard<std::mutex> lock{ m_mapLock };
+					if (m_closed) return nullptr;
+					Segment& segment = m_slots[index % SlotCount];
+					uint64_t const current = segment.index.load(std::memory_order_relaxed);
+					if (current == index + 1) return segment.base.load(std::memory_order_relaxed);
+					if (current == 0)
+					{
+						char* base = mapSegmentUnderLock(index);
+						if (base == nullptr)
+						{
+							segment.written.store(0, std::memory_order_relaxed);
+							segment.index.store(index + 1, std::memory_order_release);
+						}
+						return base;
+					}
+					if (current > index + 1) return nullptr;
+				}
+				// the slot still holds an older segment, with writers copying their data
+				std::this_thread::yield();
+			}
+		}
+
+		/// <summary>
+		/// Maps a segment ahead of time, if its slot is free
+		/// </summary>
+		void prepareSegment(uint64_t index)
+		{
+			std::lock_guard<std::mutex> lock{ m_mapLock };
+			if (m_closed) return;
+			// the calling writer might have been delayed, while others already wrote and unmapped the whole segment
+			if (m_offset.load(std::memory_order_relaxed) >= (index + 1) * m_segmentSize) return;
+			if (m_slots[index % SlotCount].index.load(std::memory_order_relaxed) == 0)
+			{
+				mapSegmentUnderLock(index);
+			}
+		}
+
+		void releaseSegment(uint64_t index)
+		{
+			std::lock_guard<std::mutex> lock{ m_mapLock };
+			Segment& segment = m_slots[index % SlotCount];
+			if (segment.index.load(std::memory_order_relaxed) == index + 1)
+			{
+				unmapUnderLock(segment);
+			}
+		}
+
+		char* mapSegmentUnderLock(uint64_t index)
+		{
+			Segment& segment = m_slots[index % SlotCount];
+			uint64_t const offset = index * m_segmentSize;
+			uint64_t const end = offset + m_segmentSize;
+			char* base = nullptr;
+#if defined(SIMPLELOG_WINDOWS)
+			if (m_fileSize < end)
+			{
+				LARGE_INTEGER li;
+				li.QuadPart = static_cast<LONGLONG>(end);
+				if (!SetFilePointerEx(m_file, li, nullptr, FILE_BEGIN) || !SetEndOfFile(m_file)) return nullptr;
+				m_fileSize = end;
+			}
+			HANDLE mapping = CreateFileMappingW(m_file, nullptr, PAGE_READWRITE, static_cast<DWORD>(end >> 32), static_cast<DWORD>(end), nullptr);
+			if (mapping == NULL) return nullptr;
+			base = static_cast<char*>(MapViewOfFile(mapping, FILE_MAP_WRITE, static_cast<DWORD>(offset >> 32), static_cast<DWORD>(offset), m_segmentSize));
+			if (base == nullptr)
+			{
+				::CloseHandle(mapping);
+				return nullptr;
+			}
+			segment.mapping = mapping;
+#else
+			if (m_fileSize < end)
+			{
+				// allocate the storage, so writing to the mapped memory cannot fail when the storage device is full
+#if defined(__linux__)
+				int const err = ::posix_fallocate(m_file, static_cast<off_t>(m_fileSize), static_cast<off_t>(end - m_fileSize));
+				if (err != 0 && err != EOPNOTSUPP && err != EINVAL) return nullptr;
+				if (err != 0 && ::ftruncate(m_file, static_cast<off_t>(end)) != 0) return nullptr;
+#else
+				if (::ftruncate(m_file, static_cast<off_t>(end)) != 0) return nullptr;
+#endif
+				m_fileSize = end;
+			}
+			void* mem = ::mmap(nullptr, m_segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_file, static_cast<off_t>(offset));
+			if (mem == MAP_FAILED) return nullptr;
+			base = static_cast<char*>(mem);
+#endif
+			segment.written.store(0, std::memory_order_relaxed);
+			segment.base.store(base, std::memory_order_relaxed);
+			segment.index.store(index + 1, std::memory_order_release);
+			return base;
+		}
+
+		void unmapUnderLock(Segment& segment)
+		{
+			char* base = segment.base.load(std::memory_order_relaxed);
+			segment.index.store(0, std::memory_order_relaxed);
+			segment.base.store(nullptr, std::memory_order_relaxed);
+			if (base == nullptr) return;
+#if defined(SIMPLELOG_WINDOWS)
+			UnmapViewOfFile(base);
+			::CloseHandle(segment.mapping);
+			segment.mapping = NULL;
+#else
+			::munmap(base, m_segmentSize);
+#endif
+		}
+	};
+
+	/// <summary>
+	/// Keeps the most recent log lines in a preallocated in-memory ring, overwriting the oldest lines.
+	/// Used by the memory-only `SimpleLog`, see `SimpleLog::Options::Ring`.
+	/// </summary>
+	/// <remarks>
+	/// Each line is stored as a record: a stamp derived from its position, its length, and the line padded to 8 bytes.
+	/// Writers reserve their record with an atomic counter, copy their line without lock, and publish the stamp last.
+	/// Writers never wait for each other, so a writer stopped while copying, e.g. by a crash, only loses its own line.
+	/// Readers skip records without matching stamp, i.e. not yet published, and records overwritten while they were read.
+	/// </remarks>
+	class LogRing
+	{
+	public:
+
+		static constexpr size_t const DefaultSize = 1024 * 1024;
+
+		/// <summary>
+		/// Allocates the ring
+		/// </summary>
+		/// <param name="size">The size of the ring in bytes; rounded up to a power of two</param>
+		explicit LogRing(size_t size)
+		{
+			size_t capacity = 64;
+			while (capacity < size) capacity *= 2;
+			m_capacity = capacity;
+			m_words = std::make_unique<std::atomic<uint64_t>[]>(m_capacity / sizeof(uint64_t));
+			for (size_t i = 0; i < m_capacity / sizeof(uint64_t); ++i)
+			{
+				m_words[i].store(0, std::memory_order_relaxed);
+			}
+		}
+
+		LogRing(const LogRing&) = delete;
+		LogRing(LogRing&&) = delete;
+		LogRing& operator=(const LogRing&) = delete;
+		LogRing& operator=(LogRing&&) = delete;
+
+		/// <summary>
+		/// Gets the size of the ring in bytes
+		/// </summary>
+		inline size_t GetSize() const noexcept
+		{
+			return m_capacity;
+		}
+
+		/// <summary>
+		/// Gets the number of bytes reserved since the ring was created, including record headers and overwritten records
+		/// </summary>
+		inline uint64_t GetTotalBytes() const noexcept
+		{
+			return m_head.load(std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		/// Appends a line to the ring; thread-safe, without lock, and without waiting for other writers
+		/// </summary>
+		/// <param name="data">The line</param>
+		/// <param name="len">The length of the line in bytes; only the last bytes are kept if it does not fit into the ring</param>
+		void Append(char const* data, size_t len) noexcept
+		{
+			size_t const maxLen = m_capacity - HeaderSize;
+			if (len > maxLen)
+			{
+				data += len - maxLen;
+				len = maxLen;
+			}
+			uint64_t const pos = m_head.fetch_add(recordSize(len), std::memory_order_relaxed);
+			word(pos).store(0, std::memory_order_relaxed);
+			word(pos + sizeof(uint64_t)).store(len, std::memory_order_relaxed);
+			// the stamp is reset before the line is copied, and only set after
+			std::atomic_thread_fence(std::memory_order_release);
+			copyIn(pos + HeaderSize, data, len);
+			word(pos).store(stamp(pos), std::memory_order_release);
+		}
+
+		/// <summary>
+		/// Gets a copy of the complete lines in the ring
+		/// </summary>
+		std::string GetContent() const
+		{
+			std::string content;
+			content.reserve(m_capacity);
+			forEachRecord([&](uint64_t pos, size_t len)
+				{
+					size_t const offset = content.size();
+					content.resize(offset + len);
+					copyOut(pos + HeaderSize, content.data() + offset, len);
+					// records overwritten by writers while copying are dropped
+					std::atomic_thread_fence(std::memory_order_acquire);
+					if (isOverwritten(pos)) content.resize(offset);
+				});
+			return content;
+		}
+
+		/// <summary>
+		/// Passes the complete lines in the ring to a callback, in parts, without copying and without allocating memory.
+		/// Intended for crash handlers.
+		/// </summary>
+		/// <param name="callback">Called with the data and its length in bytes; once for each line, or twice if the line wraps around the end of the ring</param>
+		/// <remarks>Lines written by other threads during the callback can overwrite the oldest lines passed to it.</remarks>
+		void Dump(std::function<void(char const* data, size_t len)> const& callback) const
+		{
+			char const* const data = reinterpret_cast<char const*>(m_words.get());
+			forEachRecord([&](uint64_t pos, size_t len)
+				{
+					size_t const start = static_cast<size_t>((pos + HeaderSize) & (m_capacity - 1));
+					size_t const first = std::min(len, m_capacity - start);
+					callback(data + start, first);
+					if (first < len)
+					{
+						callback(data, len - first);
+					}
+				});
+		}
+
+	private:
+
+		/// <summary>
+		/// Size of the record header: the stamp and the length of the line
+		/// </summary>
+		static constexpr size_t const HeaderSize = 2 * sizeof(uint64_t);
+
+		static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t), "Records require plain 64-bit atomics");
+
+		static constexpr size_t recordSize(size_t len) noexcept
+		{
+			return HeaderSize + ((len + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1));
+		}
+
+		/// <summary>
+		/// The stamp of a published record; never zero, and only matches the record at this position
+		/// </summary>
+		static constexpr uint64_t stamp(uint64_t pos) noexcept
+		{
+			return (pos | 1) ^ 0x534c5247u;
+		}
+
+		std::atomic<uint64_t>& word(uint64_t pos) const noexcept
+		{
+			return m_words[static_cast<size_t>(pos & (m_capacity - 1)) / sizeof(uint64_t)];
+		}
+
+		/// <summary>
+		/// Checks if writers reserved bytes beyond the record at `pos` which reach around the ring into it
+		/// </summary>
+		bool isOverwritten(uint64_t pos) const noexcept
+		{
+			return m_head.load(std::memory_order_relaxed) > pos + m_capacity;
+		}
+
+		/// <summary>
+		/// Calls `func(pos, len)` for each published record, which is not overwritten, from the oldest to the newest
+		/// </summary>
+		template<typename FUNC>
+		void forEachRecord(FUNC&& func) const
+		{
+			uint64_t const end = m_head.load(std::memory_order_acquire);
+			// records are aligned to 8 bytes, so headers are found by trying each word
+			uint64_t pos = (end > m_capacity) ? end - m_capacity : 0;
+			while (pos + HeaderSize <= end)
+			{
+				if (word(pos).load(std::memory_order_acquire) != stamp(pos))
+				{
+					// not yet published, or not a record header
+					pos += sizeof(uint64_t);
+					continue;
+				}
+				uint64_t const len = word(pos + sizeof(uint64_t)).load(std::memory_order_relaxed);
+				if (len > m_capacity - HeaderSize || pos + recordSize(static_cast<size_t>(len)) > end || isOverwritten(pos))
+				{
+					pos += sizeof(uint64_t);
+					continue;
+				}
+				func(pos, static_cast<size_t>(len));
+				pos += recordSize(static_cast<size_t>(len));
+			}
+		}
+
+		void copyIn(uint64_t pos, char const* data, size_t len) noexcept
+		{
+			char* const base = reinterpret_cast<char*>(m_words.get());
+			size_t const start = static_cast<size_t>(pos & (m_capacity - 1));
+			size_t const first = std::min(len, m_capacity - start);
+			std::memcpy(base + start, data, first);
+			std::memcpy(base, data + first, len - first);
+		}
+
+		void copyOut(uint64_t pos, char* out, size_t len) const noexcept
+		{
+			char const* const base = reinterpret_cast<char const*>(m_words.get());
+			size_t const start = static_cast<size_t>(pos & (m_capacity - 1));
+			size_t const first = std::min(len, m_capacity - start);
+			std::memcpy(out, base + start, first);
+			std::memcpy(out + first, base, len - first);
+		}
+
+		size_t m_capacity{ 0 };
+
+		/// <summary>
+		/// The records; 64-bit words, so record headers can be accessed atomically
+		/// </summary>
+		std::unique_ptr<std::atomic<uint64_t>[]> m_words;
+
+		/// <summary>
+		/// The number of bytes reserved by writers since the ring was created
+		/// </summary>
+		std::atomic<uint64_t> m_head{ 0 };
+	};
+
+	/// <summary>
+	/// SimpleLog implementation
+	/// </summary>
+	class SimpleLog : public ISimpleLog
+	{
+		friend class BinaryLogDecoder;
+
+	private:
+
+		static std::filesystem::path getProcessPath()
+		{
+#if defined(SIMPLELOG_POSIX)
+			std::error_code ec;
+			std::filesystem::path exe = std::filesystem::read_symlink("/proc/self/exe", ec);
+			if (!ec && !exe.empty())
+			{
+				return exe;
+			}
+			return {};
+#else
+			// Visual Cpp specific
+			wchar_t filename[MAX_PATH + 1];
+			DWORD filenameLen = GetModuleFileNameW(nullptr, filename, MAX_PATH);
+			if (filenameLen > 0)
+			{
+				return std::filesystem::path{ filename, filename + filenameLen };
+			}
+			filenameLen = GetProcessImageFileNameW(GetCurrentProcess(), filename, MAX_PATH);
+			if (filenameLen > 0)
+			{
+				return std::filesystem::path{ filename, filename + filenameLen };
+			}
+			if (__argv != nullptr && __argv[0] != nullptr && __argv[0][0] != 0)
+			{
+				return std::filesystem::path{ __argv[0] };
+			}
+			if (__wargv != nullptr && __wargv[0] != nullptr && __wargv[0][0] != 0)
+			{
+				return std::filesystem::path{ __wargv[0] };
+			}
+			return {};
+#endif
+		}
+
+		/// <summary>
+		/// Gets the per-user directory for application data, or an empty path if it cannot be determined
+		/// </summary>
+		static std::filesystem::path getUserDataPath()
+		{
+#if defined(SIMPLELOG_WINDOWS)
+			PWSTR wPath;
+			if (SHGetKnownFolderPath(FOLDERID_LocalAppDataLow, 0, NULL, &wPath) == S_OK)
+			{
+				std::filesystem::path path{ wPath };
+				CoTaskMemFree(wPath);
+				return path;
+			}
+			return {};
+#else
+			char const* state = std::getenv("XDG_STATE_HOME");
+			if (state != nullptr && state[0] == '/')
+			{
+				return std::filesystem::path{ state };
+			}
+			char const* home = std::getenv("HOME");
+			if (home != nullptr && home[0] == '/')
+			{
+				return std::filesystem::path{ home } / ".local" / "state";
+			}
+			return {};
+#endif
+		}
+
+		/// <summary>
+		/// Utility class to release native resources in a RAII fashion
+		/// </summary>
+		template<typename func_t>
+		class scope_exit
+		{
+		public:
+			scope_exit(func_t&& f) : m_f(std::move(f)) {}
+			~scope_exit()
+			{
+				m_f();
+			}
+		private:
+			func_t m_f;
+		};
+
+#if defined(SIMPLELOG_WINDOWS)
+		using file_t = HANDLE;
+		static inline file_t invalidFile() noexcept { return INVALID_HANDLE_VALUE; }
+#else
+		using file_t = int;
+		static constexpr file_t invalidFile() noexcept { return -1; }
+#endif
+
+		/// <summary>
+		/// The open log file; only replaced under the thread lock, when the log file is rotated
+		/// </summary>
+		mutable file_t m_file{ invalidFile() };
+
+#if defined(SIMPLELOG_POSIX)
+		/// <summary>
+		/// The path the log file was opened with, or renamed to by the rotation
+		/// </summary>
+		std::filesystem::path m_filePath;
+#endif
+
+		static void syncFile(file_t file) noexcept
+		{
+#if defined(SIMPLELOG_WINDOWS)
+			FlushFileBuffers(file);
+#elif defined(__APPLE__)
+			::fsync(file);
+#else
+			::fdatasync(file);
+#endif
+		}
+
+		static void closeFile(file_t file) noexcept
+		{
+#if defined(SIMPLELOG_WINDOWS)
+			::CloseHandle(file);
+#else
+			::close(file);
+#endif
+		}
+
+		/// <summary>
+		/// Machine-wide lock serializing the retention renames of the log files of one name in one directory.
+		/// Logs of other names or in other directories are set up in parallel.
+		/// </summary>
+		class SetupLock
+		{
+		public:
+			SetupLock(std::filesystem::path const& directory, std::wstring const& name)
+			{
+#if defined(SIMPLELOG_WINDOWS)
+				// Visual Cpp specific
+				// GetFullPathNameW is also used by `Path.GetFullPath` of the CSharp implementation
+				std::wstring const path = (directory / name).wstring();
+				std::wstring fullPath(MAX_PATH, L'\0');
+				DWORD len = GetFullPathNameW(path.c_str(), static_cast<DWORD>(fullPath.size()), fullPath.data(), nullptr);
+				if (len > fullPath.size())
+				{
+					fullPath.resize(len);
+					len = GetFullPathNameW(path.c_str(), static_cast<DWORD>(fullPath.size()), fullPath.data(), nullptr);
+				}
+				if (len == 0 || len > fullPath.size())
+				{
+					fullPath = path;
+				}
+				else
+				{
+					fullPath.resize(len);
+				}
+				m_mutex = CreateMutexW(nullptr, FALSE, GetSetupMutexName(fullPath).c_str());
+				if (m_mutex == NULL)
+				{
+					throw std::runtime_error("Failed to create initializtion mutex");
+				}
+				WaitForSingleObject(m_mutex, INFINITE);
+#else
+				// advisory lock file next to the log files, equivalent to the named mutex on Windows
+				// The file is never deleted, as another process might just have opened it to wait for the lock.
+				std::filesystem::path const lockPath = directory / (L"." + name + L".lock");
+				m_lock = ::open(lockPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+				// If the lock file cannot be opened, e.g. because it is owned by another user, the setup continues without the lock.
+				if (m_lock >= 0)
+				{
+					::fchmod(m_lock, 0666);
+					while (::flock(m_lock, LOCK_EX) != 0 && errno == EINTR) {}
+				}
+#endif
+			}
+
+			~SetupLock()
+			{
+#if defined(SIMPLELOG_WINDOWS)
+				::ReleaseMutex(m_mutex);
+				::CloseHandle(m_mutex);
+#else
+				if (m_lock >= 0)
+				{
+					::flock(m_lock, LOCK_UN);
+					::close(m_lock);
+				}
+#endif
+			}
+
+			SetupLock(const SetupLock&) = delete;
+			SetupLock(SetupLock&&) = delete;
+			SetupLock& operator=(const SetupLock&) = delete;
+			SetupLock& operator=(SetupLock&&) = delete;
+
+		private:
+#if defined(SIMPLELOG_WINDOWS)
+			HANDLE m_mutex{ NULL };
+#else
+			int m_lock{ -1 };
+#endif
+		};
+
+		/// <summary>
+		/// Deletes the oldest log file, and renames all other log files to the next higher number, freeing the name of the current log file.
+		/// Must be called under the `SetupLock`.
+		/// </summary>
+		static void shiftRetainedFiles(std::filesystem::path const& directory, std::wstring const& name, std::wstring const& ext, int retention)
+		{
+			std::filesystem::path fn = directory / (name + L"." + std::to_wstring(retention - 1) + ext);
+			if (std::filesystem::is_regular_file(fn))
+			{
+				std::filesystem::remove(fn);
+				if (std::filesystem::is_regular_file(fn))
+				{
+					std::string msg = "Failed to delete old log file '" + fn.string() + "'";
+					throw std::runtime_error(msg.c_str());
+				}
+			}
+
+			for (int i = retention - 1; i > 0; --i)
+			{
+				std::filesystem::path tfn = directory / (name + L"." + std::to_wstring(i) + ext);
+				std::filesystem::path sfn = directory / (name + L"." + std::to_wstring(i - 1) + ext);
+				if (i == 1) sfn = sfn = directory / (name + ext);
+				if (!std::filesystem::is_regular_file(sfn)) continue;
+				if (std::filesystem::is_regular_file(tfn))
+				{
+					std::string msg = "Log file retention error. Unexpected log file: '" + tfn.string() + "'";
+					throw std::runtime_error(msg.c_str());
+				}
+				std::filesystem::rename(sfn, tfn);
+				if (std::filesystem::is_regular_file(sfn))
+				{
+					std::string msg = "Log file retention error. Unable to move log file: '" + sfn.string() + "'";
+					throw std::runtime_error(msg.c_str());
+				}
+			}
+		}
+
+		/// <summary>
+		/// Checks if a process is still running; a process which cannot be queried counts as running
+		/// </summary>
+		static bool isProcessRunning(unsigned long pid) noexcept
+		{
+#if defined(SIMPLELOG_WINDOWS)
+			HANDLE process = ::OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(pid));
+			if (process == NULL) return GetLastError() == ERROR_ACCESS_DENIED;
+			bool const running = (WaitForSingleObject(process, 0) == WAIT_TIMEOUT);
+			::CloseHandle(process);
+			return running;
+#else
+			// pids from file names beyond the range of pid_t would address process groups
+			if (pid == 0 || pid > static_cast<unsigned long>(std::numeric_limits<pid_t>::max())) return false;
+			return ::kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#endif
+		}
+
+		static unsigned long currentProcessId() noexcept
+		{
+#if defined(SIMPLELOG_WINDOWS)
+			return static_cast<unsigned long>(GetCurrentProcessId());
+#else
+			return static_cast<unsigned long>(::getpid());
+#endif
+		}
+
+		/// <summary>
+		/// Moves successor files left over by terminated processes, "name.next.<pid>-<n>.log", into the retention chain.
+		/// A process terminating after a rotation, but before renaming, leaves its active log file with this name.
+		/// Successor files of running processes are kept, and empty left-overs are deleted.
+		/// Must be called under the `SetupLock`.
+		/// </summary>
+		static void adoptLeftoverSuccessors(std::filesystem::path const& directory, std::wstring const& name, std::wstring const& ext, int retention)
+		{
+			std::wstring const prefix = name + L".next";
+			std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> leftovers;
+			std::error_code ec;
+			for (std::filesystem::directory_entry const& entry : std::filesystem::directory_iterator{ directory, ec })
+			{
+				std::wstring const fn = entry.path().filename().wstring();
+				if (fn.size() < prefix.size() + ext.size()) continue;
+				if (fn.compare(0, prefix.size(), prefix) != 0 || fn.compare(fn.size() - ext.size(), ext.size(), ext) != 0) continue;
+				// empty for the fixed name of earlier versions, otherwise ".<pid>-<n>"
+				std::wstring const id = fn.substr(prefix.size(), fn.size() - prefix.size() - ext.size());
+				if (!id.empty())
+				{
+					size_t const dash = id.find(L'-');
+					if (id[0] != L'.' || dash == std::wstring::npos || dash < 2 || dash + 1 == id.size()
+						|| id.find_first_not_of(L"0123456789-", 1) != std::wstring::npos) continue;
+					unsigned long const pid = std::wcstoul(id.c_str() + 1, nullptr, 10);
+					if (pid == currentProcessId() || isProcessRunning(pid)) continue;
+				}
+				std::error_code entryEc;
+				if (!entry.is_regular_file(entryEc)) continue;
+				leftovers.emplace_back(entry.last_write_time(entryEc), entry.path());
+			}
+
+			// the oldest file first, so the newest ends up with the lowest number
+			std::sort(leftovers.begin(), leftovers.end());
+			for (auto const& leftover : leftovers)
+			{
+				std::error_code fileEc;
+				if (std::filesystem::file_size(leftover.second, fileEc) == 0 && !fileEc)
+				{
+					std::filesystem::remove(leftover.second, fileEc);
+					continue;
+				}
+				shiftRetainedFiles(directory, name, ext, retention);
+				std::filesystem::rename(leftover.second, directory / (name + ext), fileEc);
+			}
+		}
+
+		/// <summary>
+		/// Per-thread storage for assembling lines before the thread lock is taken
+		/// </summary>
+		struct LineBuffer
+		{
+			/// <summary>
+			/// One formatter for local and one for UTC time stamps, as changing this setting discards the cached prefix.
+			/// All logs written on a thread share them, also if their settings differ. The precision does not affect the cache.
+			/// </summary>
+			TimeStampFormatter timeStamps[2]{ TimeStampFormatter{ false }, TimeStampFormatter{ true } };
+			std::string line;
+#if defined(SIMPLELOG_WINDOWS)
+			std::wstring wide;
+#endif
+		};
+
+		static LineBuffer& threadLineBuffer()
+		{
+			thread_local LineBuffer buffer;
+			return buffer;
+		}
+
+		void appendUtf8(LineBuffer& buf, const wchar_t* str, size_t len) const
+		{
+			Utf8Encoding::AppendFromWide(buf.line, str, len);
+		}
+
+		void appendUtf8(LineBuffer& buf, const char* str, size_t len) const
+		{
+#if defined(SIMPLELOG_POSIX)
+			// narrow strings are expected to be UTF8 already, as on all common POSIX locales
+			buf.line.append(str, len);
+#else
+			if (Utf8Encoding::IsAscii(str, len))
+			{
+				buf.line.append(str, len);
+			}
+			else
+			{
+				// full conversion needed
+				m_stats.CountTranscodingFallback();
+				int size = MultiByteToWideChar(CP_ACP, MB_COMPOSITE, str, static_cast<int>(len), nullptr, 0);
+				buf.wide.resize(static_cast<size_t>(size), L'\0');
+				MultiByteToWideChar(CP_ACP, MB_COMPOSITE, str, static_cast<int>(len), buf.wide.data(), size);
+				Utf8Encoding::AppendFromWide(buf.line, buf.wide.data(), static_cast<size_t>(size));
+			}
+#endif
+		}
+
+		/// <summary>
+		/// Assembles the complete line, i.e. time stamp, level tag, message, and new line, in the buffer of the calling thread
+		/// </summary>
+		template<typename CHAR>
+		LineBuffer& assembleLine(uint32_t flags, CHAR const* message, size_t messageLength) const
+		{
+			LineBuffer& buf = threadLineBuffer();
+			TimeStampFormatter& timeStamp = buf.timeStamps[m_utcTimeStamps.load(std::memory_order_relaxed) ? 1 : 0];
+			timeStamp.SetPrecision(m_timeStampPrecision.load(std::memory_order_relaxed));
+
+			//  all time stamps and all local strings and characters in this function are valid UTF8 (7-bit ASCII)
+			char ts[TimeStampFormatter::MaxLength];
+			size_t const tsLen = timeStamp.Format(ts);
+			buf.line.assign(ts, tsLen);
+			buf.line.append(levelTag(flags));
+			appendUtf8(buf, message, messageLength);
+			buf.line.push_back('\n');
+			return buf;
+		}
+
+		/// <summary>
+		/// Gets the level tag written after the time stamp, including the separators
+		/// </summary>
+		static std::string_view levelTag(uint32_t flags) noexcept
+		{
+			using namespace std::string_view_literals;
+			switch (flags & FlagLevelMask)
+			{
+			case FlagLevelCritical: return "|CRITICAL "sv;
+			case FlagLevelError: return "|ERROR "sv;
+			case FlagLevelWarning: return "|WARNING "sv;
+			case FlagLevelDetail: return "|DETAIL "sv;
+			default: return "| "sv;
+			}
+		}
+
+		/// <summary>
+		/// Writes a complete line, or binary records; `isMessage` is false for internal records, which are not counted as messages
+		/// </summary>
+		void writeLineUnderLock(uint32_t flags, char const* line, size_t lineLen, bool isMessage) const
+		{
+			// assumptions:
+			//  m_file != invalidFile()
+			//  line is a complete UTF8 line, including the new line character
+			if (m_rotationActive && needsRotationUnderLock(lineLen))
+			{
+				rotateUnderLock();
+			}
+			writeUnderLock(line, lineLen);
+			m_unflushedBytes += lineLen;
+			if (isMessage) m_stats.CountMessage(flags);
+
+			if (needsFlushUnderLock(flags))
+			{
+				flushUnderLock();
+			}
+		}
+
+		void writeUnderLock(char const* data, size_t len) const
+		{
+			auto const start = std::chrono::steady_clock::now();
+#if defined(SIMPLELOG_POSIX)
+			// The file is opened with O_APPEND, so each line is appended as a whole.
+			struct iovec part;
+			part.iov_base = const_cast<char*>(data);
+			part.iov_len = len;
+			writeAllUnderLock(&part, 1);
+#else
+			WriteFile(m_file, data, static_cast<DWORD>(len), NULL, NULL);
+#endif
+			m_stats.CountWrite(std::chrono::steady_clock::now() - start);
+			m_stats.CountBytes(len);
+			m_fileSize += len;
+		}
+
+#if defined(SIMPLELOG_POSIX)
+		/// <summary>
+		/// Writes all parts, continuing after interrupted or partial writes
+		/// </summary>
+		void writeAllUnderLock(struct iovec* parts, int count) const
+		{
+			while (count > 0)
+			{
+				ssize_t written = ::writev(m_file, parts, count);
+				if (written < 0)
+				{
+					if (errno == EINTR) continue;
+					return;
+				}
+				while (count > 0 && static_cast<size_t>(written) >= parts->iov_len)
+				{
+					written -= static_cast<ssize_t>(parts->iov_len);
+					++parts;
+					--count;
+				}
+				if (count > 0)
+				{
+					parts->iov_base = static_cast<char*>(parts->iov_base) + written;
+					parts->iov_len -= static_cast<size_t>(written);
+				}
+			}
+		}
+#endif
+
+		/// <summary>
+		/// Evaluates the flush policy after a message has been written
+		/// </summary>
+		bool needsFlushUnderLock(uint32_t flags) const
+		{
+			if (m_flushPolicy.everyMessage) return true;
+			if (m_flushPolicy.onLevel && GetLevelSeverity(flags) >= GetLevelSeverity(m_flushPolicy.level)) return true;
+			if (m_flushPolicy.everyBytes > 0 && m_unflushedBytes >= m_flushPolicy.everyBytes) return true;
+			if (m_flushPolicy.everyMilliseconds > 0
+				&& std::chrono::steady_clock::now() - m_lastFlush >= std::chrono::milliseconds(m_flushPolicy.everyMilliseconds)) return true;
+			return false;
+		}
+
+		void flushUnderLock() const
+		{
+			if (m_unflushedBytes == 0) return;
+			auto const start = std::chrono::steady_clock::now();
+			syncFile(m_file);
+			m_lastFlush = std::chrono::steady_clock::now();
+			m_stats.CountFlush(m_lastFlush - start);
+			m_unflushedBytes = 0;
+		}
+
+		/// <summary>
+		/// Evaluates the rotation policy before a line is written.
+		/// Rotation waits until the successor file is ready, so writers never wait for the file system.
+		/// </summary>
+		bool needsRotationUnderLock(size_t lineLen) const
+		{
+			if (m_successorFile == invalidFile()) return false;
+			if (m_rotationPolicy.maxBytes > 0 && m_fileSize > m_preambleSize && m_fileSize + lineLen > m_rotationPolicy.maxBytes) return true;
+			if (m_rotationPolicy.maxSeconds > 0
+				&& std::chrono::steady_clock::now() - m_fileOpened >= std::chrono::seconds(m_rotationPolicy.maxSeconds)) return true;
+			return false;
+		}
+
+		/// <summary>
+		/// Switches to the pre-opened successor file, and leaves closing and renaming of the files to the rotation thread
+		/// </summary>
+		void rotateUnderLock() const
+		{
+			m_retiredFile = m_file;
+			m_file = m_successorFile;
+			m_successorFile = invalidFile();
+			m_fileSize = 0;
+			m_unflushedBytes = 0;
+			m_fileOpened = std::chrono::steady_clock::now();
+			if (m_binary)
+			{
+				// each binary log file is decoded on its own
+				std::string preamble{ BinaryLogFormat::Magic, sizeof(BinaryLogFormat::Magic) };
+				appendHeaderRecord(preamble);
+				preamble.append(m_formatRecords);
+				writeUnderLock(preamble.data(), preamble.size());
+			}
+			m_preambleSize = m_fileSize;
+			m_maintenanceSignal.notify_one();
+		}
+
+		/// <summary>
+		/// Creates a new successor file, named "name.next.<pid>-<n>.log", so that processes rotating the same log never share it.
+		/// Existing files are never replaced, as they might be the active log file of another process.
+		/// </summary>
+		file_t openSuccessor(std::filesystem::path& path) const
+		{
+			if (m_naming == FileNaming::TimeStamped)
+			{
+				return createTimeStampedFile(path, false);
+			}
+			static std::atomic<uint32_t> counter{ 0 };
+			std::wstring const prefix = m_name + L".next." + std::to_wstring(currentProcessId()) + L"-";
+			for (int attempt = 0; attempt < 100; ++attempt)
+			{
+				path = m_directory / (prefix + std::to_wstring(counter.fetch_add(1, std::memory_order_relaxed)) + m_ext);
+#if defined(SIMPLELOG_WINDOWS)
+				HANDLE file = ::CreateFileW(path.wstring().c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, CREATE_NEW, NULL, NULL);
+				if (file != INVALID_HANDLE_VALUE || GetLastError() != ERROR_FILE_EXISTS) return file;
+#else
+				int file = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+				if (file >= 0) return file;
+				if (errno != EEXIST) return invalidFile();
+#endif
+			}
+			return invalidFile();
+		}
+
+		/// <summary>
+		/// Creates a new log file named after the current time, "name.YYYYMMDD-HHMMSS-mmm.log" in UTC.
+		/// If the name is taken, e.g. by another process, the time in the name is increased by milliseconds, so the names stay in order.
+		/// </summary>
+		/// <returns>The file, or `invalidFile()` with the error of the failed creation as last error</returns>
+		file_t createTimeStampedFile(std::filesystem::path& path, bool readWrite) const
+		{
+			int64_t ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+			for (int attempt = 0; attempt < 1000; ++attempt, ++ms)
+			{
+				time_t const t = static_cast<time_t>(ms / 1000);
+				struct tm utc {};
+#if defined(SIMPLELOG_WINDOWS)
+				gmtime_s(&utc, &t);
+#else
+				gmtime_r(&t, &utc);
+#endif
+				wchar_t stamp[32];
+				std::swprintf(stamp, 32, L".%04d%02d%02d-%02d%02d%02d-%03d", utc.tm_year + 1900, utc.tm_mon + 1, utc.tm_mday,
+					utc.tm_hour, utc.tm_min, utc.tm_sec, static_cast<int>(ms % 1000));
+				path = m_directory / (m_name + stamp + m_ext);
+#if defined(SIMPLELOG_WINDOWS)
+				DWORD const access = readWrite ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_WRITE;
+				HANDLE file = ::CreateFileW(path.wstring().c_str(), access, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, CREATE_NEW, NULL, NULL);
+				if (file != INVALID_HANDLE_VALUE || GetLastError() != ERROR_FILE_EXISTS) return file;
+#else
+				int const access = readWrite ? O_RDWR : (O_WRONLY | O_APPEND);
+				int file = ::open(path.c_str(), access | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+				if (file >= 0) return file;
+				if (errno != EEXIST) return invalidFile();
+#endif
+			}
+			return invalidFile();
+		}
+
+		/// <summary>
+		/// Deletes the oldest time-stamped log files, so that `m_retention` files are kept.
+		/// Only the names are compared, so the time stamps of the files do not matter.
+		/// </summary>
+		void pruneTimeStampedFiles() const noexcept
+		{
+			try
+			{
+				std::wstring const prefix = m_name + L".";
+				std::vector<std::filesystem::path> files;
+				for (std::filesystem::directory_entry const& entry : std::filesystem::directory_iterator{ m_directory })
+				{
+					std::wstring const fn = entry.path().filename().wstring();
+					// "name." + "YYYYMMDD-HHMMSS-mmm" + ext
+					if (fn.size() != prefix.size() + 19 + m_ext.size()) continue;
+					if (fn.compare(0, prefix.size(), prefix) != 0 || fn.compare(fn.size() - m_ext.size(), m_ext.size(), m_ext) != 0) continue;
+					bool stamped = true;
+					for (size_t i = 0; i < 19 && stamped; ++i)
+					{
+						wchar_t const c = fn[prefix.size() + i];
+						stamped = (i == 8 || i == 15) ? (c == L'-') : (c >= L'0' && c <= L'9');
+					}
+					if (stamped && entry.is_regular_file()) files.push_back(entry.path());
+				}
+				if (files.size() <= static_cast<size_t>(m_retention)) return;
+				std::sort(files.begin(), files.end());
+				for (size_t i = 0; i + static_cast<size_t>(m_retention) < files.size(); ++i)
+				{
+					// files might have been deleted by another process in parallel
+					std::error_code ec;
+					std::filesystem::remove(files[i], ec);
+				}
+			}
+			catch (...) {}
+		}
+
+		/// <summary>
+		/// Finishes a rotation, after the retired file was closed
+		/// </summary>
+		/// <param name="activePath">The path of the active file, opened as successor</param>
+		/// <returns>True on success</returns>
+		bool finishRotation(std::filesystem::path const& activePath) const noexcept
+		{
+			if (m_naming == FileNaming::TimeStamped)
+			{
+				pruneTimeStampedFiles();
+				return true;
+			}
+			try
+			{
+				// renames the active file, still named as successor, to the name of the current log file
+				std::filesystem::path const current = m_directory / (m_name + m_ext);
+				SetupLock setupLock{ m_directory, m_name };
+				if (std::filesystem::exists(current))
+				{
+					shiftRetainedFiles(m_directory, m_name, m_ext, m_retention);
+					if (std::filesystem::exists(current)) return false;
+				}
+				std::filesystem::rename(activePath, current);
+				return true;
+			}
+			catch (...) {}
+			return false;
+		}
+
+		/// <summary>
+		/// Background thread of the rotation and of the pruning of time-stamped log files:
+		/// keeps a successor file open, and closes and renames files after each rotation
+		/// </summary>
+		void maintenanceThread()
+		{
+			bool prunePending = (m_naming == FileNaming::TimeStamped);
+			bool activeIsSuccessor = false;
+			std::filesystem::path successorFilePath;
+			std::unique_lock<std::mutex> lock{ m_threadLock };
+			while (!m_maintenanceStop)
+			{
+				if (prunePending)
+				{
+					prunePending = false;
+					lock.unlock();
+					pruneTimeStampedFiles();
+					lock.lock();
+					continue;
+				}
+
+				if (m_retiredFile != invalidFile())
+				{
+					file_t const retired = m_retiredFile;
+					m_retiredFile = invalidFile();
+					lock.unlock();
+					syncFile(retired);
+					closeFile(retired);
+					lock.lock();
+					activeIsSuccessor = true;
+					continue;
+				}
+
+				if (activeIsSuccessor || (m_rotationActive && m_successorFile == invalidFile()))
+				{
+					lock.unlock();
+					bool const finished = activeIsSuccessor && finishRotation(successorFilePath);
+					// a new successor is only opened after the active file got renamed, so the numbered files stay in order
+					std::filesystem::path path;
+					file_t const successor = (activeIsSuccessor && !finished) ? invalidFile() : openSuccessor(path);
+					lock.lock();
+					if (finished)
+					{
+						activeIsSuccessor = false;
+#if defined(SIMPLELOG_POSIX)
+						m_filePath = (m_naming == FileNaming::TimeStamped) ? successorFilePath : (m_directory / (m_name + m_ext));
+#endif
+					}
+					if (successor != invalidFile())
+					{
+						m_successorFile = successor;
+						successorFilePath = path;
+						continue;
+					}
+					// retry later, e.g. after a virus scanner released a file
+					m_maintenanceSignal.wait_for(lock, std::chrono::seconds(1), [this]() { return m_maintenanceStop; });
+					continue;
+				}
+
+				m_maintenanceSignal.wait(lock);
+			}
+
+			if (prunePending)
+			{
+				// the log is destroyed before the thread got to prune
+				lock.unlock();
+				pruneTimeStampedFiles();
+				lock.lock();
+			}
+
+			if (m_retiredFile != invalidFile())
+			{
+				syncFile(m_retiredFile);
+				closeFile(m_retiredFile);
+				m_retiredFile = invalidFile();
+				activeIsSuccessor = true;
+			}
+			if (m_successorFile != invalidFile())
+			{
+				closeFile(m_successorFile);
+				m_successorFile = invalidFile();
+				if (!activeIsSuccessor)
+				{
+					std::error_code ec;
+					std::filesystem::remove(successorFilePath, ec);
+				}
+			}
+			if (activeIsSuccessor)
+			{
+				lock.unlock();
+				finishRotation(successorFilePath);
+			}
+		}
+
+		/// <summary>
+		/// Mutex used to thread-lock all output
+		/// </summary>
+		mutable std::mutex m_threadLock;
+
+		/// <summary>
+		/// The minimum level of messages to be written
+		/// </summary>
+		uint32_t m_minLevel{ FlagLevelDetail };
+
+		/// <summary>
+		/// One bit per level value, set if messages of this level are written.
+		/// Zero while the log file is not open.
+		/// </summary>
+		std::atomic<uint32_t> m_enabledLevels{ 0 };
+
+		/// <summary>
+		/// The runtime statistics, see `GetStats()`
+		/// </summary>
+		mutable LogStatsCounters m_stats;
+
+		/// <summary>
+		/// The segment writer in `WriteMode::MemoryMapped`; set during construction only
+		/// </summary>
+		std::unique_ptr<MappedLogFile> m_mapped;
+
+		/// <summary>
+		/// The in-memory ring of a memory-only log with `Options::ringSize`; set during construction only
+		/// </summary>
+		std::unique_ptr<LogRing> m_ring;
+
+		/// <summary>
+		/// A line queued for group commit. The data is owned by the writing thread, which waits until the line is committed.
+		/// </summary>
+		struct GroupEntry
+		{
+			char const* data;
+			size_t len;
+			uint32_t flags;
+			bool isMessage;
+		};
+
+		/// <summary>
+		/// Set if concurrent writers are coalesced into one write and one flush, see `SetGroupCommit`
+		/// </summary>
+		std::atomic<bool> m_groupCommit{ false };
+
+		/// <summary>
+		/// The lines queued for the next group commit, their tickets, and the leader state.
+		/// Only used under the group lock, which is never held while waiting for the thread lock.
+		/// </summary>
+		mutable std::mutex m_groupLock;
+		mutable std::condition_variable m_groupSignal;
+		mutable std::vector<GroupEntry> m_groupQueue;
+		mutable uint64_t m_groupQueued{ 0 };
+		mutable uint64_t m_groupCommitted{ 0 };
+		mutable bool m_groupLeader{ false };
+
+		/// <summary>
+		/// The lines of the group commit in progress, and the buffers to write them; only used by the leader
+		/// </summary>
+		mutable std::vector<GroupEntry> m_groupBatch;
+#if defined(SIMPLELOG_POSIX)
+		mutable std::vector<struct iovec> m_groupParts;
+#else
+		mutable std::string m_groupBuffer;
+#endif
+
+		/// <summary>
+		/// Set if the file format is `FileFormat::Binary`; set during construction only
+		/// </summary>
+		bool m_binary{ false };
+
+		/// <summary>
+		/// Identifies this instance in the per-thread format id caches, as addresses of destroyed instances might be reused
+		/// </summary>
+		uint64_t const m_serial{ nextSerial() };
+
+		/// <summary>
+		/// A format string written to the binary log file
+		/// </summary>
+		struct FormatEntry
+		{
+			uint32_t id;
+			std::string text;
+		};
+
+		/// <summary>
+		/// The format strings written to the binary log file, by address; at most `BinaryLogFormat::MaxFormats`.
+		/// Only used under the format lock.
+		/// </summary>
+		mutable std::mutex m_formatLock;
+		mutable std::map<char const*, FormatEntry> m_formatIds;
+		mutable uint32_t m_formatCount{ 0 };
+
+		static uint64_t nextSerial() noexcept
+		{
+			static std::atomic<uint64_t> serial{ 0 };
+			return ++serial;
+		}
+
+		/// <summary>
+		/// Checks the level of a message passed to a write function, and counts it if it is discarded
+		/// </summary>
+		bool isAccepted(uint32_t flags) const noexcept
+		{
+			uint32_t const enabledLevels = m_enabledLevels.load(std::memory_order_relaxed);
+			if (((enabledLevels >> (flags & FlagLevelMask)) & 1u) != 0) return true;
+			if (enabledLevels == 0)
+			{
+				m_stats.CountDropped();
+			}
+			else
+			{
+				m_stats.CountSuppressed();
+			}
+			return false;
+		}
+
+		/// <summary>
+		/// Writes a complete line, or binary records; `isMessage` is false for internal records, which are not counted as messages
+		/// </summary>
+		void writeLine(uint32_t flags, char const* data, size_t len, bool isMessage) const
+		{
+			if (m_ring)
+			{
+				m_ring->Append(data, len);
+				if (isMessage) m_stats.CountMessage(flags);
+				m_stats.CountBytes(len);
+				return;
+			}
+			ensureOpen();
+			if (m_mapped)
+			{
+				if (!m_mapped->Append(data, len))
+				{
+					// parts of the line are lost, as their segment of the file could not be mapped
+					if (isMessage) m_stats.CountDropped();
+					return;
+				}
+				if (isMessage) m_stats.CountMessage(flags);
+				m_stats.CountBytes(len);
+				return;
+			}
+			if (m_groupCommit.load(std::memory_order_relaxed))
+			{
+				writeGrouped(flags, data, len, isMessage);
+				return;
+			}
+			std::unique_lock<std::mutex> const lock = m_stats.Lock(m_threadLock);
+			if (m_file == invalidFile())
+			{
+				if (isMessage) m_stats.CountDropped();
+				return;
+			}
+			writeLineUnderLock(flags, data, len, isMessage);
+		}
+
+		/// <summary>
+		/// Queues a line for group commit, and returns when it is written and flushed according to the flush policy.
+		/// If no other thread is committing, this thread becomes the leader and commits all queued lines.
+		/// Otherwise, it waits for the leader, and becomes the leader of the next group if its line was queued too late.
+		/// </summary>
+		void writeGrouped(uint32_t flags, char const* data, size_t len, bool isMessage) const
+		{
+			std::unique_lock<std::mutex> lock = m_stats.Lock(m_groupLock);
+			m_groupQueue.push_back(GroupEntry{ data, len, flags, isMessage });
+			uint64_t const ticket = ++m_groupQueued;
+			while (m_groupCommitted < ticket)
+			{
+				if (m_groupLeader)
+				{
+					m_groupSignal.wait(lock);
+					continue;
+				}
+				m_groupLeader = true;
+				uint64_t const last = m_groupQueued;
+				m_groupBatch.swap(m_groupQueue);
+				// lines queued from now on are committed by the next leader
+				lock.unlock();
+				try
+				{
+					std::unique_lock<std::mutex> const output = m_stats.Lock(m_threadLock);
+					commitGroupUnderLock();
+				}
+				catch (...) {}
+				m_groupBatch.clear();
+				lock.lock();
+				m_groupCommitted = last;
+				m_groupLeader = false;
+				m_groupSignal.notify_all();
+			}
+		}
+
+		/// <summary>
+		/// Writes all lines of `m_groupBatch` with one write call, and flushes once if any of them requires it
+		/// </summary>
+		void commitGroupUnderLock() const
+		{
+			if (m_file == invalidFile())
+			{
+				for (GroupEntry const& entry : m_groupBatch)
+				{
+					if (entry.isMessage) m_stats.CountDropped();
+				}
+				return;
+			}
+			size_t total = 0;
+			for (GroupEntry const& entry : m_groupBatch) total += entry.len;
+			if (m_rotationActive && needsRotationUnderLock(total))
+			{
+				rotateUnderLock();
+			}
+
+			auto const start = std::chrono::steady_clock::now();
+#if defined(SIMPLELOG_POSIX)
+#if defined(IOV_MAX)
+			size_t const maxParts = IOV_MAX;
+#else
+			size_t const maxParts = 16;
+#endif
+			m_groupParts.clear();
+			for (GroupEntry const& entry : m_groupBatch)
+			{
+				struct iovec part;
+				part.iov_base = const_cast<char*>(entry.data);
+				part.iov_len = entry.len;
+				m_groupParts.push_back(part);
+			}
+			for (size_t first = 0; first < m_groupParts.size(); first += maxParts)
+			{
+				writeAllUnderLock(m_groupParts.data() + first, static_cast<int>(std::min(maxParts, m_groupParts.size() - first)));
+			}
+#else
+			// WriteFileGather requires unbuffered files, so the lines are concatenated
+			m_groupBuffer.clear();
+			for (GroupEntry const& entry : m_groupBatch) m_groupBuffer.append(entry.data, entry.len);
+			WriteFile(m_file, m_groupBuffer.data(), static_cast<DWORD>(m_groupBuffer.size()), NULL, NULL);
+#endif
+			m_stats.CountWrite(std::chrono::steady_clock::now() - start);
+			m_stats.CountBytes(total);
+			m_fileSize += total;
+			m_unflushedBytes += total;
+
+			bool flush = false;
+			for (GroupEntry const& entry : m_groupBatch)
+			{
+				if (entry.isMessage) m_stats.CountMessage(entry.flags);
+				flush = flush || needsFlushUnderLock(entry.flags);
+			}
+			if (flush)
+			{
+				flushUnderLock();
+			}
+		}
+
+		template<typename T>
+		static inline void appendValue(std::string& out, T value)
+		{
+			out.append(reinterpret_cast<char const*>(&value), sizeof(T));
+		}
+
+		static inline void appendRecordHeader(std::string& out, BinaryLogFormat::RecordType type, size_t payloadLength)
+		{
+			out.push_back(static_cast<char>(type));
+			appendValue(out, static_cast<uint32_t>(payloadLength));
+		}
+
+		/// <summary>
+		/// Appends the header record, with the current time stamp settings
+		/// </summary>
+		void appendHeaderRecord(std::string& out) const
+		{
+			appendRecordHeader(out, BinaryLogFormat::RecordType::Header, 8);
+			out.push_back(static_cast<char>(BinaryLogFormat::Version));
+			out.push_back(static_cast<char>(sizeof(wchar_t)));
+			out.push_back(m_utcTimeStamps.load(std::memory_order_relaxed) ? 1 : 0);
+			out.push_back(static_cast<char>(m_timeStampPrecision.load(std::memory_order_relaxed)));
+			appendValue(out, BinaryLogFormat::ByteOrderMark);
+		}
+
+		void writeHeaderRecord() const
+		{
+			std::string header;
+			appendHeaderRecord(header);
+			writeLine(FlagLevelMessage, header.data(), header.size(), false);
+		}
+
+		static inline int64_t nowNanoseconds() noexcept
+		{
+			return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+		}
+
+		/// <summary>
+		/// Assembles a text record in the buffer of the calling thread
+		/// </summary>
+		template<typename CHAR>
+		LineBuffer& assembleTextRecord(uint32_t flags, CHAR const* message, size_t messageLength) const
+		{
+			LineBuffer& buf = threadLineBuffer();
+			buf.line.clear();
+			appendRecordHeader(buf.line, BinaryLogFormat::RecordType::Text, 0);
+			appendValue(buf.line, nowNanoseconds());
+			appendValue(buf.line, flags);
+			appendUtf8(buf, message, messageLength);
+			uint32_t const payloadLength = static_cast<uint32_t>(buf.line.size() - BinaryLogFormat::RecordHeaderSize);
+			std::memcpy(buf.line.data() + 1, &payloadLength, sizeof(uint32_t));
+			return buf;
+		}
+
+		/// <summary>
+		/// Gets the id of a format string, and writes its definition record on first use
+		/// </summary>
+		/// <returns>False if the format string is new, and the table of format strings is full</returns>
+		/// <remarks>
+		/// The per-thread cache only compares the address, so format strings must not change while in use, like string literals.
+		/// The table compares the content, so a format string changed between threads, or after eviction from the cache, gets a new id.
+		/// </remarks>
+		bool formatId(uint32_t flags, char const* format, uint32_t& id) const
+		{
+			struct CacheEntry
+			{
+				uint64_t serial{ 0 };
+				char const* format{ nullptr };
+				uint32_t id{ 0 };
+			};
+			thread_local CacheEntry cache[256];
+			CacheEntry& entry = cache[(reinterpret_cast<uintptr_t>(format) >> 3) & 255];
+			if (entry.serial == m_serial && entry.format == format)
+			{
+				id = entry.id;
+				return true;
+			}
+
+			std::lock_guard<std::mutex> lock{ m_formatLock };
+			auto const it = m_formatIds.find(format);
+			if (it != m_formatIds.end() && it->second.text == format)
+			{
+				id = it->second.id;
+			}
+			else
+			{
+				if (m_formatCount >= BinaryLogFormat::MaxFormats) return false;
+				id = m_formatCount++;
+				FormatEntry& stored = m_formatIds[format];
+				stored.id = id;
+				stored.text = format;
+				size_t const len = stored.text.size();
+				// written under the format lock, so the definition precedes all messages using the id
+				std::string record;
+				appendRecordHeader(record, BinaryLogFormat::RecordType::Format, sizeof(uint32_t) + len);
+				appendValue(record, id);
+				record.append(format, len);
+				ensureOpen();
+				if (m_mapped)
+				{
+					m_mapped->Append(record.data(), record.size());
+				}
+				else
+				{
+					std::lock_guard<std::mutex> lock{ m_threadLock };
+					if (m_file != invalidFile())
+					{
+						writeLineUnderLock(flags, record.data(), record.size(), false);
+						// repeated at the start of each rotated file
+						m_formatRecords.append(record);
+					}
+				}
+			}
+			entry.serial = m_serial;
+			entry.format = format;
+			entry.id = id;
+			return true;
+		}
+
+		/// <summary>
+		/// Renames the previous log files, and opens the log file
+		/// </summary>
+		void openFileUnderLock()
+		{
+			if (!std::filesystem::is_directory(m_directory))
+			{
+				if (!std::filesystem::is_directory(m_directory.parent_path())) throw std::runtime_error("Log directory does not exist");
+				std::filesystem::create_directories(m_directory);
+				if (!std::filesystem::is_directory(m_directory)) throw std::runtime_error("Failed to create log directory");
+			}
+
+			if (m_naming == FileNaming::TimeStamped)
+			{
+				// a single exclusive creation; files beyond the retention are deleted by the maintenance thread
+				std::filesystem::path fn;
+				m_file = createTimeStampedFile(fn, m_writeMode == WriteMode::MemoryMapped);
+				if (m_file == invalidFile())
+				{
+#if defined(SIMPLELOG_WINDOWS)
+					DWORD le = GetLastError();
+#else
+					int le = errno;
+#endif
+					std::string msg = "Failed to create log file: " + std::to_string(le);
+					throw std::runtime_error(msg.c_str());
+				}
+#if defined(SIMPLELOG_POSIX)
+				m_filePath = fn;
+#endif
+			}
+			else
+			{
+				openNumberedFileUnderLock();
+			}
+			m_fileOpened = std::chrono::steady_clock::now();
+
+			if (m_writeMode == WriteMode::MemoryMapped)
+			{
+				try
+				{
+					m_mapped = std::make_unique<MappedLogFile>(m_file, m_segmentSize);
+				}
+				catch (...)
+				{
+					closeFile(m_file);
+					m_file = invalidFile();
+					throw;
+				}
+			}
+
+			if (m_binary)
+			{
+				std::string start{ BinaryLogFormat::Magic, sizeof(BinaryLogFormat::Magic) };
+				appendHeaderRecord(start);
+				if (m_mapped)
+				{
+					m_mapped->Append(start.data(), start.size());
+				}
+				else
+				{
+					writeUnderLock(start.data(), start.size());
+					m_unflushedBytes += start.size();
+				}
+				m_preambleSize = m_fileSize;
+			}
+
+			if ((m_rotationActive || m_naming == FileNaming::TimeStamped) && !m_maintenanceThread.joinable())
+			{
+				m_maintenanceThread = std::thread{ &SimpleLog::maintenanceThread, this };
+			}
+		}
+
+		/// <summary>
+		/// Renames the previous log files, and opens "name.log"
+		/// </summary>
+		void openNumberedFileUnderLock()
+		{
+			// the lock file lives in the log directory
+			SetupLock setupLock{ m_directory, m_name };
+
+			adoptLeftoverSuccessors(m_directory, m_name, m_ext, m_retention);
+			shiftRetainedFiles(m_directory, m_name, m_ext, m_retention);
+
+			std::filesystem::path const fn = m_directory / (m_name + m_ext);
+
+#if defined(SIMPLELOG_WINDOWS)
+			// Share mode `Delete` allows other processes to rename the file while it is being written.
+			// This works because this process keeps an open file handle to write messages, and never reopens based on a file name.
+			DWORD const access = (m_writeMode == WriteMode::MemoryMapped) ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_WRITE;
+			m_file = ::CreateFileW(fn.wstring().c_str(), access, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_ALWAYS, NULL, NULL);
+			if (m_file == invalidFile())
+			{
+				DWORD le = GetLastError();
+				std::string msg = "Failed to create log file: " + std::to_string(le);
+				throw std::runtime_error(msg.c_str());
+			}
+			SetFilePointer(m_file, 0, 0, FILE_END);
+#else
+			// Other processes can rename the file while it is being written.
+			// This works because this process keeps an open file descriptor to write messages, and never reopens based on a file name.
+			int const access = (m_writeMode == WriteMode::MemoryMapped) ? O_RDWR : (O_WRONLY | O_APPEND);
+			m_file = ::open(fn.c_str(), access | O_CREAT | O_CLOEXEC, 0644);
+			if (m_file < 0)
+			{
+				int le = errno;
+				m_file = invalidFile();
+				std::string msg = "Failed to create log file: " + std::to_string(le);
+				throw std::runtime_error(msg.c_str());
+			}
+			m_filePath = fn;
+#endif
+		}
+
+		/// <summary>
+		/// Opens the log file on the first message, if the opening was deferred by `Options::lazyOpen`
+		/// </summary>
+		void ensureOpen() const
+		{
+			if (!m_openPending.load(std::memory_order_acquire)) return;
+			std::lock_guard<std::mutex> lock{ m_threadLock };
+			if (!m_openPending.load(std::memory_order_relaxed)) return;
+			// completes the construction, deferred to the first message
+			SimpleLog* self = const_cast<SimpleLog*>(this);
+			try
+			{
+				self->openFileUnderLock();
+			}
+			catch (...) {}
+			m_openPending.store(false, std::memory_order_release);
+			self->updateEnabledLevelsUnderLock();
+		}
+
+		void updateEnabledLevelsUnderLock()
+		{
+			uint32_t mask = 0;
+			if (m_file != invalidFile() || m_openPending.load(std::memory_order_relaxed) || m_ring)
+			{
+				for (uint32_t level = 0; level <= FlagLevelMask; ++level)
+				{
+					if (GetLevelSeverity(level) >= GetLevelSeverity(m_minLevel))
+					{
+						mask |= 1u << level;
+					}
+				}
+			}
+			m_enabledLevels.store(mask, std::memory_order_relaxed);
+		}
+
+	public:
+
+		/// <summary>
+		/// Specifies when the log file is flushed to the storage device
+		/// </summary>
+		/// <remarks>
+		/// All enabled conditions are combined, i.e. the file is flushed after a message if any of them is met.
+		/// The conditions are evaluated when messages are written; there is no timer flushing an idle log.
+		/// If no condition is enabled, flushing is left to the operating system.
+		/// The file is always flushed when the log is destroyed.
+		/// </remarks>
+		struct FlushPolicy
+		{
+			/// <summary>
+			/// Flush after every message. This is the default, and gives the strongest durability.
+			/// </summary>
+			bool everyMessage{ true };
+
+			/// <summary>
+			/// Flush when at least this many bytes have been written since the last flush; zero disables this condition
+			/// </summary>
+			size_t everyBytes{ 0 };
+
+			/// <summary>
+			/// Flush on the first message written at least this many milliseconds after the last flush; zero disables this condition
+			/// </summary>
+			uint32_t everyMilliseconds{ 0 };
+
+			/// <summary>
+			/// Flush after messages with a level at least as severe as `level`
+			/// </summary>
+			bool onLevel{ false };
+
+			/// <summary>
+			/// The level used when `onLevel` is set
+			/// </summary>
+			uint32_t level{ FlagLevelError };
+
+			/// <summary>
+			/// Flush after every message
+			/// </summary>
+			static FlushPolicy EveryMessage() noexcept { return FlushPolicy{}; }
+
+			/// <summary>
+			/// Never flush explicitly, but leave it to the operating system
+			/// </summary>
+			static FlushPolicy Never() noexcept
+			{
+				FlushPolicy p;
+				p.everyMessage = false;
+				return p;
+			}
+
+			/// <summary>
+			/// Flush when at least this many bytes have been written since the last flush
+			/// </summary>
+			static FlushPolicy EveryBytes(size_t bytes) noexcept
+			{
+				FlushPolicy p = Never();
+				p.everyBytes = bytes;
+				return p;
+			}
+
+			/// <summary>
+			/// Flush on the first message written at least this many milliseconds after the last flush
+			/// </summary>
+			static FlushPolicy EveryMilliseconds(uint32_t milliseconds) noexcept
+			{
+				FlushPolicy p = Never();
+				p.everyMilliseconds = milliseconds;
+				return p;
+			}
+
+			/// <summary>
+			/// Flush after messages with a level at least as severe as `level`, e.g. `FlagLevelError`
+			/// </summary>
+			static FlushPolicy OnLevel(uint32_t level) noexcept
+			{
+				FlushPolicy p = Never();
+				p.onLevel = true;
+				p.level = level & FlagLevelMask;
+				return p;
+			}
+		};
+
+		/// <summary>
+		/// Specifies when the log file is rotated while the log is in use
+		/// </summary>
+		/// <remarks>
+		/// On rotation, messages continue in a new log file, and the previous log files are renamed as on the creation of the log.
+		/// A background thread keeps the next file open in advance, as "name.next.<pid>-<n>.log" or with a new time-stamped name,
+		/// and closes and renames or deletes files after the switch.
+		/// If the next file is not ready yet, messages continue in the current file.
+		/// If the process terminates between the switch and the renaming, the next log created with the same name moves the file into the retained log files.
+		/// The conditions are evaluated when messages are written; there is no timer rotating an idle log.
+		/// The rotation is not applied in `WriteMode::MemoryMapped`.
+		/// </remarks>
+		struct RotationPolicy
+		{
+			/// <summary>
+			/// Rotate before a message would make the log file larger than this many bytes; zero disables this condition
+			/// </summary>
+			uint64_t maxBytes{ 0 };
+
+			/// <summary>
+			/// Rotate on the first message written at least this many seconds after the log file was opened; zero disables this condition
+			/// </summary>
+			uint32_t maxSeconds{ 0 };
+
+			/// <summary>
+			/// Never rotate while the log is in use. This is the default.
+			/// </summary>
+			static RotationPolicy Never() noexcept { return RotationPolicy{}; }
+
+			/// <summary>
+			/// Rotate before a message would make the log file larger than this many bytes
+			/// </summary>
+			static RotationPolicy MaxBytes(uint64_t bytes) noexcept
+			{
+				RotationPolicy p;
+				p.maxBytes = bytes;
+				return p;
+			}
+
+			/// <summary>
+			/// Rotate on the first message written at least this many seconds after the log file was opened
+			/// </summary>
+			static RotationPolicy MaxSeconds(uint32_t seconds) noexcept
+			{
+				RotationPolicy p;
+				p.maxSeconds = seconds;
+				return p;
+			}
+		};
+
+		/// <summary>
+		/// Specifies how messages are written to the log file
+		/// </summary>
+		enum class WriteMode
+		{
+			/// <summary>
+			/// Each message is written to the file with one write operation, serialized by a lock. This is the default.
+			/// </summary>
+			File,
+
+			/// <summary>
+			/// Messages are copied into memory-mapped segments of the file, without lock and without system call per message.
+			/// See `MappedLogFile`.
+			/// </summary>
+			/// <remarks>
+			/// The flush policy is not applied in this mode. Call `Flush` to write the mapped memory to the storage device.
+			/// If the process terminates without destroying the log, the file contains zero bytes after the last message.
+			/// </remarks>
+			MemoryMapped
+		};
+
+		/// <summary>
+		/// Specifies the content of the log file
+		/// </summary>
+		enum class FileFormat
+		{
+			/// <summary>
+			/// Text lines with time stamp, level, and message. The file name extension is ".log". This is the default.
+			/// </summary>
+			Text,
+
+			/// <summary>
+			/// Binary records, see `BinaryLogFormat`. The file name extension is ".slb".
+			/// Printf-based messages are recorded with their format string and unformatted arguments,
+			/// and are formatted by `BinaryLogDecoder`, e.g. with the SimpleLogDecoder tool.
+			/// </summary>
+			/// <remarks>
+			/// Format strings are identified by their address, and must not change while the log is open, like string literals.
+			/// After `BinaryLogFormat::MaxFormats` different format strings, messages with further format strings are recorded as text.
+			/// Messages with arguments which cannot be encoded, messages with `%n` conversions, and messages without arguments, are recorded as text.
+			/// Character pointers are recorded as strings for `%s` conversions only, and as addresses otherwise.
+			/// </remarks>
+			Binary
+		};
+
+		/// <summary>
+		/// Specifies the names of the log files, and how previous log files are retained
+		/// </summary>
+		enum class FileNaming
+		{
+			/// <summary>
+			/// The log file is "name.log", and previous log files are "name.1.log", "name.2.log", and so on.
+			/// Creating a log renames all previous log files. This is the default.
+			/// </summary>
+			Numbered,
+
+			/// <summary>
+			/// Each log file is named after its creation time in UTC, "name.YYYYMMDD-HHMMSS-mmm.log".
+			/// Creating a log only creates one file, without renaming others.
+			/// The oldest files beyond the retention count are deleted by a background thread.
+			/// </summary>
+			TimeStamped
+		};
+
+		/// <summary>
+		/// Options for the creation of a SimpleLog
+		/// </summary>
+		struct Options
+		{
+			/// <summary>
+			/// How messages are written to the log file
+			/// </summary>
+			WriteMode writeMode{ WriteMode::File };
+
+			/// <summary>
+			/// The size of the file segments mapped at once in `WriteMode::MemoryMapped`
+			/// </summary>
+			size_t segmentSize{ MappedLogFile::DefaultSegmentSize };
+
+			/// <summary>
+			/// The content of the log file
+			/// </summary>
+			FileFormat fileFormat{ FileFormat::Text };
+
+			/// <summary>
+			/// The names of the log files
+			/// </summary>
+			FileNaming naming{ FileNaming::Numbered };
+
+			/// <summary>
+			/// If set, the log directory and the log file are only created, and the previous log files are only renamed, when the first message is written.
+			/// </summary>
+			/// <remarks>
+			/// The constructor then does not access the file system, and does not throw for file system errors.
+			/// If the log file cannot be opened on the first message, the log discards all messages.
+			/// </remarks>
+			bool lazyOpen{ false };
+
+			/// <summary>
+			/// The size in bytes of the in-memory ring of a memory-only log, created with empty directory and name.
+			/// If zero, a memory-only log discards all messages.
+			/// </summary>
+			/// <remarks>
+			/// The ring keeps the most recent text lines, see `LogRing`. The file format is ignored.
+			/// Use `SimpleLog::GetRingContent` or `SimpleLog::DumpRing` to read them.
+			/// </remarks>
+			size_t ringSize{ 0 };
+
+			/// <summary>
+			/// Default options, writing to the file
+			/// </summary>
+			static Options File() noexcept { return Options{}; }
+
+			/// <summary>
+			/// Options for writing a binary log file, with deferred formatting
+			/// </summary>
+			static Options Binary() noexcept
+			{
+				Options o;
+				o.fileFormat = FileFormat::Binary;
+				return o;
+			}
+
+			/// <summary>
+			/// Options for time-stamped log file names, see `FileNaming::TimeStamped`
+			/// </summary>
+			static Options TimeStamped() noexcept
+			{
+				Options o;
+				o.naming = FileNaming::TimeStamped;
+				return o;
+			}
+
+			/// <summary>
+			/// Options for opening the log file on the first message
+			/// </summary>
+			static Options Lazy() noexcept
+			{
+				Options o;
+				o.lazyOpen = true;
+				return o;
+			}
+
+			/// <summary>
+			/// Options for writing via memory-mapped file segments
+			/// </summary>
+			static Options MemoryMapped(size_t segmentSize = MappedLogFile::DefaultSegmentSize) noexcept
+			{
+				Options o;
+				o.writeMode = WriteMode::MemoryMapped;
+				o.segmentSize = segmentSize;
+				return o;
+			}
+
+			/// <summary>
+			/// Options for a memory-only log keeping the most recent lines in an in-memory ring
+			/// </summary>
+			static Options Ring(size_t ringSize = LogRing::DefaultSize) noexcept
+			{
+				Options o;
+				o.ringSize = ringSize;
+				return o;
+			}
+		};
+
+	private:
+
+		FlushPolicy m_flushPolicy;
+
+		/// <summary>
+		/// Location and naming of the log files, for the rotation; set during construction only
+		/// </summary>
+		std::filesystem::path m_directory;
+		std::wstring m_name;
+		std::wstring m_ext;
+		int m_retention{ 0 };
+		WriteMode m_writeMode{ WriteMode::File };
+		size_t m_segmentSize{ 0 };
+		FileNaming m_naming{ FileNaming::Numbered };
+
+		/// <summary>
+		/// Set while the log file is still to be opened by the first message, see `Options::lazyOpen`
+		/// </summary>
+		mutable std::atomic<bool> m_openPending{ false };
+
+		/// <summary>
+		/// State of the rotation, only used under the thread lock
+		/// </summary>
+		RotationPolicy m_rotationPolicy;
+		bool m_rotationActive{ false };
+		bool m_maintenanceStop{ false };
+		mutable file_t m_successorFile{ invalidFile() };
+		mutable file_t m_retiredFile{ invalidFile() };
+		mutable uint64_t m_fileSize{ 0 };
+		mutable uint64_t m_preambleSize{ 0 };
+		mutable std::chrono::steady_clock::time_point m_fileOpened{ std::chrono::steady_clock::now() };
+		mutable std::condition_variable m_maintenanceSignal;
+		std::thread m_maintenanceThread;
+
+		/// <summary>
+		/// The format definition records written so far, in `FileFormat::Binary`; only used under the thread lock
+		/// </summary>
+		mutable std::string m_formatRecords;
+
+		/// <summary>
+		/// Settings for the time stamps of all messages; applied to the formatter of each writing thread
+		/// </summary>
+		std::atomic<bool> m_utcTimeStamps{ false };
+		std::atomic<TimeStampFormatter::Precision> m_timeStampPrecision{ TimeStampFormatter::Precision::Seconds };
+		mutable size_t m_unflushedBytes{ 0 };
+		mutable std::chrono::steady_clock::time_point m_lastFlush{ std::chrono::steady_clock::now() };
+
+	public:
+
+#if 1 /* REGION: default configuration values */
+
+		/// <summary>
+		/// Returns the default directory where log files are stored.
+		///
+		/// These locations are tested in this priority order:
+		/// 1) "%appdata%\LocalLow\sgrottel_simplelog", or on POSIX systems "$XDG_STATE_HOME/sgrottel_simplelog" defaulting to "~/.local/state/sgrottel_simplelog"
+		/// 2) "logs" subfolder of the location of the process' executing assembly
+		/// 3) the localion of the process' executing assembly
+		/// 4) "logs" subfolder of the current working directory
+		/// 5) the current working directory
+		/// </summary>
+		/// <returns>The default path where log files are stored</returns>
+		/// <remarks>The locations are tested on the first call only, and the result is kept for the lifetime of the process.
+		/// The function creates folders and files to test access rights. It removes all files and folders again.
+		/// If the file system access rights allow for creation but not for deletion, empty test files or folders might stay behind.
+		/// </remarks>
+		static std::filesystem::path GetDefaultDirectory()
+		{
+			static std::filesystem::path const directory = findDefaultDirectory();
+			return directory;
+		}
+
+		/// <summary>
+		/// Determines the default name for log files of this process.
+		/// The value is based on the process' executing assembly.
+		/// </summary>
+		/// <returns>The default name for log files of this process</returns>
+		/// <remarks>The value is determined on the first call only, and kept for the lifetime of the process.</remarks>
+		static std::filesystem::path GetDefaultName()
+		{
+			static std::filesystem::path const name = findDefaultName();
+			return name;
+		}
+
+		/// <summary>
+		/// Gets the default retention, i.e. how many previous log files are kept in the target directory in addition to the current log file
+		/// </summary>
+		/// <returns>The default log file retention count.</returns>
+		static inline constexpr int GetDefaultRetention()
+		{
+			return 10;
+		}
+
+#endif
+
+	private:
+
+		/// <summary>
+		/// Tests if files can be created in the directory, by creating and closing a temporary file without writing to it
+		/// </summary>
+		static bool canCreateFiles(std::filesystem::path const& path)
+		{
+#if defined(SIMPLELOG_WINDOWS)
+			// access rights on Windows depend on ACLs, so only an actual file creation is a reliable test
+			std::filesystem::path const file = path / ("simplelog_" + std::to_string(GetCurrentProcessId()) + ".tmp");
+			HANDLE h = ::CreateFileW(file.wstring().c_str(), GENERIC_WRITE, 0, NULL, CREATE_NEW, FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+			if (h == INVALID_HANDLE_VALUE) return false;
+			::CloseHandle(h);
+			return true;
+#else
+			return ::access(path.c_str(), W_OK | X_OK) == 0;
+#endif
+		}
+
+		static std::filesystem::path findDefaultDirectory()
+		{
+			std::filesystem::path createdDir;
+			auto cleanDirGuard = [&](std::filesystem::path const& otherPath)
+				{
+					if (!createdDir.empty())
+					{
+						if (std::filesystem::is_directory(createdDir))
+						{
+							std::filesystem::remove_all(createdDir);
+						}
+						createdDir.clear();
+					}
+					return otherPath;
+				};
+			std::filesystem::path parent, path;
+
+			parent = getUserDataPath();
+			if (!parent.empty())
+			{
+				if (std::filesystem::is_directory(parent))
+				{
+					path = parent / "sgrottel_simplelog";
+					if (!std::filesystem::is_directory(path))
+					{
+						try
+						{
+							std::filesystem::create_directory(path);
+							createdDir = path;
+						}
+						catch (...) {}
+					}
+					if (std::filesystem::is_directory(path))
+					{
+						if (canCreateFiles(path))
+						{
+							return cleanDirGuard(path);
+						}
+					}
+					cleanDirGuard("");
+				}
+			}
+
+			parent = getProcessPath();
+			if (!parent.empty())
+			{
+				parent = parent.parent_path();
+				if (std::filesystem::is_directory(parent))
+				{
+					path = parent / "logs";
+					if (!std::filesystem::is_directory(path))
+					{
+						try
+						{
+							std::filesystem::create_directory(path);
+							createdDir = path;
+						}
+						catch (...) {}
+					}
+					if (std::filesystem::is_directory(path))
+					{
+						if (canCreateFiles(path))
+						{
+							return cleanDirGuard(path);
+						}
+					}
+					cleanDirGuard("");
+					if (canCreateFiles(parent))
+					{
+						return parent;
+					}
+				}
+			}
+
+			parent = std::filesystem::current_path();
+			path = parent / "logs";
+			if (!std::filesystem::is_directory(path))
+			{
+				try
+				{
+					std::filesystem::create_directory(path);
+					createdDir = path;
+				}
+				catch(...) {}
+			}
+			if (std::filesystem::is_directory(path))
+			{
+				if (canCreateFiles(path))
+				{
+					return cleanDirGuard(path);
+				}
+			}
+			cleanDirGuard("");
+
+			return parent;
+		}
+
+		static std::filesystem::path findDefaultName()
+		{
+			std::filesystem::path procPath = getProcessPath();
+			if (!procPath.empty())
+			{
+				return procPath.filename().replace_extension();
+			}
+#if defined(SIMPLELOG_WINDOWS)
+			return std::to_string(GetCurrentProcessId());
+#else
+			return std::to_string(::getpid());
+#endif
+		}
+
+	public:
+
+		/// <summary>
+		/// Gets the name of the mutex serializing the retention renames of the log files of one name in one directory, on Windows.
+		/// The CSharp implementation derives the same name.
+		/// </summary>
+		/// <param name="fullPath">The full path of the log files without file name extension, as returned by `GetFullPathNameW`</param>
+		/// <remarks>
+		/// Mutex names must not contain backslashes, so the name is derived from the FNV-1a hash of the UTF16 code units of the path.
+		/// Only ASCII letters are lower-cased, as case mappings of other characters depend on the runtime and its version.
+		/// </remarks>
+		static std::wstring GetSetupMutexName(std::wstring const& fullPath)
+		{
+			uint64_t hash = 14695981039346656037ull;
+			auto const add = [&hash](uint32_t unit) { hash = (hash ^ unit) * 1099511628211ull; };
+			for (wchar_t c : fullPath)
+			{
+				uint32_t unit = static_cast<uint32_t>(c);
+				if (unit >= L'A' && unit <= L'Z')
+				{
+					unit += L'a' - L'A';
+				}
+				if (unit > 0xffff)
+				{
+					// surrogate pair, for 32 bit wchar_t
+					unit -= 0x10000;
+					add(0xd800 + (unit >> 10));
+					add(0xdc00 + (unit & 0x3ff));
+					continue;
+				}
+				add(unit);
+			}
+			wchar_t mutexName[64];
+			swprintf(mutexName, 64, L"SGROTTEL_SIMPLELOG_%016llx", static_cast<unsigned long long>(hash));
+			return mutexName;
+		}
+
+		/// <summary>
+		/// Creates a SimpleLog with default values for directory, name, and retention
+		/// </summary>
+		SimpleLog() : SimpleLog(GetDefaultDirectory(), GetDefaultName(), GetDefaultRetention()) { }
+
+		/// <summary>
+		/// Creates a SimpleLog with default values for directory, name, and retention
+		/// </summary>
+		/// <param name="options">Options how the log file is written</param>
+		explicit SimpleLog(Options const& options) : SimpleLog(GetDefaultDirectory(), GetDefaultName(), GetDefaultRetention(), options) { }
+
+		/// <summary>
+		/// Creates a SimpleLog instance.
+		/// </summary>
+		/// <param name="directory">The directory where log files are stored</param>
+		/// <param name="name">The name for log files of this process without file name extension</param>
+		/// <param name="retention">The default log file retention count; must be 2 or larger</param>
+		SimpleLog(std::filesystem::path const& directory, std::filesystem::path const& name, int retention)
+			: SimpleLog(directory, name, retention, Options{})
+		{
+		}
+
+		/// <summary>
+		/// Creates a SimpleLog instance.
+		/// </summary>
+		/// <param name="directory">The directory where log files are stored</param>
+		/// <param name="name">The name for log files of this process without file name extension</param>
+		/// <param name="retention">The default log file retention count; must be 2 or larger</param>
+		/// <param name="options">Options how the log file is written</param>
+		SimpleLog(std::filesystem::path const& directory, std::filesystem::path const& name, int retention, Options const& options)
+		{
+			// memory-only writer
+			if (directory.empty() && name.empty())
+			{
+				// m_file stays closed
+				if (options.ringSize > 0)
+				{
+					m_ring = std::make_unique<LogRing>(options.ringSize);
+					std::lock_guard<std::mutex> lock{ m_threadLock };
+					updateEnabledLevelsUnderLock();
+				}
+				return;
+			}
+
+			// check arguments
+			if (directory.empty()) throw std::invalid_argument("directory");
+			if (name.empty()) throw std::invalid_argument("name");
+			{
+				std::string dirStr = directory.string();
+				if (std::all_of(dirStr.begin(), dirStr.end(), isspace)) throw std::invalid_argument("directory");
+			}
+			{
+				std::string nameStr = name.string();
+				if (std::all_of(nameStr.begin(), nameStr.end(), isspace)) throw std::invalid_argument("name");
+			}
+			if (retention < 2) throw std::out_of_range("retention must be 2 or larger");
+
+			m_directory = directory;
+			m_name = name.wstring();
+			m_ext = (options.fileFormat == FileFormat::Binary) ? L".slb" : L".log";
+			m_retention = retention;
+			m_writeMode = options.writeMode;
+			m_segmentSize = options.segmentSize;
+			m_naming = options.naming;
+			m_binary = (options.fileFormat == FileFormat::Binary);
+
+			std::lock_guard<std::mutex> lock{ m_threadLock };
+			if (options.lazyOpen)
+			{
+				m_openPending.store(true, std::memory_order_relaxed);
+			}
+			else
+			{
+				openFileUnderLock();
+			}
+			updateEnabledLevelsUnderLock();
+		}
+
+		SimpleLog(const SimpleLog&) = delete;
+		SimpleLog(SimpleLog&&) = delete;
+		SimpleLog& operator=(const SimpleLog&) = delete;
+		SimpleLog& operator=(SimpleLog&&) = delete;
+
+		virtual ~SimpleLog()
+		{
+			if (m_maintenanceThread.joinable())
+			{
+				{
+					std::lock_guard<std::mutex> lock{ m_threadLock };
+					m_maintenanceStop = true;
+				}
+				m_maintenanceSignal.notify_one();
+				m_maintenanceThread.join();
+			}
+
+			std::lock_guard<std::mutex> lock{m_threadLock};
+			try
+			{
+				if (m_file != invalidFile())
+				{
+					if (m_mapped)
+					{
+						m_mapped->Close();
+						m_mapped.reset();
+					}
+					flushUnderLock();
+					closeFile(m_file);
+					m_file = invalidFile();
+					updateEnabledLevelsUnderLock();
+				}
+			}
+			catch (...) {}
+		}
+
+		std::filesystem::path GetFilePath() const
+		{
+			std::lock_guard<std::mutex> lock{ m_threadLock };
+			if (m_file == invalidFile())
+			{
+				return {};
+			}
+
+#if defined(SIMPLELOG_POSIX)
+			// the link follows renames of the file
+			std::error_code ec;
+			std::filesystem::path path = std::filesystem::read_symlink("/proc/self/fd/" + std::to_string(m_file), ec);
+			if (!ec && !path.empty())
+			{
+				return path;
+			}
+			return m_filePath;
+#else
+			std::vector<wchar_t> strBuf;
+			DWORD rv = GetFinalPathNameByHandleW(m_file, strBuf.data(), static_cast<DWORD>(strBuf.size()), FILE_NAME_NORMALIZED);
+			if (rv == 0)
+			{
+				DWORD le = GetLastError();
+				std::string msg = "Failed query log file path: " + std::to_string(le);
+				throw std::runtime_error(msg.c_str());
+			}
 
-		NullLog(const NullLog&) = delete;
-		NullLog(NullLog&&) = delete;
-		NullLog& operator=(const NullLog&) = delete;
-		NullLog& operator=(NullLog&&) = delete;
+			if (static_cast<size_t>(rv) > strBuf.size())
+			{
+				strBuf.resize(rv);
+				rv = GetFinalPathNameByHandleW(m_file, strBuf.data(), static_cast<DWORD>(strBuf.size()), FILE_NAME_NORMALIZED);
+				if (rv == 0)
+				{
+					DWORD le = GetLastError();
+					std::string msg = "Failed query log file path 2: " + std::to_string(le);
+					throw std::runtime_error(msg.c_str());
+				}
 
-	protected:
-		void WriteImpl(uint32_t /*flags*/, char const* /*message*/, size_t /*messageLength*/) const override
+				if (static_cast<size_t>(rv) > strBuf.size())
+				{
+					throw std::runtime_error("Failed query log file path 2: memory allocation failure");
+				}
+			}
+
+			return std::filesystem::path{ strBuf.data(), strBuf.data() + rv };
+#endif
+		}
+
+		/// <summary>
+		/// Gets the policy when the log file is flushed to the storage device
+		/// </summary>
+		FlushPolicy GetFlushPolicy() const
 		{
-			// intentionally empty
-			// omitting all messages
+			std::lock_guard<std::mutex> lock{ m_threadLock };
+			return m_flushPolicy;
 		}
-		void WriteImpl(uint32_t /*flags*/, wchar_t const* /*message*/, size_t /*messageLength*/) const override
+
+		/// <summary>
+		/// Sets the policy when the log file is flushed to the storage device
+		/// </summary>
+		void SetFlushPolicy(FlushPolicy const& flushPolicy)
 		{
-			// intentionally empty
-			// omitting all messages
+			std::lock_guard<std::mutex> lock{ m_threadLock };
+			m_flushPolicy = flushPolicy;
 		}
-	};
 
-	/// <summary>
-	/// SimpleLog implementation
-	/// </summary>
-	class SimpleLog : public ISimpleLog
-	{
-	private:
+		/// <summary>
+		/// Gets the policy when the log file is rotated
+		/// </summary>
+		RotationPolicy GetRotationPolicy() const
+		{
+			std::lock_guard<std::mutex> lock{ m_threadLock };
+			return m_rotationPolicy;
+		}
 
-		static std::string timeStampA()
+		/// <summary>
+		/// Sets the policy when the log file is rotated.
+		/// The first policy with an enabled condition starts the background thread of the rotation.
+		/// </summary>
+		void SetRotationPolicy(RotationPolicy const& rotationPolicy)
 		{
-			time_t t = std::time(nullptr);
-			struct tm now;
-			localtime_s(&now, &t);
-			return formatString("%d-%.2d-%.2d %.2d:%.2d:%.2dZ", now.tm_year + 1900, now.tm_mon + 1, now.tm_mday, now.tm_hour, now.tm_min, now.tm_sec);
+			std::lock_guard<std::mutex> lock{ m_threadLock };
+			m_rotationPolicy = rotationPolicy;
+			m_rotationActive = (m_rotationPolicy.maxBytes > 0 || m_rotationPolicy.maxSeconds > 0)
+				&& (m_file != invalidFile() || m_openPending.load(std::memory_order_relaxed)) && m_writeMode == WriteMode::File;
+			// with `Options::lazyOpen`, the thread is started when the log file is opened
+			if (m_rotationActive && m_file != invalidFile() && !m_maintenanceThread.joinable())
+			{
+				m_maintenanceThread = std::thread{ &SimpleLog::maintenanceThread, this };
+			}
+			m_maintenanceSignal.notify_one();
 		}
 
-		static std::filesystem::path getProcessPath()
+		/// <summary>
+		/// Gets the flag whether or not concurrent writers are coalesced into one write and one flush
+		/// </summary>
+		bool GetGroupCommit() const noexcept
 		{
-			// Visual Cpp specific
-			wchar_t filename[MAX_PATH + 1];
-			DWORD filenameLen = GetModuleFileNameW(nullptr, filename, MAX_PATH);
-			if (filenameLen > 0)
+			return m_groupCommit.load(std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		/// Sets the flag whether or not concurrent writers are coalesced into one write and one flush, e.g. to flush after every message with many threads.
+		/// The first thread reaching the log file writes the lines queued by all threads meanwhile, and flushes once according to the flush policy.
+		/// Each write function still returns only after its line is written and flushed.
+		/// Not applied in `WriteMode::MemoryMapped`.
+		/// </summary>
+		void SetGroupCommit(bool groupCommit) noexcept
+		{
+			m_groupCommit.store(groupCommit, std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		/// Gets the minimum level of messages to be written
+		/// </summary>
+		uint32_t GetMinLevel() const
+		{
+			std::lock_guard<std::mutex> lock{ m_threadLock };
+			return m_minLevel;
+		}
+
+		/// <summary>
+		/// Sets the minimum level of messages to be written, e.g. `FlagLevelWarning`.
+		/// Less severe messages are discarded before they are formatted. The default is `FlagLevelDetail`, i.e. all messages are written.
+		/// </summary>
+		void SetMinLevel(uint32_t level)
+		{
+			std::lock_guard<std::mutex> lock{ m_threadLock };
+			m_minLevel = level & FlagLevelMask;
+			updateEnabledLevelsUnderLock();
+		}
+
+		/// <summary>
+		/// Gets the resolution of the time stamps of all messages
+		/// </summary>
+		TimeStampFormatter::Precision GetTimeStampPrecision() const
+		{
+			return m_timeStampPrecision.load(std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		/// Sets the resolution of the time stamps of all messages. The default is seconds.
+		/// </summary>
+		void SetTimeStampPrecision(TimeStampFormatter::Precision precision)
+		{
+			m_timeStampPrecision.store(precision, std::memory_order_relaxed);
+			// a log file opened later starts with the new settings
+			if (m_binary && !m_openPending.load(std::memory_order_acquire)) writeHeaderRecord();
+		}
+
+		/// <summary>
+		/// Gets the flag whether or not the time stamps of all messages are in UTC
+		/// </summary>
+		bool GetUseUtcTimeStamps() const
+		{
+			return m_utcTimeStamps.load(std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		/// Sets the flag whether or not the time stamps of all messages are in UTC. The default is local time.
+		/// </summary>
+		void SetUseUtcTimeStamps(bool utc)
+		{
+			m_utcTimeStamps.store(utc, std::memory_order_relaxed);
+			// a log file opened later starts with the new settings
+			if (m_binary && !m_openPending.load(std::memory_order_acquire)) writeHeaderRecord();
+		}
+
+		/// <summary>
+		/// Gets the runtime statistics of this log.
+		/// In `WriteMode::MemoryMapped`, messages are copied without write calls and without a lock.
+		/// </summary>
+		LogStats GetStats() const
+		{
+			return m_stats.Snapshot();
+		}
+
+		/// <summary>
+		/// Gets a copy of the complete lines in the in-memory ring of a memory-only log, see `Options::Ring`
+		/// </summary>
+		/// <returns>The lines, or an empty string if the log has no ring</returns>
+		std::string GetRingContent() const
+		{
+			if (!m_ring) return {};
+			return m_ring->GetContent();
+		}
+
+		/// <summary>
+		/// Writes the complete lines in the in-memory ring of a memory-only log to a file, replacing its content
+		/// </summary>
+		/// <param name="path">The path of the file</param>
+		/// <returns>True if the file was written</returns>
+		bool DumpRing(std::filesystem::path const& path) const
+		{
+			if (!m_ring) return false;
+			std::string const content = m_ring->GetContent();
+			std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+			file.write(content.data(), static_cast<std::streamsize>(content.size()));
+			file.close();
+			return !file.fail();
+		}
+
+		/// <summary>
+		/// Passes the complete lines in the in-memory ring of a memory-only log to a callback, without allocating memory, e.g. from a crash handler.
+		/// See `LogRing::Dump`.
+		/// </summary>
+		/// <param name="callback">Called with the data and its length in bytes, once or twice per line</param>
+		void DumpRing(std::function<void(char const* data, size_t len)> const& callback) const
+		{
+			if (!m_ring) return;
+			m_ring->Dump(callback);
+		}
+
+		/// <summary>
+		/// Flushes all messages written so far to the storage device
+		/// </summary>
+		void Flush() const
+		{
+			std::lock_guard<std::mutex> lock{ m_threadLock };
+			if (m_file == invalidFile()) return;
+			if (m_mapped)
 			{
-				return std::filesystem::path{ filename, filename + filenameLen };
+				auto const start = std::chrono::steady_clock::now();
+				m_mapped->Flush();
+				m_stats.CountFlush(std::chrono::steady_clock::now() - start);
+				return;
 			}
-			filenameLen = GetProcessImageFileNameW(GetCurrentProcess(), filename, MAX_PATH);
-			if (filenameLen > 0)
+			flushUnderLock();
+		}
+
+	protected:
+#if 1 /* REGION: implementation of ISampleLog */
+
+		/// <summary>
+		/// Write a message to the log
+		/// </summary>
+		/// <param name="flags">The message flags</param>
+		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
+		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.</param>
+		void WriteImpl(uint32_t flags, char const* message, size_t messageLength) const override
+		{
+			if (!isAccepted(flags)) return;
+
+			// only the write of the complete line is serialized
+			LineBuffer const& buf = m_binary
+				? assembleTextRecord(flags, message, messageLength)
+				: assembleLine(flags, message, messageLength);
+			writeLine(flags, buf.line.data(), buf.line.size(), true);
+		}
+
+		/// <summary>
+		/// Write a message to the log
+		/// </summary>
+		/// <param name="flags">The message flags</param>
+		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
+		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.</param>
+		void WriteImpl(uint32_t flags, wchar_t const* message, size_t messageLength) const override
+		{
+			if (!isAccepted(flags)) return;
+
+			// only the write of the complete line is serialized
+			LineBuffer const& buf = m_binary
+				? assembleTextRecord(flags, message, messageLength)
+				: assembleLine(flags, message, messageLength);
+			writeLine(flags, buf.line.data(), buf.line.size(), true);
+		}
+
+		/// <summary>
+		/// Checks if a message with these flags would be written at all
+		/// </summary>
+		/// <param name="flags">The message flags</param>
+		/// <returns>False if the log file is not open, or if the level is less severe than the minimum level</returns>
+		bool IsEnabledImpl(uint32_t flags) const override
+		{
+			return ((m_enabledLevels.load(std::memory_order_relaxed) >> (flags & FlagLevelMask)) & 1u) != 0;
+		}
+
+		/// <summary>
+		/// Checks if printf-based messages are recorded unformatted, i.e. if the file format is binary
+		/// </summary>
+		bool IsDeferredFormattingImpl() const override
+		{
+			return m_binary;
+		}
+
+		/// <summary>
+		/// Writes a message record with the format id and the encoded arguments
+		/// </summary>
+		/// <returns>False if the table of format strings is full, and the message is to be written as text</returns>
+		bool WriteDeferredImpl(uint32_t flags, char const* format, char const* args, size_t argsLength) const override
+		{
+			if (!isAccepted(flags)) return true;
+			uint32_t id = 0;
+			if (!formatId(flags, format, id)) return false;
+
+			LineBuffer& buf = threadLineBuffer();
+			buf.line.clear();
+			appendRecordHeader(buf.line, BinaryLogFormat::RecordType::Message, sizeof(int64_t) + 2 * sizeof(uint32_t) + argsLength);
+			appendValue(buf.line, nowNanoseconds());
+			appendValue(buf.line, flags);
+			appendValue(buf.line, id);
+			buf.line.append(args, argsLength);
+			writeLine(flags, buf.line.data(), buf.line.size(), true);
+			return true;
+		}
+
+#endif
+	};
+
+	/// <summary>
+	/// Decodes binary log files, see `SimpleLog::FileFormat::Binary`, into the text format of SimpleLog
+	/// </summary>
+	/// <remarks>
+	/// Printf-based messages are formatted with the printf implementation of the decoding system.
+	/// Integer, floating point, and string arguments are formatted as on the writing system.
+	/// Local time stamps are formatted in the time zone of the decoding system.
+	/// </remarks>
+	class BinaryLogDecoder
+	{
+	public:
+		BinaryLogDecoder() = delete;
+
+		/// <summary>
+		/// Decodes a binary log file
+		/// </summary>
+		/// <param name="in">The binary log file content</param>
+		/// <param name="out">Receives the text lines</param>
+		/// <param name="diagnostic">Optional; receives the reason if decoding stopped at an incomplete record, and is cleared otherwise</param>
+		/// <returns>The number of decoded messages</returns>
+		/// <remarks>
+		/// Decoding stops at the first incomplete record, e.g. at the end of the file of a terminated process,
+		/// or at a corrupt record length exceeding the input.
+		/// Throws a `std::runtime_error` if the input is not a binary log file.
+		/// </remarks>
+		static size_t Decode(std::istream& in, std::ostream& out, std::string* diagnostic = nullptr)
+		{
+			if (diagnostic != nullptr) diagnostic->clear();
+			char magic[sizeof(BinaryLogFormat::Magic)];
+			if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, BinaryLogFormat::Magic, sizeof(magic)) != 0)
 			{
-				return std::filesystem::path{ filename, filename + filenameLen };
+				throw std::runtime_error("Not a SimpleLog binary log file");
 			}
-			if (__argv != nullptr && __argv[0] != nullptr && __argv[0][0] != 0)
+
+			TimeStampFormatter timeStamp;
+			size_t wcharSize = sizeof(wchar_t);
+			std::map<uint32_t, std::string> formats;
+			std::string payload;
+			std::string text;
+			size_t count = 0;
+			uint64_t offset = sizeof(magic);
+
+			for (;;)
 			{
-				return std::filesystem::path{ __argv[0] };
+				char header[BinaryLogFormat::RecordHeaderSize];
+				if (!in.read(header, sizeof(header)))
+				{
+					// zero bytes after the last record of a memory-mapped log file are no incomplete record
+					size_t const available = static_cast<size_t>(in.gcount());
+					if (std::any_of(header, header + available, [](char c) { return c != 0; }))
+					{
+						setDiagnostic(diagnostic, offset, sizeof(header), available);
+					}
+					break;
+				}
+				auto const type = static_cast<BinaryLogFormat::RecordType>(header[0]);
+				uint32_t len;
+				std::memcpy(&len, header + 1, sizeof(uint32_t));
+				if (!readPayload(in, payload, len))
+				{
+					setDiagnostic(diagnostic, offset, sizeof(header) + static_cast<size_t>(len), sizeof(header) + payload.size());
+					break;
+				}
+				offset += sizeof(header) + len;
+				Reader r{ payload.data(), payload.data() + payload.size() };
+
+				switch (type)
+				{
+				case BinaryLogFormat::RecordType::Header:
+				{
+					if (len < 8)
+					{
+						// zero bytes after the last record of a memory-mapped log file
+						return count;
+					}
+					uint32_t mark;
+					std::memcpy(&mark, payload.data() + 4, sizeof(uint32_t));
+					if (mark != BinaryLogFormat::ByteOrderMark)
+					{
+						throw std::runtime_error("Binary log file written with different byte order");
+					}
+					wcharSize = static_cast<uint8_t>(payload[1]);
+					timeStamp.SetUtc(payload[2] != 0);
+					timeStamp.SetPrecision(static_cast<TimeStampFormatter::Precision>(payload[3]));
+					break;
+				}
+				case BinaryLogFormat::RecordType::Format:
+				{
+					uint32_t id = 0;
+					if (!r.Get(id)) break;
+					formats[id].assign(r.pos, r.end);
+					break;
+				}
+				case BinaryLogFormat::RecordType::Message:
+				case BinaryLogFormat::RecordType::Text:
+				{
+					int64_t time = 0;
+					uint32_t flags = 0;
+					if (!r.Get(time) || !r.Get(flags)) break;
+					text.clear();
+					if (type == BinaryLogFormat::RecordType::Text)
+					{
+						text.assign(r.pos, r.end);
+					}
+					else
+					{
+						uint32_t id = 0;
+						if (!r.Get(id)) break;
+						auto const format = formats.find(id);
+						if (format == formats.end()) break;
+						formatMessage(text, format->second, r, wcharSize);
+					}
+
+					char ts[TimeStampFormatter::MaxLength];
+					size_t const tsLen = timeStamp.Format(ts, std::chrono::system_clock::time_point{
+						std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds{ time }) });
+					std::string_view const tag = SimpleLog::levelTag(flags);
+					out.write(ts, static_cast<std::streamsize>(tsLen));
+					out.write(tag.data(), static_cast<std::streamsize>(tag.size()));
+					out.write(text.data(), static_cast<std::streamsize>(text.size()));
+					out.put('\n');
+					++count;
+					break;
+				}
+				default:
+					// unknown record types of newer versions are skipped
+					break;
+				}
 			}
-			if (__wargv != nullptr && __wargv[0] != nullptr && __wargv[0][0] != 0)
+			return count;
+		}
+
+	private:
+
+		/// <summary>
+		/// Reads the payload of a record.
+		/// The length is read from the input, so the payload only grows with the bytes actually read, and not to a corrupt length at once.
+		/// </summary>
+		/// <returns>False if the input ends before the payload</returns>
+		static bool readPayload(std::istream& in, std::string& payload, uint32_t len)
+		{
+			constexpr size_t chunk = 64 * 1024;
+			payload.clear();
+			while (payload.size() < len)
 			{
-				return std::filesystem::path{ __wargv[0] };
+				size_t const pos = payload.size();
+				size_t const size = std::min<size_t>(len - pos, chunk);
+				payload.resize(pos + size);
+				if (!in.read(payload.data() + pos, static_cast<std::streamsize>(size)))
+				{
+					payload.resize(pos + static_cast<size_t>(in.gcount()));
+					return false;
+				}
 			}
-			return {};
+			return true;
+		}
+
+		static void setDiagnostic(std::string* diagnostic, uint64_t offset, size_t expected, size_t available)
+		{
+			if (diagnostic == nullptr) return;
+			*diagnostic = "Incomplete record at byte " + std::to_string(offset) + ": " + std::to_string(expected) + " bytes expected, "
+				+ std::to_string(available) + " bytes available";
 		}
 
 		/// <summary>
-		/// Utility class to release native resources in a RAII fashion
+		/// Reads values from a record payload
 		/// </summary>
-		template<typename func_t>
-		class scope_exit
+		struct Reader
 		{
-		public:
-			scope_exit(func_t&& f) : m_f(std::move(f)) {}
-			~scope_exit()
+			char const* pos;
+			char const* end;
+
+			template<typename T>
+			bool Get(T& value) noexcept
 			{
-				m_f();
+				if (static_cast<size_t>(end - pos) < sizeof(T)) return false;
+				std::memcpy(&value, pos, sizeof(T));
+				pos += sizeof(T);
+				return true;
 			}
-		private:
-			func_t m_f;
 		};
 
-		HANDLE m_file{ INVALID_HANDLE_VALUE };
-
-		static void toUtf8UnderLock(const char*& outUtf8Str, size_t& outUtf8StrLen, const wchar_t* str, size_t len)
+		/// <summary>
+		/// A decoded argument
+		/// </summary>
+		struct Arg
 		{
-			// even if all chars would be 7bit we still would need to copy due to the padding
-			static std::string utf8Str;
-			outUtf8StrLen = WideCharToMultiByte(CP_UTF8, 0, str, static_cast<int>(len), nullptr, 0, nullptr, nullptr);
-			utf8Str.resize(outUtf8StrLen, '\0');
-			WideCharToMultiByte(CP_UTF8, 0, str, static_cast<int>(len), utf8Str.data(), static_cast<int>(outUtf8StrLen), nullptr, nullptr);
-			outUtf8Str = utf8Str.c_str();
-		}
+			BinaryLogFormat::ArgType type{ 0 };
+			uint64_t bits{ 0 };
+			double d{ 0.0 };
+			std::string str;
+		};
 
-		static void toUtf8UnderLock(const char*& outUtf8Str, size_t& outUtf8StrLen, const char* str, size_t len)
+		static bool readArg(Reader& r, Arg& arg, size_t wcharSize)
 		{
-			bool all7Bit = true;
-			for (size_t i = 0; i < len; ++i)
+			uint8_t type = 0;
+			if (!r.Get(type)) return false;
+			arg.type = static_cast<BinaryLogFormat::ArgType>(type);
+			switch (arg.type)
 			{
-				if (str[i] > 127)
-				{
-					all7Bit = false;
-					break;
-				}
-			}
-			if (all7Bit)
+			case BinaryLogFormat::ArgType::Int32:
+			case BinaryLogFormat::ArgType::UInt32:
 			{
-				outUtf8Str = str;
-				outUtf8StrLen = len;
+				uint32_t v = 0;
+				if (!r.Get(v)) return false;
+				arg.bits = v;
+				return true;
 			}
-			else
+			case BinaryLogFormat::ArgType::Int64:
+			case BinaryLogFormat::ArgType::UInt64:
+			case BinaryLogFormat::ArgType::Pointer:
+				return r.Get(arg.bits);
+			case BinaryLogFormat::ArgType::Double:
+				return r.Get(arg.d);
+			case BinaryLogFormat::ArgType::String:
+			case BinaryLogFormat::ArgType::WideString:
 			{
-				// full conversion needed
-				int size = MultiByteToWideChar(CP_ACP, MB_COMPOSITE, str, static_cast<int>(len), nullptr, 0);
-				std::wstring wStr(size, '\0');
-				MultiByteToWideChar(CP_ACP, MB_COMPOSITE, str, static_cast<int>(len), wStr.data(), size);
-				toUtf8UnderLock(outUtf8Str, outUtf8StrLen, wStr.c_str(), size);
+				uint32_t len = 0;
+				if (!r.Get(len)) return false;
+				size_t const unit = (arg.type == BinaryLogFormat::ArgType::String) ? 1 : wcharSize;
+				if (unit != 1 && unit != 2 && unit != 4) return false;
+				if (static_cast<size_t>(r.end - r.pos) < len * unit) return false;
+				if (unit == 1)
+				{
+					arg.str.assign(r.pos, len);
+				}
+				else
+				{
+					// wide strings are converted to UTF8, also if wchar_t of the decoding system has another size
+					std::wstring wide(len, L'\0');
+					for (uint32_t i = 0; i < len; ++i)
+					{
+						uint32_t c = 0;
+						std::memcpy(&c, r.pos + i * unit, unit);
+						wide[i] = static_cast<wchar_t>(c);
+					}
+					Utf8Encoding::FromWide(arg.str, wide.data(), wide.size());
+				}
+				r.pos += len * unit;
+				return true;
+			}
+			default:
+				return false;
 			}
 		}
 
-		void writeImplUnderLock(uint32_t flags, char const* msgUtf8, size_t msgUtf8Len) const
+		static bool isSigned(BinaryLogFormat::ArgType type) noexcept
 		{
-			// assumptions:
-			//  m_file != INVALID_HANDLE_VALUE
-			//  msgUtf8 != nullptr
-			//  msgUtf8Len > 0
-			//  any returns of timeStampA and all local strings and characters in this function are valid UTF8 (7-bit ASCII)
-			std::string ts = timeStampA();
-			size_t bufSize = ts.size();
+			return type == BinaryLogFormat::ArgType::Int32 || type == BinaryLogFormat::ArgType::Int64;
+		}
 
-			const char* typeStr = "";
-			size_t typeStrLen = 0;
-			if ((flags & FlagLevelMask) == FlagLevelCritical)
-			{
-				typeStr = "CRITICAL";
-				typeStrLen = 8;
-			}
-			else if ((flags & FlagLevelMask) == FlagLevelError)
+		static bool isInteger(BinaryLogFormat::ArgType type) noexcept
+		{
+			return type == BinaryLogFormat::ArgType::Int32 || type == BinaryLogFormat::ArgType::UInt32
+				|| type == BinaryLogFormat::ArgType::Int64 || type == BinaryLogFormat::ArgType::UInt64;
+		}
+
+		/// <summary>
+		/// Gets the value of an integer argument, as it would be interpreted by a conversion with this signedness and length modifier
+		/// </summary>
+		static uint64_t integerValue(Arg const& arg, bool asSigned, std::string_view length) noexcept
+		{
+			bool const is32 = arg.type == BinaryLogFormat::ArgType::Int32 || arg.type == BinaryLogFormat::ArgType::UInt32;
+			uint64_t v = arg.bits;
+			if (is32)
 			{
-				typeStr = "ERROR";
-				typeStrLen = 5;
+				v = (asSigned) ? static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(static_cast<uint32_t>(v)))) : static_cast<uint32_t>(v);
 			}
-			else if ((flags & FlagLevelMask) == FlagLevelWarning)
+			if (length == "hh")
 			{
-				typeStr = "WARNING";
-				typeStrLen = 7;
+				v = (asSigned) ? static_cast<uint64_t>(static_cast<int64_t>(static_cast<signed char>(v))) : static_cast<unsigned char>(v);
 			}
-			else if ((flags & FlagLevelMask) == FlagLevelDetail)
+			else if (length == "h")
 			{
-				typeStr = "DETAIL";
-				typeStrLen = 6;
+				v = (asSigned) ? static_cast<uint64_t>(static_cast<int64_t>(static_cast<short>(v))) : static_cast<unsigned short>(v);
 			}
+			return v;
+		}
 
-			bufSize += typeStrLen;
-			bufSize += msgUtf8Len;
-			bufSize += 3; // pipe, space, new line
-
-			// reuse static buffer to avoid reallocations
-			static std::vector<char> buf;
-			buf.resize(bufSize);
-
-			size_t pos = 0;
-			memcpy(buf.data(), ts.c_str(), ts.size());
-			pos += ts.size();
-			buf.data()[pos++] = '|';
-			if (typeStrLen > 0)
+		template<typename ...PARAMS>
+		static void appendPrintf(std::string& out, std::string const& spec, PARAMS... params)
+		{
+			char buf[128];
+			int const len = std::snprintf(buf, sizeof(buf), spec.c_str(), params...);
+			if (len < 0) return;
+			if (static_cast<size_t>(len) < sizeof(buf))
 			{
-				memcpy(buf.data() + pos, typeStr, typeStrLen);
-				pos += typeStrLen;
+				out.append(buf, static_cast<size_t>(len));
+				return;
 			}
-			buf.data()[pos++] = ' ';
-			memcpy(buf.data() + pos, msgUtf8, msgUtf8Len);
-			pos += msgUtf8Len;
-			buf.data()[pos] = '\n';
-
-			WriteFile(m_file, buf.data(), static_cast<DWORD>(bufSize), NULL, NULL);
-			FlushFileBuffers(m_file);
+			size_t const pos = out.size();
+			out.resize(pos + static_cast<size_t>(len));
+			std::string tmp(static_cast<size_t>(len), '\0');
+			std::snprintf(tmp.data(), tmp.size() + 1, spec.c_str(), params...);
+			std::memcpy(out.data() + pos, tmp.data(), tmp.size());
 		}
 
 		/// <summary>
-		/// Mutex used to thread-lock all output
-		/// </summary>
-		mutable std::mutex m_threadLock;
-
-	public:
-
-#if 1 /* REGION: default configuration values */
-
-		/// <summary>
-		/// Returns the default directory where log files are stored.
-		///
-		/// These locations are tested in this priority order:
-		/// 1) "%appdata%\LocalLow\sgrottel_simplelog"
-		/// 2) "logs" subfolder of the location of the process' executing assembly
-		/// 3) the localion of the process' executing assembly
-		/// 4) "logs" subfolder of the current working directory
-		/// 5) the current working directory
+		/// Formats a printf-based message, one conversion specification at a time
 		/// </summary>
-		/// <returns>The default path where log files are stored</returns>
-		/// <remarks>The function creates folders and files to test access rights. It removes all files and folders again.
-		/// If the file system access rights allow for creation but not for deletion, empty test files or folders might stay behind.
-		/// </remarks>
-		static std::filesystem::path GetDefaultDirectory()
+		static void formatMessage(std::string& out, std::string const& format, Reader& r, size_t wcharSize)
 		{
-			auto testCreateFile = [](std::filesystem::path const& path)
+			Arg arg;
+			size_t i = 0;
+			while (i < format.size())
+			{
+				size_t const percent = format.find('%', i);
+				if (percent == std::string::npos)
 				{
-					try
-					{
-						std::filesystem::path file;
-						int i = 0;
-						do
-						{
-							i++;
-							file = path / ("temp_" + std::to_string(i) + ".tmp");
-						}
-						while (std::filesystem::exists(file));
-
-						FILE* f = nullptr;
-						// Visual Cpp specific
-						if (fopen_s(&f, file.generic_string().c_str(), "wb") != 0)
-						{
-							f = nullptr;
-						}
-						if (f == nullptr) throw std::runtime_error("failed to open");
-						size_t r = fwrite("Hello World", 11, 1, f);
-						fclose(f);
-
-						uintmax_t s = std::filesystem::file_size(file);
-
-						std::filesystem::remove(file);
+					out.append(format, i, std::string::npos);
+					return;
+				}
+				out.append(format, i, percent - i);
+				i = percent + 1;
+				if (i < format.size() && format[i] == '%')
+				{
+					out.push_back('%');
+					++i;
+					continue;
+				}
 
-						return s > 0 && r > 0;
-					}
-					catch (...) {}
-					return false;
-				};
-			std::filesystem::path createdDir;
-			auto cleanDirGuard = [&](std::filesystem::path const& otherPath)
+				// %[flags][width][.precision][length]conversion, with `*` width and precision taken from the arguments
+				std::string spec = "%";
+				bool valid = true;
+				while (i < format.size() && std::strchr("-+ #0'", format[i]) != nullptr) spec.push_back(format[i++]);
+				for (int part = 0; part < 2 && valid; ++part)
 				{
-					if (!createdDir.empty())
+					if (part == 1)
 					{
-						if (std::filesystem::is_directory(createdDir))
-						{
-							std::filesystem::remove_all(createdDir);
-						}
-						createdDir.clear();
+						if (i >= format.size() || format[i] != '.') break;
+						spec.push_back(format[i++]);
 					}
-					return otherPath;
-				};
-			std::filesystem::path parent, path;
-
-			PWSTR wPath;
-			if (SHGetKnownFolderPath(FOLDERID_LocalAppDataLow, 0, NULL, &wPath) == S_OK)
-			{
-				parent = wPath;
-				CoTaskMemFree(wPath);
-				if (std::filesystem::is_directory(parent))
-				{
-					path = parent / "sgrottel_simplelog";
-					if (!std::filesystem::is_directory(path))
+					if (i < format.size() && format[i] == '*')
 					{
-						try
-						{
-							std::filesystem::create_directory(path);
-							createdDir = path;
-						}
-						catch (...) {}
+						++i;
+						valid = readArg(r, arg, wcharSize) && isInteger(arg.type);
+						if (valid) spec += std::to_string(static_cast<int>(integerValue(arg, true, {})));
 					}
-					if (std::filesystem::is_directory(path))
+					else
 					{
-						if (testCreateFile(path))
-						{
-							return cleanDirGuard(path);
-						}
+						while (i < format.size() && format[i] >= '0' && format[i] <= '9') spec.push_back(format[i++]);
 					}
-					cleanDirGuard("");
 				}
-			}
+				size_t const lengthStart = i;
+				while (i < format.size() && std::strchr("hljztLqIw0123456789", format[i]) != nullptr) ++i;
+				std::string_view const length{ format.data() + lengthStart, i - lengthStart };
+				if (i >= format.size()) valid = false;
+				char const conversion = valid ? format[i++] : 0;
 
-			parent = getProcessPath();
-			if (!parent.empty())
-			{
-				parent = parent.parent_path();
-				if (std::filesystem::is_directory(parent))
+				if (valid && conversion == 'n')
 				{
-					path = parent / "logs";
-					if (!std::filesystem::is_directory(path))
-					{
-						try
-						{
-							std::filesystem::create_directory(path);
-							createdDir = path;
-						}
-						catch (...) {}
-					}
-					if (std::filesystem::is_directory(path))
+					// writes to a pointer of the writing process; ignored
+					valid = readArg(r, arg, wcharSize);
+					continue;
+				}
+				valid = valid && readArg(r, arg, wcharSize);
+				if (valid)
+				{
+					switch (conversion)
 					{
-						if (testCreateFile(path))
+					case 'd': case 'i':
+						valid = isInteger(arg.type);
+						if (valid) appendPrintf(out, spec + "ll" + conversion, static_cast<long long>(integerValue(arg, true, length)));
+						break;
+					case 'u': case 'o': case 'x': case 'X':
+						valid = isInteger(arg.type);
+						if (valid) appendPrintf(out, spec + "ll" + conversion, static_cast<unsigned long long>(integerValue(arg, false, length)));
+						break;
+					case 'c': case 'C':
+						valid = isInteger(arg.type);
+						if (valid)
 						{
-							return cleanDirGuard(path);
+							char utf8[4];
+							uint32_t c = static_cast<uint32_t>(integerValue(arg, false, {}));
+							if (length.empty() && conversion == 'c') c &= 0xff;
+							if (c > 0x10ffff || (c >= 0xd800 && c <= 0xdfff)) c = 0xfffd;
+							std::string const str{ utf8, Utf8Encoding::EncodeCodePoint(utf8, c) };
+							appendPrintf(out, spec + "s", str.c_str());
 						}
+						break;
+					case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+						valid = (arg.type == BinaryLogFormat::ArgType::Double);
+						if (valid) appendPrintf(out, spec + conversion, arg.d);
+						break;
+					case 's': case 'S':
+						valid = (arg.type == BinaryLogFormat::ArgType::String || arg.type == BinaryLogFormat::ArgType::WideString);
+						if (valid) appendPrintf(out, spec + "s", arg.str.c_str());
+						break;
+					case 'p':
+						valid = (arg.type == BinaryLogFormat::ArgType::Pointer);
+						if (valid) appendPrintf(out, "0x%llx", static_cast<unsigned long long>(arg.bits));
+						break;
+					default:
+						valid = false;
+						break;
 					}
-					cleanDirGuard("");
-					if (testCreateFile(parent))
-					{
-						return parent;
-					}
+				}
+				if (!valid)
+				{
+					// malformed specification, or mismatching argument
+					out.append(format, percent, i - percent);
 				}
 			}
+		}
+	};
 
-			parent = std::filesystem::current_path();
-			path = parent / "logs";
-			if (!std::filesystem::is_directory(path))
+	/// <summary>
+	/// Extention to SimpleLog, which echoes all messages to the console
+	/// </summary>
+	class EchoingSimpleLog : public ISimpleLog
+	{
+	private:
+		/// <summary>
+		/// Implementation to check if this console output should use colors
+		/// </summary>
+		/// <returns>True if this console output should use colors</returns>
+		static bool EvalCanUseConsoleApi()
+		{
+			static bool doEval = true;
+			static bool evalResult = true;
+
+			if (doEval)
 			{
-				try
+				doEval = false;
+#if defined(SIMPLELOG_POSIX)
+				evalResult = ::isatty(STDOUT_FILENO) != 0;
+#else
+				HANDLE hStdOut = GetStdHandle(STD_OUTPUT_HANDLE);
+				if (hStdOut == INVALID_HANDLE_VALUE)
 				{
-					std::filesystem::create_directory(path);
-					createdDir = path;
+					evalResult = false;
+					return false;
 				}
-				catch(...) {}
+				DWORD mode = 0;
+				if (!GetConsoleMode(hStdOut, &mode))
+				{
+					evalResult = false;
+					return false;
+				}
+				evalResult = (mode & ENABLE_VIRTUAL_TERMINAL_PROCESSING) == ENABLE_VIRTUAL_TERMINAL_PROCESSING;
+#endif
+			}
+
+			return evalResult;
+		}
+
+		/// <summary>
+		/// Implementation to check if this console output can use the console api functions to write text
+		/// </summary>
+		/// <returns>True if this console output can use the console api functions to write text</returns>
+		static bool EvalCanUseConsoleWrite()
+		{
+#if defined(SIMPLELOG_WINDOWS)
+			return EvalCanUseConsoleApi();
+#else
+			// there is no console api on POSIX systems; output always uses the print functions
+			return false;
+#endif
+		}
+
+		/// <summary>
+		/// Gets the color escape sequence written before a message of this level, or an empty string
+		/// </summary>
+		std::string_view colorPrefix(uint32_t flags) const noexcept
+		{
+			using namespace std::string_view_literals;
+			if (!m_useColors) return {};
+			switch (flags & FlagLevelMask)
+			{
+			case FlagLevelCritical: return "\x1b[41m\x1b[97m"sv;
+			case FlagLevelError: return "\x1b[40m\x1b[91m"sv;
+			case FlagLevelWarning: return "\x1b[40m\x1b[93m"sv;
+			case FlagLevelDetail: return "\x1b[40m\x1b[90m"sv;
+			default: return {};
+			}
+		}
+
+		/// <summary>
+		/// Checks if a message with these flags is written to stderr
+		/// </summary>
+		bool isStdErr(uint32_t flags) const noexcept
+		{
+			uint32_t const level = flags & FlagLevelMask;
+			return m_useStdErr && (level == FlagLevelCritical || level == FlagLevelError || level == FlagLevelWarning);
+		}
+
+		template<typename CHAR>
+		static void appendAscii(std::basic_string<CHAR>& out, std::string_view str)
+		{
+			for (char c : str)
+			{
+				out.push_back(static_cast<CHAR>(c));
+			}
+		}
+
+		static void appendMessage(std::string& out, char const* message, size_t messageLength)
+		{
+			out.append(message, messageLength);
+		}
+
+		static void appendMessage(std::string& out, wchar_t const* message, size_t messageLength)
+		{
+			// wide and narrow output must not be mixed on the same stream, so wide messages are written as UTF8
+			Utf8Encoding::AppendFromWide(out, message, messageLength);
+		}
+
+#if defined(SIMPLELOG_WINDOWS)
+		static void appendMessage(std::wstring& out, wchar_t const* message, size_t messageLength)
+		{
+			out.append(message, messageLength);
+		}
+
+		static void appendMessage(std::wstring& out, char const* message, size_t messageLength)
+		{
+			// as WriteConsoleA would interpret the message
+			UINT const codePage = GetConsoleOutputCP();
+			int const size = MultiByteToWideChar(codePage, 0, message, static_cast<int>(messageLength), nullptr, 0);
+			if (size <= 0) return;
+			size_t const pos = out.size();
+			out.resize(pos + static_cast<size_t>(size));
+			MultiByteToWideChar(codePage, 0, message, static_cast<int>(messageLength), out.data() + pos, size);
+		}
+#endif
+
+		/// <summary>
+		/// Appends the complete output of one message, i.e. color sequences, message, and new line
+		/// </summary>
+		template<typename OUTCHAR, typename CHAR>
+		void appendOutput(std::basic_string<OUTCHAR>& out, uint32_t flags, CHAR const* message, size_t messageLength) const
+		{
+			std::string_view const pre = colorPrefix(flags);
+			appendAscii(out, pre);
+			appendMessage(out, message, messageLength);
+			if (!pre.empty())
+			{
+				appendAscii(out, "\x1b[0m");
+			}
+			out.push_back(static_cast<OUTCHAR>('\n'));
+		}
+
+		/// <summary>
+		/// Gets the buffer to assemble the output of a message, reused to avoid reallocations
+		/// </summary>
+		std::string& outputBufferUnderLock(char const*) const { return m_buffer; }
+#if defined(SIMPLELOG_POSIX)
+		std::string& outputBufferUnderLock(wchar_t const*) const { return m_buffer; }
+#else
+		std::wstring& outputBufferUnderLock(wchar_t const*) const { return m_wideBuffer; }
+#endif
+
+#if defined(SIMPLELOG_POSIX)
+		/// <summary>
+		/// Writes the output directly to the file descriptor of stdout or stderr, in one write call unless it is interrupted.
+		/// The stdio stream is flushed before, to keep the order with other output of the application.
+		/// </summary>
+		void emitUnderLock(bool toStdErr, std::string const& text) const
+		{
+			auto const start = std::chrono::steady_clock::now();
+			std::fflush(toStdErr ? stderr : stdout);
+			int const fd = toStdErr ? STDERR_FILENO : STDOUT_FILENO;
+			char const* data = text.data();
+			size_t len = text.size();
+			while (len > 0)
+			{
+				ssize_t const written = ::write(fd, data, len);
+				if (written < 0)
+				{
+					if (errno == EINTR) continue;
+					break;
+				}
+				data += written;
+				len -= static_cast<size_t>(written);
+			}
+			m_stats.CountWrite(std::chrono::steady_clock::now() - start);
+			m_stats.CountBytes(text.size() - len);
+		}
+#else
+		/// <summary>
+		/// Writes the output with one call, via the console api, or via the print functions
+		/// </summary>
+		/// <remarks>
+		/// WriteConsole does not depend on the file mode of stdout, which might be set by the
+		/// host application. Therefore, this implementation is more independent, in terms of output encoding.
+		/// </remarks>
+		void emitUnderLock(bool toStdErr, std::string const& text) const
+		{
+			auto const start = std::chrono::steady_clock::now();
+			if (m_useConsoleWrite)
+			{
+				WriteConsoleA(GetStdHandle(toStdErr ? STD_ERROR_HANDLE : STD_OUTPUT_HANDLE), text.data(), static_cast<DWORD>(text.size()), nullptr, nullptr);
+			}
+			else
+			{
+				fwrite(text.data(), 1, text.size(), toStdErr ? stderr : stdout);
+			}
+			m_stats.CountWrite(std::chrono::steady_clock::now() - start);
+			m_stats.CountBytes(text.size());
+		}
+
+		void emitUnderLock(bool toStdErr, std::wstring const& text) const
+		{
+			auto const start = std::chrono::steady_clock::now();
+			if (m_useConsoleWrite)
+			{
+				WriteConsoleW(GetStdHandle(toStdErr ? STD_ERROR_HANDLE : STD_OUTPUT_HANDLE), text.data(), static_cast<DWORD>(text.size()), nullptr, nullptr);
 			}
-			if (std::filesystem::is_directory(path))
+			else
 			{
-				if (testCreateFile(path))
-				{
-					return cleanDirGuard(path);
-				}
+				fputws(text.c_str(), toStdErr ? stderr : stdout);
 			}
-			cleanDirGuard("");
+			m_stats.CountWrite(std::chrono::steady_clock::now() - start);
+			m_stats.CountBytes(text.size() * sizeof(wchar_t));
+		}
+#endif
 
-			return parent;
+		/// <summary>
+		/// Checks if messages are coalesced; on Windows only the console api output is
+		/// </summary>
+		bool isCoalescing() const noexcept
+		{
+#if defined(SIMPLELOG_POSIX)
+			return m_coalesceOutput;
+#else
+			return m_coalesceOutput && m_useConsoleWrite;
+#endif
 		}
 
 		/// <summary>
-		/// Determines the default name for log files of this process.
-		/// The value is based on the process' executing assembly.
+		/// Writes a message with a single output call, or hands it to the output thread
 		/// </summary>
-		/// <returns>The default name for log files of this process</returns>
-		static std::filesystem::path GetDefaultName()
+		/// <returns>False if the message was dropped</returns>
+		template<typename CHAR>
+		bool echo(uint32_t flags, CHAR const* message, size_t messageLength) const
 		{
-			std::filesystem::path procPath = getProcessPath();
-			if (!procPath.empty())
+			size_t const capacity = m_backgroundCapacity.load(std::memory_order_relaxed);
+			if (capacity > 0)
 			{
-				return procPath.filename().replace_extension();
+				return echoBackground(flags, message, messageLength, capacity);
 			}
-			return std::to_string(GetCurrentProcessId());
+			if (isCoalescing())
+			{
+				echoCoalesced(flags, message, messageLength);
+				return true;
+			}
+			std::unique_lock<std::mutex> const lock = m_stats.Lock(m_threadLock);
+			auto& buf = outputBufferUnderLock(message);
+			buf.clear();
+			appendOutput(buf, flags, message, messageLength);
+			emitUnderLock(isStdErr(flags), buf);
+			return true;
 		}
 
 		/// <summary>
-		/// Gets the default retention, i.e. how many previous log files are kept in the target directory in addition to the current log file
+		/// Appends a message to the pending output written by the output thread.
+		/// If the pending output reaches its capacity, less severe messages are dropped, and error and critical messages wait.
 		/// </summary>
-		/// <returns>The default log file retention count.</returns>
-		static inline constexpr int const GetDefaultRetention()
+		/// <returns>False if the message was dropped</returns>
+		template<typename CHAR>
+		bool echoBackground(uint32_t flags, CHAR const* message, size_t messageLength, size_t capacity) const
 		{
-			return 10;
+			uint32_t const severity = GetLevelSeverity(flags);
+			std::unique_lock<std::mutex> lock = m_stats.Lock(m_pendingLock);
+			if (severity >= GetLevelSeverity(FlagLevelError))
+			{
+				m_spaceSignal.wait(lock, [this, capacity]() { return pendingLengthUnderLock() < capacity || m_outputThreadStop; });
+			}
+			else if (pendingLengthUnderLock() >= ((severity >= GetLevelSeverity(FlagLevelWarning)) ? capacity : capacity / 2))
+			{
+				// half of the capacity is kept free for warnings, errors, and critical messages
+				++m_notEchoed;
+				m_stats.CountDropped();
+				return false;
+			}
+			appendNoticeUnderPendingLock();
+			appendOutput(m_pending[isStdErr(flags) ? 1 : 0], flags, message, messageLength);
+
+			if (m_outputThreadStop)
+			{
+				// the output thread was stopped meanwhile
+				lock.unlock();
+				std::unique_lock<std::mutex> const output = m_stats.Lock(m_threadLock);
+				writePendingUnderLock();
+			}
+			else if (m_outputThreadWaiting)
+			{
+				m_outputSignal.notify_one();
+			}
+			return true;
 		}
 
-#endif
+		size_t pendingLengthUnderLock() const noexcept
+		{
+			return m_pending[0].size() + m_pending[1].size();
+		}
 
 		/// <summary>
-		/// Creates a SimpleLog with default values for directory, name, and retention
+		/// Appends the notice about dropped messages, if any
 		/// </summary>
-		SimpleLog() : SimpleLog(GetDefaultDirectory(), GetDefaultName(), GetDefaultRetention()) { }
+		void appendNoticeUnderPendingLock() const
+		{
+			if (m_notEchoed == 0) return;
+			std::string const notice = std::to_string(m_notEchoed) + " messages not echoed";
+			m_notEchoed = 0;
+			appendOutput(m_pending[isStdErr(FlagLevelWarning) ? 1 : 0], FlagLevelWarning, notice.c_str(), notice.size());
+		}
 
 		/// <summary>
-		/// Creates a SimpleLog instance.
+		/// Writes the pending output, until stopped and all pending output is written
 		/// </summary>
-		/// <param name="directory">The directory where log files are stored</param>
-		/// <param name="name">The name for log files of this process without file name extension</param>
-		/// <param name="retention">The default log file retention count; must be 2 or larger</param>
-		SimpleLog(std::filesystem::path const& directory, std::filesystem::path const& name, int retention)
+		void outputThread()
 		{
-			// memory-only writer
-			if (directory.empty() && name.empty())
+			std::unique_lock<std::mutex> lock{ m_pendingLock };
+			while (true)
 			{
-				// m_file stays closed
-				return;
+				if (pendingLengthUnderLock() == 0)
+				{
+					if (m_notEchoed > 0)
+					{
+						appendNoticeUnderPendingLock();
+						continue;
+					}
+					if (m_outputThreadStop) return;
+					m_outputThreadWaiting = true;
+					m_outputSignal.wait(lock);
+					m_outputThreadWaiting = false;
+					continue;
+				}
+				lock.unlock();
+				{
+					std::lock_guard<std::mutex> const output{ m_threadLock };
+					writePendingUnderLock();
+				}
+				lock.lock();
 			}
+		}
 
-			// check arguments
-			if (directory.empty()) throw std::invalid_argument("directory");
-			if (name.empty()) throw std::invalid_argument("name");
+		/// <summary>
+		/// Stops the output thread, after it has written all pending output
+		/// </summary>
+		void stopOutputThread()
+		{
+			if (!m_outputThread.joinable()) return;
 			{
-				std::string dirStr = directory.string();
-				if (std::all_of(dirStr.begin(), dirStr.end(), isspace)) throw std::invalid_argument("directory");
+				std::lock_guard<std::mutex> const lock{ m_pendingLock };
+				m_outputThreadStop = true;
 			}
+			m_outputSignal.notify_one();
+			m_spaceSignal.notify_all();
+			m_outputThread.join();
+		}
+
+		/// <summary>
+		/// Appends a message to the pending output. If no other thread is writing output, this thread writes all pending output.
+		/// Otherwise, the writing thread takes this message along, and this thread does not wait.
+		/// </summary>
+		template<typename CHAR>
+		void echoCoalesced(uint32_t flags, CHAR const* message, size_t messageLength) const
+		{
+			bool backPressure = false;
 			{
-				std::string nameStr = name.string();
-				if (std::all_of(nameStr.begin(), nameStr.end(), isspace)) throw std::invalid_argument("name");
+				std::unique_lock<std::mutex> const lock = m_stats.Lock(m_pendingLock);
+				PendingString& pending = m_pending[isStdErr(flags) ? 1 : 0];
+				appendOutput(pending, flags, message, messageLength);
+				backPressure = pending.size() > MaxPendingLength;
 			}
-			if (retention < 2) throw std::out_of_range("retention must be 2 or larger");
 
-			// setup
-			HANDLE logSetupMutex = NULL;
-			scope_exit closeLogSetupMutex{ [&logSetupMutex]()
-				{
-					if (logSetupMutex != NULL)
-					{
-						::CloseHandle(logSetupMutex);
-						logSetupMutex = NULL;
-					}
-				} };
-			// Visual Cpp specific
-			logSetupMutex = CreateMutexW(nullptr, FALSE, L"SGROTTEL_SIMPLELOG_CREATION");
-			if (logSetupMutex == NULL)
+			if (backPressure)
 			{
-				throw std::runtime_error("Failed to create initializtion mutex");
+				// the output cannot keep up, so this thread waits for it
+				std::unique_lock<std::mutex> const output = m_stats.Lock(m_threadLock);
+				writePendingUnderLock();
+				return;
 			}
-			WaitForSingleObject(logSetupMutex, INFINITE);
-			scope_exit releaseLogSetupMutex{ [&logSetupMutex]()
-				{
-					if (logSetupMutex != NULL)
-					{
-						::ReleaseMutex(logSetupMutex);
-					}
-				} };
 
-			if (!std::filesystem::is_directory(directory))
+			while (true)
 			{
-				if (!std::filesystem::is_directory(directory.parent_path())) throw std::runtime_error("Log directory does not exist");
-				std::filesystem::create_directories(directory);
-				if (!std::filesystem::is_directory(directory)) throw std::runtime_error("Failed to create log directory");
+				std::unique_lock<std::mutex> output{ m_threadLock, std::try_to_lock };
+				if (!output.owns_lock()) return;
+				writePendingUnderLock();
+				output.unlock();
+
+				// output appended while this thread released the lock is written by this thread, or the thread holding the lock now
+				std::lock_guard<std::mutex> const lock{ m_pendingLock };
+				if (m_pending[0].empty() && m_pending[1].empty()) return;
 			}
+		}
 
-			std::filesystem::path fn = directory / (name.wstring() + L"." + std::to_wstring(retention - 1) + L".log");
-			if (std::filesystem::is_regular_file(fn))
+		/// <summary>
+		/// Writes all pending output, until no more output is appended by other threads
+		/// </summary>
+		void writePendingUnderLock() const
+		{
+			bool written = true;
+			while (written)
 			{
-				std::filesystem::remove(fn);
-				if (std::filesystem::is_regular_file(fn))
+				written = false;
+				for (size_t stream = 0; stream < 2; ++stream)
 				{
-					std::string msg = "Failed to delete old log file '" + fn.string() + "'";
-					throw std::runtime_error(msg.c_str());
+					{
+						std::lock_guard<std::mutex> const lock{ m_pendingLock };
+						m_writing.swap(m_pending[stream]);
+					}
+					// writers of severe messages might wait for space in background mode
+					m_spaceSignal.notify_all();
+					if (m_writing.empty()) continue;
+					emitUnderLock(stream == 1, m_writing);
+					m_writing.clear();
+					written = true;
 				}
 			}
+		}
 
-			for (int i = retention - 1; i > 0; --i)
+		bool m_useStdErr = false;
+		bool m_useColors = EvalCanUseConsoleApi();
+		bool m_echoCriticals = true;
+		bool m_echoErrors = true;
+		bool m_echoWarnings = true;
+		bool m_echoMessages = true;
+		bool m_echoDetails = true;
+		bool m_useConsoleWrite = EvalCanUseConsoleWrite();
+		bool m_coalesceOutput = false;
+
+		/// <summary>
+		/// Buffers to assemble the output of a message, reused to avoid reallocations.
+		/// On POSIX systems, all output is UTF8.
+		/// </summary>
+		mutable std::string m_buffer;
+#if defined(SIMPLELOG_WINDOWS)
+		mutable std::wstring m_wideBuffer;
+#endif
+
+		ISimpleLog& m_baseLog;
+
+		/// <summary>
+		/// Mutex used to thread-lock all output
+		/// </summary>
+		mutable std::mutex m_threadLock;
+
+#if defined(SIMPLELOG_POSIX)
+		using PendingString = std::string;
+#else
+		using PendingString = std::wstring;
+#endif
+
+		/// <summary>
+		/// Output length in characters, above which writers of coalesced messages wait for the output
+		/// </summary>
+		static constexpr size_t MaxPendingLength = 1024 * 1024;
+
+		/// <summary>
+		/// Coalesced output not yet written, for stdout and stderr; only used under the pending lock
+		/// </summary>
+		mutable std::mutex m_pendingLock;
+		mutable PendingString m_pending[2];
+
+		/// <summary>
+		/// Coalesced output being written; only used under the thread lock
+		/// </summary>
+		mutable PendingString m_writing;
+
+		/// <summary>
+		/// Capacity of the pending output in characters, if the output is written by the output thread; zero otherwise
+		/// </summary>
+		std::atomic<size_t> m_backgroundCapacity{ 0 };
+
+		/// <summary>
+		/// State of the output thread; only used under the pending lock
+		/// </summary>
+		mutable std::condition_variable m_outputSignal;
+		mutable std::condition_variable m_spaceSignal;
+		mutable bool m_outputThreadWaiting = false;
+		bool m_outputThreadStop = false;
+		mutable uint64_t m_notEchoed = 0;
+		std::thread m_outputThread;
+
+		/// <summary>
+		/// The runtime statistics, see `GetStats()`
+		/// </summary>
+		mutable LogStatsCounters m_stats;
+
+	public:
+
+		/// <summary>
+		/// Flag message to not be echoed to the console
+		/// </summary>
+		static constexpr uint32_t const FlagDontEcho = 0x00010000;
+
+	private:
+
+		/// <summary>
+		/// Checks if a message with these flags is echoed to the console
+		/// </summary>
+		bool isEchoed(uint32_t flags) const noexcept
+		{
+			if ((flags & FlagDontEcho) == FlagDontEcho) return false;
+			switch (flags & FlagLevelMask)
 			{
-				std::filesystem::path tfn = directory / (name.wstring() + L"." + std::to_wstring(i) + L".log");
-				std::filesystem::path sfn = directory / (name.wstring() + L"." + std::to_wstring(i - 1) + L".log");
-				if (i == 1) sfn = sfn = directory / (name.wstring() + L".log");
-				if (!std::filesystem::is_regular_file(sfn)) continue;
-				if (std::filesystem::is_regular_file(tfn))
-				{
-					std::string msg = "Log file retention error. Unexpected log file: '" + tfn.string() + "'";
-					throw std::runtime_error(msg.c_str());
-				}
-				std::filesystem::rename(sfn, tfn);
-				if (std::filesystem::is_regular_file(sfn))
-				{
-					std::string msg = "Log file retention error. Unable to move log file: '" + sfn.string() + "'";
-					throw std::runtime_error(msg.c_str());
-				}
+			case FlagLevelCritical: return m_echoCriticals;
+			case FlagLevelError: return m_echoErrors;
+			case FlagLevelWarning: return m_echoWarnings;
+			case FlagLevelMessage: return m_echoMessages;
+			case FlagLevelDetail: return m_echoDetails;
+			default: return true;
 			}
+		}
+
+	public:
+
+		/// <summary>
+		/// Creates a EchoingSimpleLog with default values for directory, name, and retention
+		/// </summary>
+		EchoingSimpleLog(ISimpleLog& baseLog) : m_baseLog{ baseLog } {}
+
+		virtual ~EchoingSimpleLog()
+		{
+			stopOutputThread();
+		}
+
+		EchoingSimpleLog(const EchoingSimpleLog&) = delete;
+		EchoingSimpleLog(EchoingSimpleLog&&) = delete;
+		EchoingSimpleLog& operator=(const EchoingSimpleLog&) = delete;
+		EchoingSimpleLog& operator=(EchoingSimpleLog&&) = delete;
+
+		/// <summary>
+		/// Gets the flag whether or not to use stderr for critical, error, and warning messages.
+		/// </summary>
+		inline bool GetUseStdErr() const noexcept { return m_useStdErr; }
+
+		/// <summary>
+		/// Sets the flag whether or not to use stderr for critical, error, and warning messages.
+		/// </summary>
+		inline void SetUseStdErr(bool useStdErr) noexcept { m_useStdErr = useStdErr; }
+
+		/// <summary>
+		/// Gets the flag whether or not to output colored text if supported.
+		/// </summary>
+		inline bool GetUseColors() const noexcept { return m_useColors; }
+
+		/// <summary>
+		/// Sets the flag whether or not to output colored text if supported.
+		/// </summary>
+		inline void SetUseColors(bool useColors) noexcept { m_useColors = useColors && EvalCanUseConsoleApi(); }
+
+		/// <summary>
+		/// Gets the flag whether or not to echo critical error messages
+		/// </summary>
+		inline bool GetEchoCriticals() const noexcept { return m_echoCriticals; }
+
+		/// <summary>
+		/// Sets the flag whether or not to echo critical error messages
+		/// </summary>
+		inline void SetEchoCriticals(bool echoCriticals) noexcept { m_echoCriticals = echoCriticals; }
+
+		/// <summary>
+		/// Gets the flag whether or not to echo error messages
+		/// </summary>
+		inline bool GetEchoErrors() const noexcept { return m_echoErrors; }
+
+		/// <summary>
+		/// Sets the flag whether or not to echo error messages
+		/// </summary>
+		inline void SetEchoErrors(bool echoErrors) noexcept { m_echoErrors = echoErrors; }
+
+		/// <summary>
+		/// Gets the flag whether or not to echo warning messages
+		/// </summary>
+		inline bool GetEchoWarnings() const noexcept { return m_echoWarnings; }
+
+		/// <summary>
+		/// Sets the flag whether or not to echo warning messages
+		/// </summary>
+		inline void SetEchoWarnings(bool echoWarnings) noexcept { m_echoWarnings = echoWarnings; }
+
+		/// <summary>
+		/// Gets the flag whether or not to echo messages
+		/// </summary>
+		inline bool GetEchoMessages() const noexcept { return m_echoMessages; }
+
+		/// <summary>
+		/// Sets the flag whether or not to echo messages
+		/// </summary>
+		inline void SetEchoMessages(bool echoMessages) noexcept { m_echoMessages = echoMessages; }
+
+		/// <summary>
+		/// Gets the flag whether or not to echo detail messages
+		/// </summary>
+		inline bool GetEchoDetails() const noexcept { return m_echoDetails; }
 
-			fn = directory / (name.wstring() + L".log");
+		/// <summary>
+		/// Sets the flag whether or not to echo detail messages
+		/// </summary>
+		inline void SetEchoDetails(bool echoDetails) noexcept { m_echoDetails = echoDetails; }
+
+		/// <summary>
+		/// Gets the flag whether or not to output colored text if supported.
+		/// </summary>
+		inline bool GetUseConsoleWrite() const noexcept { return m_useConsoleWrite; }
+
+		/// <summary>
+		/// Sets the flag whether or not to output colored text if supported.
+		/// </summary>
+		inline void SetUseConsoleWrite(bool useColors) noexcept { m_useConsoleWrite = useColors && EvalCanUseConsoleWrite(); }
+
+		/// <summary>
+		/// Gets the flag whether or not messages written at the same time by several threads are coalesced into one output call.
+		/// </summary>
+		inline bool GetCoalesceOutput() const noexcept { return m_coalesceOutput; }
 
-			// Share mode `Delete` allows other processes to rename the file while it is being written.
-			// This works because this process keeps an open file handle to write messages, and never reopens based on a file name.
-			m_file = ::CreateFileW(fn.wstring().c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_ALWAYS, NULL, NULL);
-			if (m_file == INVALID_HANDLE_VALUE)
-			{
-				DWORD le = GetLastError();
-				std::string msg = "Failed to create log file: " + std::to_string(le);
-				throw std::runtime_error(msg.c_str());
-			}
-			SetFilePointer(m_file, 0, 0, FILE_END);
+		/// <summary>
+		/// Sets the flag whether or not messages written at the same time by several threads are coalesced into one output call.
+		/// While one thread writes to the console, other threads only append their messages, and that thread writes them as well.
+		/// On Windows, this only applies to output via the console api.
+		/// </summary>
+		inline void SetCoalesceOutput(bool coalesceOutput) noexcept { m_coalesceOutput = coalesceOutput; }
 
-		}
+		/// <summary>
+		/// Default capacity for `SetBackgroundOutput`, in characters
+		/// </summary>
+		static constexpr size_t DefaultBackgroundCapacity = 256 * 1024;
 
-		SimpleLog(const SimpleLog&) = delete;
-		SimpleLog(SimpleLog&&) = delete;
-		SimpleLog& operator=(const SimpleLog&) = delete;
-		SimpleLog& operator=(SimpleLog&&) = delete;
+		/// <summary>
+		/// Gets the capacity of the pending output in characters, if the output is written by an own thread; zero otherwise.
+		/// </summary>
+		inline size_t GetBackgroundOutput() const noexcept { return m_backgroundCapacity.load(std::memory_order_relaxed); }
 
-		virtual ~SimpleLog()
+		/// <summary>
+		/// Sets the output to be written by an own thread, so writing threads never wait for a slow console or pipe.
+		/// If the pending output reaches half of its capacity, detail and normal messages are dropped;
+		/// if it reaches its capacity, warnings are dropped as well. Error and critical messages are never dropped, but wait for space.
+		/// The number of dropped messages is echoed later, as a warning "N messages not echoed".
+		/// The base log is always written before, and never waits for the console.
+		/// </summary>
+		/// <param name="capacity">The capacity of the pending output in characters, e.g. `DefaultBackgroundCapacity`.
+		/// Zero stops the thread, after it has written all pending output.</param>
+		void SetBackgroundOutput(size_t capacity)
 		{
-			std::lock_guard<std::mutex> lock{m_threadLock};
-			try
+			m_backgroundCapacity.store(0, std::memory_order_relaxed);
+			stopOutputThread();
+			if (capacity == 0) return;
 			{
-				if (m_file != INVALID_HANDLE_VALUE)
-				{
-					::CloseHandle(m_file);
-					m_file = INVALID_HANDLE_VALUE;
-				}
+				std::lock_guard<std::mutex> const lock{ m_pendingLock };
+				m_outputThreadStop = false;
 			}
-			catch (...) {}
+			m_outputThread = std::thread{ &EchoingSimpleLog::outputThread, this };
+			m_backgroundCapacity.store(capacity, std::memory_order_relaxed);
 		}
 
-		std::filesystem::path GetFilePath() const
+		/// <summary>
+		/// Gets the runtime statistics of the console echo, not including the base log.
+		/// Bytes written include color sequences and new lines; wide console output counts two bytes per character.
+		/// Messages not echoed, because of their level or `FlagDontEcho`, count as suppressed.
+		/// </summary>
+		LogStats GetStats() const
 		{
-			std::lock_guard<std::mutex> lock{ m_threadLock };
-			if (m_file == INVALID_HANDLE_VALUE)
-			{
-				return {};
-			}
-
-			std::vector<wchar_t> strBuf;
-			DWORD rv = GetFinalPathNameByHandleW(m_file, strBuf.data(), static_cast<DWORD>(strBuf.size()), FILE_NAME_NORMALIZED);
-			if (rv == 0)
-			{
-				DWORD le = GetLastError();
-				std::string msg = "Failed query log file path: " + std::to_string(le);
-				throw std::runtime_error(msg.c_str());
-			}
-
-			if (static_cast<size_t>(rv) > strBuf.size())
-			{
-				strBuf.resize(rv);
-				rv = GetFinalPathNameByHandleW(m_file, strBuf.data(), static_cast<DWORD>(strBuf.size()), FILE_NAME_NORMALIZED);
-				if (rv == 0)
-				{
-					DWORD le = GetLastError();
-					std::string msg = "Failed query log file path 2: " + std::to_string(le);
-					throw std::runtime_error(msg.c_str());
-				}
-
-				if (static_cast<size_t>(rv) > strBuf.size())
-				{
-					throw std::runtime_error("Failed query log file path 2: memory allocation failure");
-				}
-			}
-
-			return std::filesystem::path{ strBuf.data(), strBuf.data() + rv };
+			return m_stats.Snapshot();
 		}
 
 	protected:
-#if 1 /* REGION: implementation of ISampleLog */
 
 		/// <summary>
 		/// Write a message to the log
@@ -975,15 +6063,16 @@ namespace sgrottel
 		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.</param>
 		void WriteImpl(uint32_t flags, char const* message, size_t messageLength) const override
 		{
-			std::lock_guard<std::mutex> lock{m_threadLock};
-			if (m_file == INVALID_HANDLE_VALUE) return;
-
-			const char* utf8Str = nullptr;
-			size_t utf8StrLen = 0;
-
-			toUtf8UnderLock(utf8Str, utf8StrLen, message, messageLength);
-
-			writeImplUnderLock(flags, utf8Str, utf8StrLen);
+			ForwardWriteImpl(m_baseLog, flags, message, messageLength);
+			if (!isEchoed(flags))
+			{
+				m_stats.CountSuppressed();
+				return;
+			}
+			if (echo(flags, message, messageLength))
+			{
+				m_stats.CountMessage(flags);
+			}
 		}
 
 		/// <summary>
@@ -994,420 +6083,810 @@ namespace sgrottel
 		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.</param>
 		void WriteImpl(uint32_t flags, wchar_t const* message, size_t messageLength) const override
 		{
-			std::lock_guard<std::mutex> lock{m_threadLock};
-			if (m_file == INVALID_HANDLE_VALUE) return;
-
-			const char* utf8Str = nullptr;
-			size_t utf8StrLen = 0;
-
-			toUtf8UnderLock(utf8Str, utf8StrLen, message, messageLength);
+			ForwardWriteImpl(m_baseLog, flags, message, messageLength);
+			if (!isEchoed(flags))
+			{
+				m_stats.CountSuppressed();
+				return;
+			}
+			if (echo(flags, message, messageLength))
+			{
+				m_stats.CountMessage(flags);
+			}
+		}
 
-			writeImplUnderLock(flags, utf8Str, utf8StrLen);
+		/// <summary>
+		/// Checks if a message with these flags would be written at all
+		/// </summary>
+		/// <param name="flags">The message flags</param>
+		/// <returns>True if the message is echoed, or if the base log writes it</returns>
+		bool IsEnabledImpl(uint32_t flags) const override
+		{
+			return isEchoed(flags) || m_baseLog.IsEnabled(flags);
 		}
 
-#endif
 	};
 
 	/// <summary>
-	/// Extention to SimpleLog, which echoes all messages to the console
+	/// Extention to SimpleLog, which echoes all messages to DebugOutput
 	/// </summary>
-	class EchoingSimpleLog : public ISimpleLog
+	/// <remarks>
+	/// On POSIX systems there is no DebugOutput. Messages are echoed to a file descriptor, or to the local syslog socket,
+	/// if set via `SetOutputFileDescriptor` or `OpenSyslog`; otherwise messages are only forwarded to the base log.
+	/// The output is assembled in a per-thread buffer, or written in parts, so no memory is allocated per message.
+	/// </remarks>
+	class DebugOutputEchoingSimpleLog : public ISimpleLog
 	{
 	private:
+		ISimpleLog& m_baseLog;
+
 		/// <summary>
-		/// Implementation to check if this console output should use colors
+		/// The runtime statistics, see `GetStats()`
 		/// </summary>
-		/// <returns>True if this console output should use colors</returns>
-		static bool EvalCanUseConsoleApi()
+		mutable LogStatsCounters m_stats;
+
+#if defined(SIMPLELOG_POSIX)
+		/// <summary>
+		/// The file descriptor messages are echoed to, or -1
+		/// </summary>
+		int m_fd = -1;
+		bool m_fdIsSocket = false;
+
+		/// <summary>
+		/// Set if the file descriptor is the syslog socket opened by this object
+		/// </summary>
+		bool m_ownsFd = false;
+
+		/// <summary>
+		/// The identifier of syslog messages followed by the separator, or empty if messages are not written to syslog
+		/// </summary>
+		std::string m_syslogIdent;
+#endif
+
+		/// <summary>
+		/// Per-thread storage for assembling the output, reused to avoid allocations
+		/// </summary>
+		struct OutputBuffer
 		{
-			static bool doEval = true;
-			static bool evalResult = true;
+			std::string narrow;
+#if defined(SIMPLELOG_WINDOWS)
+			std::wstring wide;
+#endif
+		};
 
-			if (doEval)
-			{
-				doEval = false;
-				HANDLE hStdOut = GetStdHandle(STD_OUTPUT_HANDLE);
-				if (hStdOut == INVALID_HANDLE_VALUE)
-				{
-					evalResult = false;
-					return false;
-				}
-				DWORD mode = 0;
-				if (!GetConsoleMode(hStdOut, &mode))
-				{
-					evalResult = false;
-					return false;
-				}
-				evalResult = (mode & ENABLE_VIRTUAL_TERMINAL_PROCESSING) == ENABLE_VIRTUAL_TERMINAL_PROCESSING;
-			}
+		static OutputBuffer& threadOutputBuffer()
+		{
+			thread_local OutputBuffer buffer;
+			return buffer;
+		}
 
-			return evalResult;
+		static char levelChar(uint32_t flags) noexcept
+		{
+			switch (flags & ISimpleLog::FlagLevelMask) {
+			case ISimpleLog::FlagLevelCritical: return 'C';
+			case ISimpleLog::FlagLevelError: return 'E';
+			case ISimpleLog::FlagLevelWarning: return 'W';
+			case ISimpleLog::FlagLevelMessage: return 'l';
+			case ISimpleLog::FlagLevelDetail: return 'd';
+			default: return '.';
+			}
 		}
 
+#if defined(SIMPLELOG_POSIX)
 		/// <summary>
-		/// Write a message to the output stream via print functions
+		/// Gets the syslog severity of the level of a message
 		/// </summary>
-		/// <param name="flags">The message flags</param>
-		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
-		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.</param>
-		void WritePrintImplUnderLock(uint32_t flags, char const* message, size_t messageLength) const
+		static unsigned int syslogSeverity(uint32_t flags) noexcept
 		{
-			uint32_t level = flags & FlagLevelMask;
-			auto stream = m_useStdErr && (level == FlagLevelCritical || level == FlagLevelError || level == FlagLevelWarning)
-				? stderr
-				: stdout;
-			const char* pre = "";
-			const char* post = "";
+			switch (flags & ISimpleLog::FlagLevelMask) {
+			case ISimpleLog::FlagLevelCritical: return 2;
+			case ISimpleLog::FlagLevelError: return 3;
+			case ISimpleLog::FlagLevelWarning: return 4;
+			case ISimpleLog::FlagLevelDetail: return 7;
+			default: return 6;
+			}
+		}
 
-			if (level == FlagLevelCritical && m_useColors)
+		void closeOwnedFd() noexcept
+		{
+			if (m_ownsFd && m_fd >= 0)
 			{
-				pre = "\x1b[41m\x1b[97m";
-				post = "\x1b[0m";
+				::close(m_fd);
 			}
-			else if (level == FlagLevelError && m_useColors)
+			m_fd = -1;
+			m_fdIsSocket = false;
+			m_ownsFd = false;
+			m_syslogIdent.clear();
+		}
+
+		/// <summary>
+		/// Writes a message in parts, with one call.
+		/// Sockets are written without waiting; messages which cannot be written immediately are dropped.
+		/// </summary>
+		void echoToFd(uint32_t flags, char const* message, size_t messageLength) const
+		{
+			if (m_fd < 0) return;
+			char prefix[16];
+			struct iovec parts[3];
+			if (!m_syslogIdent.empty())
 			{
-				pre = "\x1b[40m\x1b[91m";
-				post = "\x1b[0m";
+				// "<PRI>ident: message", with the facility "user"
+				int const prefixLen = std::snprintf(prefix, sizeof(prefix), "<%u>", 8u + syslogSeverity(flags));
+				parts[0].iov_base = prefix;
+				parts[0].iov_len = static_cast<size_t>(prefixLen);
+				parts[1].iov_base = const_cast<char*>(m_syslogIdent.data());
+				parts[1].iov_len = m_syslogIdent.size();
+				parts[2].iov_base = const_cast<char*>(message);
+				parts[2].iov_len = messageLength;
 			}
-			else if (level == FlagLevelWarning && m_useColors)
+			else
 			{
-				pre = "\x1b[40m\x1b[93m";
-				post = "\x1b[0m";
+				prefix[0] = '[';
+				prefix[1] = levelChar(flags);
+				prefix[2] = ']';
+				prefix[3] = ' ';
+				prefix[4] = '\n';
+				parts[0].iov_base = prefix;
+				parts[0].iov_len = 4;
+				parts[1].iov_base = const_cast<char*>(message);
+				parts[1].iov_len = messageLength;
+				parts[2].iov_base = prefix + 4;
+				parts[2].iov_len = 1;
 			}
-			else if (level == FlagLevelDetail && m_useColors)
+
+			auto const start = std::chrono::steady_clock::now();
+			ssize_t written = -1;
+			do
+			{
+				if (m_fdIsSocket)
+				{
+#if defined(MSG_NOSIGNAL)
+					int const sendFlags = MSG_DONTWAIT | MSG_NOSIGNAL;
+#else
+					int const sendFlags = MSG_DONTWAIT;
+#endif
+					struct msghdr msg {};
+					msg.msg_iov = parts;
+					msg.msg_iovlen = 3;
+					written = ::sendmsg(m_fd, &msg, sendFlags);
+				}
+				else
+				{
+					written = ::writev(m_fd, parts, 3);
+				}
+			} while (written < 0 && errno == EINTR);
+			m_stats.CountWrite(std::chrono::steady_clock::now() - start);
+
+			if (written < 0)
 			{
-				pre = "\x1b[40m\x1b[90m";
-				post = "\x1b[0m";
+				m_stats.CountDropped();
+				return;
 			}
+			m_stats.CountMessage(flags);
+			m_stats.CountBytes(static_cast<size_t>(written));
+		}
+#endif
+
+	public:
+		DebugOutputEchoingSimpleLog(ISimpleLog& baseLog) : m_baseLog{ baseLog } {}
 
-			fprintf(stream, "%s%.*s%s\n", pre, static_cast<int>(messageLength), message, post);
+		virtual ~DebugOutputEchoingSimpleLog()
+		{
+#if defined(SIMPLELOG_POSIX)
+			closeOwnedFd();
+#endif
 		}
 
+		DebugOutputEchoingSimpleLog(const DebugOutputEchoingSimpleLog&) = delete;
+		DebugOutputEchoingSimpleLog(DebugOutputEchoingSimpleLog&&) = delete;
+		DebugOutputEchoingSimpleLog& operator=(const DebugOutputEchoingSimpleLog&) = delete;
+		DebugOutputEchoingSimpleLog& operator=(DebugOutputEchoingSimpleLog&&) = delete;
+
 		/// <summary>
-		/// Write a message to the output stream via print functions
+		/// Gets the runtime statistics of the DebugOutput echo, not including the base log.
+		/// Each message counts as one write call, and the characters handed to DebugOutput as bytes written.
 		/// </summary>
-		/// <param name="flags">The message flags</param>
-		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
-		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.</param>
-		void WritePrintImplUnderLock(uint32_t flags, wchar_t const* message, size_t messageLength) const
+		LogStats GetStats() const
 		{
-			uint32_t level = flags & FlagLevelMask;
-			auto stream = m_useStdErr && (level == FlagLevelCritical || level == FlagLevelError || level == FlagLevelWarning)
-				? stderr
-				: stdout;
-			const wchar_t* pre = L"";
-			const wchar_t* post = L"";
+			return m_stats.Snapshot();
+		}
 
-			if (level == FlagLevelCritical && m_useColors)
-			{
-				pre = L"\x1b[41m\x1b[97m";
-				post = L"\x1b[0m";
-			}
-			else if (level == FlagLevelError && m_useColors)
-			{
-				pre = L"\x1b[40m\x1b[91m";
-				post = L"\x1b[0m";
-			}
-			else if (level == FlagLevelWarning && m_useColors)
-			{
-				pre = L"\x1b[40m\x1b[93m";
-				post = L"\x1b[0m";
-			}
-			else if (level == FlagLevelDetail && m_useColors)
-			{
-				pre = L"\x1b[40m\x1b[90m";
-				post = L"\x1b[0m";
-			}
+#if defined(SIMPLELOG_POSIX)
+		/// <summary>
+		/// Gets the file descriptor messages are echoed to, or -1
+		/// </summary>
+		inline int GetOutputFileDescriptor() const noexcept { return m_fd; }
 
-			fwprintf(stream, L"%s%.*s%s\n", pre, static_cast<int>(messageLength), message, post);
+		/// <summary>
+		/// Sets the file descriptor messages are echoed to, e.g. a pipe or socket read by a debugging tool, or -1 to not echo messages.
+		/// Each message is written as one line "[l] message", with the level character as on Windows.
+		/// Sockets are written without waiting, and messages which cannot be written immediately are dropped;
+		/// other file descriptors should be opened with `O_NONBLOCK` to behave the same.
+		/// The file descriptor is not closed by this object. Set it before messages are written.
+		/// </summary>
+		void SetOutputFileDescriptor(int fd)
+		{
+			closeOwnedFd();
+			if (fd < 0) return;
+			struct stat st;
+			m_fdIsSocket = ::fstat(fd, &st) == 0 && S_ISSOCK(st.st_mode);
+			m_fd = fd;
 		}
 
 		/// <summary>
-		/// Write a message to the output console
+		/// Echoes messages to the local syslog socket `/dev/log`, e.g. read by the systemd journal, with the syslog severity of their levels.
+		/// Messages are written without waiting, and are dropped if the socket cannot take them immediately.
+		/// Set it before messages are written.
 		/// </summary>
-		/// <remarks>
-		/// The implementation uses WriteConsole which does not depend on the file mode of stdout, which might be set by the
-		/// host application. Therefore, this implementation is more independent, in terms of output encoding.
-		/// </remarks>
-		/// <param name="flags">The message flags</param>
-		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
-		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.</param>
-		void WriteConsoleImplUnderLock(uint32_t flags, char const* message, size_t messageLength) const
+		/// <param name="ident">The identifier of the messages, e.g. the application name</param>
+		/// <returns>False if the socket could not be connected</returns>
+		bool OpenSyslog(std::string_view ident)
 		{
-			uint32_t level = flags & FlagLevelMask;
-			HANDLE hOut = GetStdHandle(
-				m_useStdErr && (level == FlagLevelCritical || level == FlagLevelError || level == FlagLevelWarning)
-				? STD_ERROR_HANDLE
-				: STD_OUTPUT_HANDLE);
-			bool resetColor = false;
-			if (level == FlagLevelCritical && m_useColors)
-			{
-				WriteConsoleA(hOut, "\x1b[41m\x1b[97m", 10, nullptr, nullptr);
-				resetColor = true;
-			}
-			else if (level == FlagLevelError && m_useColors)
-			{
-				WriteConsoleA(hOut, "\x1b[40m\x1b[91m", 10, nullptr, nullptr);
-				resetColor = true;
-			}
-			else if (level == FlagLevelWarning && m_useColors)
-			{
-				WriteConsoleA(hOut, "\x1b[40m\x1b[93m", 10, nullptr, nullptr);
-				resetColor = true;
-			}
-			else if (level == FlagLevelDetail && m_useColors)
-			{
-				WriteConsoleA(hOut, "\x1b[40m\x1b[90m", 10, nullptr, nullptr);
-				resetColor = true;
-			}
-			WriteConsoleA(hOut, message, static_cast<DWORD>(messageLength), nullptr, nullptr);
-			if (resetColor)
+			closeOwnedFd();
+			int const fd = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+			if (fd < 0) return false;
+			struct sockaddr_un addr {};
+			addr.sun_family = AF_UNIX;
+			std::strncpy(addr.sun_path, "/dev/log", sizeof(addr.sun_path) - 1);
+			if (::connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0)
 			{
-				WriteConsoleA(hOut, "\x1b[0m", 4, nullptr, nullptr);
+				::close(fd);
+				return false;
 			}
-			WriteConsoleA(hOut, "\n", 1, nullptr, nullptr);
+			m_fd = fd;
+			m_fdIsSocket = true;
+			m_ownsFd = true;
+			m_syslogIdent.assign(ident.empty() ? std::string_view{ "SimpleLog" } : ident);
+			m_syslogIdent.append(": ");
+			return true;
 		}
+#endif
+
+	protected:
 
 		/// <summary>
-		/// Write a message to the output console
+		/// Write a message to the log
 		/// </summary>
-		/// <remarks>
-		/// The implementation uses WriteConsole which does not depend on the file mode of stdout, which might be set by the
-		/// host application. Therefore, this implementation is more independent, in terms of output encoding.
-		/// </remarks>
 		/// <param name="flags">The message flags</param>
 		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
-		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.</param>
-		void WriteConsoleImplUnderLock(uint32_t flags, wchar_t const* message, size_t messageLength) const
+		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.
+		/// If set less than zero, the message string is treated being zero terminated.</param>
+		void WriteImpl(uint32_t flags, char const* message, size_t messageLength) const override
 		{
-			uint32_t level = flags & FlagLevelMask;
-			HANDLE hOut = GetStdHandle(
-				m_useStdErr && (level == FlagLevelCritical || level == FlagLevelError || level == FlagLevelWarning)
-				? STD_ERROR_HANDLE
-				: STD_OUTPUT_HANDLE);
-			bool resetColor = false;
-			if (level == FlagLevelCritical && m_useColors)
-			{
-				WriteConsoleW(hOut, L"\x1b[41m\x1b[97m", 10, nullptr, nullptr);
-				resetColor = true;
-			}
-			else if (level == FlagLevelError && m_useColors)
-			{
-				WriteConsoleW(hOut, L"\x1b[40m\x1b[91m", 10, nullptr, nullptr);
-				resetColor = true;
-			}
-			else if (level == FlagLevelWarning && m_useColors)
-			{
-				WriteConsoleW(hOut, L"\x1b[40m\x1b[93m", 10, nullptr, nullptr);
-				resetColor = true;
-			}
-			else if (level == FlagLevelDetail && m_useColors)
-			{
-				WriteConsoleW(hOut, L"\x1b[40m\x1b[90m", 10, nullptr, nullptr);
-				resetColor = true;
-			}
-			WriteConsoleW(hOut, message, static_cast<DWORD>(messageLength), nullptr, nullptr);
-			if (resetColor)
-			{
-				WriteConsoleW(hOut, L"\x1b[0m", 4, nullptr, nullptr);
-			}
-			WriteConsoleW(hOut, L"\n", 1, nullptr, nullptr);
+			ForwardWriteImpl(m_baseLog, flags, message, messageLength);
+#if defined(SIMPLELOG_WINDOWS)
+			char const prefix[4] = { '[', levelChar(flags), ']', ' ' };
+			std::string& outputCopy = threadOutputBuffer().narrow;
+			outputCopy.assign(prefix, 4);
+			outputCopy.append(message, messageLength);
+			outputCopy.push_back('\n');
+			auto const start = std::chrono::steady_clock::now();
+			OutputDebugStringA(outputCopy.c_str());
+			m_stats.CountWrite(std::chrono::steady_clock::now() - start);
+			m_stats.CountMessage(flags);
+			m_stats.CountBytes(outputCopy.size());
+#else
+			echoToFd(flags, message, messageLength);
+#endif
 		}
 
-		bool m_useStdErr = false;
-		bool m_useColors = EvalCanUseConsoleApi();
-		bool m_echoCriticals = true;
-		bool m_echoErrors = true;
-		bool m_echoWarnings = true;
-		bool m_echoMessages = true;
-		bool m_echoDetails = true;
-		bool m_useConsoleWrite = EvalCanUseConsoleApi();
-
-		ISimpleLog& m_baseLog;
+		/// <summary>
+		/// Write a message to the log
+		/// </summary>
+		/// <param name="flags">The message flags</param>
+		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
+		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.
+		/// If set less than zero, the message string is treated being zero terminated.</param>
+		void WriteImpl(uint32_t flags, wchar_t const* message, size_t messageLength) const override
+		{
+			ForwardWriteImpl(m_baseLog, flags, message, messageLength);
+#if defined(SIMPLELOG_WINDOWS)
+			wchar_t const prefix[4] = { L'[', static_cast<wchar_t>(levelChar(flags)), L']', L' ' };
+			std::wstring& outputCopy = threadOutputBuffer().wide;
+			outputCopy.assign(prefix, 4);
+			outputCopy.append(message, messageLength);
+			outputCopy.push_back(L'\n');
+			auto const start = std::chrono::steady_clock::now();
+			OutputDebugStringW(outputCopy.c_str());
+			m_stats.CountWrite(std::chrono::steady_clock::now() - start);
+			m_stats.CountMessage(flags);
+			m_stats.CountBytes(outputCopy.size());
+#else
+			if (m_fd < 0) return;
+			std::string& utf8 = threadOutputBuffer().narrow;
+			Utf8Encoding::FromWide(utf8, message, messageLength);
+			echoToFd(flags, utf8.data(), utf8.size());
+#endif
+		}
 
 		/// <summary>
-		/// Mutex used to thread-lock all output
+		/// Checks if a message with these flags would be written at all
 		/// </summary>
-		mutable std::mutex m_threadLock;
+		/// <param name="flags">The message flags</param>
+		/// <returns>True if the message is echoed, or if the base log writes it</returns>
+		bool IsEnabledImpl(uint32_t flags) const override
+		{
+#if defined(SIMPLELOG_WINDOWS)
+			(void)flags;
+			return true;
+#else
+			return m_fd >= 0 || m_baseLog.IsEnabled(flags);
+#endif
+		}
+	};
 
+	/// <summary>
+	/// Extention to SimpleLog, which hands all messages to a background writer thread.
+	/// The writer thread forwards the messages to the base log in batches.
+	/// </summary>
+	/// <remarks>
+	/// The calling thread only copies the message into a bounded, lock-free multi-producer queue. It does not wait for
+	/// the base log, e.g. for file i/o, unless the queue is full and the overflow policy is `Block`.
+	/// Messages are forwarded in the order in which they were enqueued.
+	/// The time stamps written by the base log reflect the moment the writer thread forwards the message.
+	/// </remarks>
+	class AsyncSimpleLog : public ISimpleLog
+	{
 	public:
 
 		/// <summary>
-		/// Flag message to not be echoed to the console
+		/// Specifies the behavior when a message is written while the queue is full
 		/// </summary>
-		static constexpr uint32_t const FlagDontEcho = 0x00010000;
+		enum class OverflowPolicy
+		{
+			/// <summary>
+			/// The calling thread waits until the writer thread made room in the queue
+			/// </summary>
+			Block,
+
+			/// <summary>
+			/// The new message is dropped
+			/// </summary>
+			DropNewest,
+
+			/// <summary>
+			/// The oldest message in the queue is dropped to make room for the new message
+			/// </summary>
+			DropOldest
+		};
 
 		/// <summary>
-		/// Creates a EchoingSimpleLog with default values for directory, name, and retention
+		/// The default number of messages the queue can hold
 		/// </summary>
-		EchoingSimpleLog(ISimpleLog& baseLog) : m_baseLog{ baseLog } {}
-
-		virtual ~EchoingSimpleLog() = default;
-
-		EchoingSimpleLog(const EchoingSimpleLog&) = delete;
-		EchoingSimpleLog(EchoingSimpleLog&&) = delete;
-		EchoingSimpleLog& operator=(const EchoingSimpleLog&) = delete;
-		EchoingSimpleLog& operator=(EchoingSimpleLog&&) = delete;
+		static constexpr size_t const DefaultCapacity = 1024;
 
 		/// <summary>
-		/// Gets the flag whether or not to use stderr for critical, error, and warning messages.
+		/// Creates a AsyncSimpleLog and starts its writer thread
 		/// </summary>
-		inline bool GetUseStdErr() const noexcept { return m_useStdErr; }
+		/// <param name="baseLog">The log all messages are forwarded to by the writer thread</param>
+		/// <param name="capacity">The number of messages the queue can hold; rounded up to the next power of two</param>
+		/// <param name="overflowPolicy">The behavior when a message is written while the queue is full</param>
+		AsyncSimpleLog(ISimpleLog& baseLog, size_t capacity = DefaultCapacity, OverflowPolicy overflowPolicy = OverflowPolicy::Block)
+			: m_baseLog{ baseLog }, m_overflowPolicy{ overflowPolicy }
+		{
+			size_t size = 2;
+			while (size < capacity) size <<= 1;
+			m_slots.reset(new Slot[size]);
+			m_mask = size - 1;
+			for (size_t i = 0; i < size; ++i)
+			{
+				m_slots[i].seq.store(i, std::memory_order_relaxed);
+			}
+			m_writer = std::thread{ [this]() { writerThread(); } };
+		}
 
 		/// <summary>
-		/// Sets the flag whether or not to use stderr for critical, error, and warning messages.
+		/// Forwards all messages still in the queue to the base log and stops the writer thread
 		/// </summary>
-		inline void SetUseStdErr(bool useStdErr) noexcept { m_useStdErr = useStdErr; }
+		virtual ~AsyncSimpleLog()
+		{
+			{
+				std::lock_guard<std::mutex> lock{ m_wakeLock };
+				m_stop.store(true);
+				m_wakeWriter.notify_one();
+			}
+			if (m_writer.joinable())
+			{
+				m_writer.join();
+			}
+		}
 
-		/// <summary>
-		/// Gets the flag whether or not to output colored text if supported.
-		/// </summary>
-		inline bool GetUseColors() const noexcept { return m_useColors; }
+		AsyncSimpleLog(const AsyncSimpleLog&) = delete;
+		AsyncSimpleLog(AsyncSimpleLog&&) = delete;
+		AsyncSimpleLog& operator=(const AsyncSimpleLog&) = delete;
+		AsyncSimpleLog& operator=(AsyncSimpleLog&&) = delete;
 
 		/// <summary>
-		/// Sets the flag whether or not to output colored text if supported.
+		/// Gets the behavior when a message is written while the queue is full
 		/// </summary>
-		inline void SetUseColors(bool useColors) noexcept { m_useColors = useColors && EvalCanUseConsoleApi(); }
+		inline OverflowPolicy GetOverflowPolicy() const noexcept { return m_overflowPolicy.load(std::memory_order_relaxed); }
 
 		/// <summary>
-		/// Gets the flag whether or not to echo critical error messages
+		/// Sets the behavior when a message is written while the queue is full
 		/// </summary>
-		inline bool GetEchoCriticals() const noexcept { return m_echoCriticals; }
+		inline void SetOverflowPolicy(OverflowPolicy overflowPolicy) noexcept { m_overflowPolicy.store(overflowPolicy, std::memory_order_relaxed); }
 
 		/// <summary>
-		/// Sets the flag whether or not to echo critical error messages
+		/// Gets the number of messages the queue can hold
 		/// </summary>
-		inline void SetEchoCriticals(bool echoCriticals) noexcept { m_echoCriticals = echoCriticals; }
+		inline size_t GetCapacity() const noexcept { return m_mask + 1; }
 
 		/// <summary>
-		/// Gets the flag whether or not to echo error messages
+		/// Gets the number of messages which have been dropped due to the overflow policy, or because they could not be copied into the queue
 		/// </summary>
-		inline bool GetEchoErrors() const noexcept { return m_echoErrors; }
+		inline uint64_t GetDroppedCount() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
 
 		/// <summary>
-		/// Sets the flag whether or not to echo error messages
+		/// Blocks until all messages written before this call have been forwarded to the base log, or have been dropped
 		/// </summary>
-		inline void SetEchoErrors(bool echoErrors) noexcept { m_echoErrors = echoErrors; }
+		void Drain() const
+		{
+			size_t const target = m_enqueuePos.load(std::memory_order_acquire);
+			std::unique_lock<std::mutex> lock{ m_progressLock };
+			m_progressWaiters.fetch_add(1);
+			while (m_retired.load(std::memory_order_acquire) - target > (std::numeric_limits<size_t>::max() >> 1))
+			{
+				m_progress.wait_for(lock, std::chrono::milliseconds(10));
+			}
+			m_progressWaiters.fetch_sub(1);
+		}
 
-		/// <summary>
-		/// Gets the flag whether or not to echo warning messages
-		/// </summary>
-		inline bool GetEchoWarnings() const noexcept { return m_echoWarnings; }
+	protected:
 
 		/// <summary>
-		/// Sets the flag whether or not to echo warning messages
+		/// Write a message to the log
 		/// </summary>
-		inline void SetEchoWarnings(bool echoWarnings) noexcept { m_echoWarnings = echoWarnings; }
+		/// <param name="flags">The message flags</param>
+		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
+		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.</param>
+		void WriteImpl(uint32_t flags, char const* message, size_t messageLength) const override
+		{
+			if (!m_baseLog.IsEnabled(flags)) return;
+			enqueue(flags, message, messageLength);
+		}
 
 		/// <summary>
-		/// Gets the flag whether or not to echo messages
+		/// Write a message to the log
 		/// </summary>
-		inline bool GetEchoMessages() const noexcept { return m_echoMessages; }
+		/// <param name="flags">The message flags</param>
+		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
+		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.</param>
+		void WriteImpl(uint32_t flags, wchar_t const* message, size_t messageLength) const override
+		{
+			if (!m_baseLog.IsEnabled(flags)) return;
+			enqueue(flags, message, messageLength);
+		}
 
 		/// <summary>
-		/// Sets the flag whether or not to echo messages
+		/// Checks if a message with these flags would be written at all
 		/// </summary>
-		inline void SetEchoMessages(bool echoMessages) noexcept { m_echoMessages = echoMessages; }
+		/// <param name="flags">The message flags</param>
+		/// <returns>True if the base log writes the message</returns>
+		bool IsEnabledImpl(uint32_t flags) const override
+		{
+			return m_baseLog.IsEnabled(flags);
+		}
 
-		/// <summary>
-		/// Gets the flag whether or not to echo detail messages
-		/// </summary>
-		inline bool GetEchoDetails() const noexcept { return m_echoDetails; }
+	private:
 
 		/// <summary>
-		/// Sets the flag whether or not to echo detail messages
+		/// One message in the queue
 		/// </summary>
-		inline void SetEchoDetails(bool echoDetails) noexcept { m_echoDetails = echoDetails; }
+		/// <remarks>
+		/// The strings keep their capacity when slots are reused, so in steady state no memory is allocated.
+		/// </remarks>
+		struct Slot
+		{
+			std::atomic<size_t> seq{ 0 };
+			uint32_t flags{ 0 };
+			bool wide{ false };
+			bool dropped{ false };
+			std::string text;
+			std::wstring wtext;
+		};
 
 		/// <summary>
-		/// Gets the flag whether or not to output colored text if supported.
+		/// Maximum number of messages the writer thread forwards before it releases the batch and wakes waiting threads
 		/// </summary>
-		inline bool GetUseConsoleWrite() const noexcept { return m_useConsoleWrite; }
+		static constexpr size_t const BatchSize = 64;
 
-		/// <summary>
-		/// Sets the flag whether or not to output colored text if supported.
-		/// </summary>
-		inline void SetUseConsoleWrite(bool useColors) noexcept { m_useConsoleWrite = useColors && EvalCanUseConsoleApi(); }
+		void assign(Slot& slot, char const* message, size_t messageLength) const
+		{
+			slot.wide = false;
+			slot.text.assign(message, messageLength);
+		}
 
-	protected:
+		void assign(Slot& slot, wchar_t const* message, size_t messageLength) const
+		{
+			slot.wide = true;
+			slot.wtext.assign(message, messageLength);
+		}
 
 		/// <summary>
-		/// Write a message to the log
+		/// Claims the next free slot, or returns nullptr if the queue is full
 		/// </summary>
-		/// <param name="flags">The message flags</param>
-		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
-		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.</param>
-		void WriteImpl(uint32_t flags, char const* message, size_t messageLength) const override
+		Slot* tryClaimEnqueue(size_t& outPos) const
 		{
-			ForwardWriteImpl(m_baseLog, flags, message, messageLength);
-			if ((flags & FlagDontEcho) == FlagDontEcho) return;
-			uint32_t level = flags & FlagLevelMask;
-			if (level == FlagLevelCritical && !m_echoCriticals) return;
-			if (level == FlagLevelError && !m_echoErrors) return;
-			if (level == FlagLevelWarning && !m_echoWarnings) return;
-			if (level == FlagLevelMessage && !m_echoMessages) return;
-			if (level == FlagLevelDetail && !m_echoDetails) return;
+			size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				Slot& slot = m_slots[pos & m_mask];
+				size_t seq = slot.seq.load(std::memory_order_acquire);
+				intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+				if (dif == 0)
+				{
+					if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						outPos = pos;
+						return &slot;
+					}
+				}
+				else if (dif < 0)
+				{
+					return nullptr;
+				}
+				else
+				{
+					pos = m_enqueuePos.load(std::memory_order_relaxed);
+				}
+			}
+		}
 
+		/// <summary>
+		/// Claims the oldest filled slot, or returns nullptr if the queue is empty
+		/// </summary>
+		Slot* tryClaimDequeue(size_t& outPos) const
+		{
+			size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+			for (;;)
 			{
-				std::lock_guard<std::mutex> lock{m_threadLock};
-				if (m_useConsoleWrite)
+				Slot& slot = m_slots[pos & m_mask];
+				size_t seq = slot.seq.load(std::memory_order_acquire);
+				intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+				if (dif == 0)
+				{
+					if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						outPos = pos;
+						return &slot;
+					}
+				}
+				else if (dif < 0)
 				{
-					WriteConsoleImplUnderLock(flags, message, messageLength);
+					return nullptr;
 				}
 				else
 				{
-					WritePrintImplUnderLock(flags, message, messageLength);
+					pos = m_dequeuePos.load(std::memory_order_relaxed);
 				}
 			}
 		}
 
 		/// <summary>
-		/// Write a message to the log
+		/// Returns a dequeued slot to the producers
 		/// </summary>
-		/// <param name="flags">The message flags</param>
-		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
-		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.</param>
-		void WriteImpl(uint32_t flags, wchar_t const* message, size_t messageLength) const override
+		void release(Slot& slot, size_t pos) const
 		{
-			ForwardWriteImpl(m_baseLog, flags, message, messageLength);
-			if ((flags & FlagDontEcho) == FlagDontEcho) return;
-			uint32_t level = flags & FlagLevelMask;
-			if (level == FlagLevelCritical && !m_echoCriticals) return;
-			if (level == FlagLevelError && !m_echoErrors) return;
-			if (level == FlagLevelWarning && !m_echoWarnings) return;
-			if (level == FlagLevelMessage && !m_echoMessages) return;
-			if (level == FlagLevelDetail && !m_echoDetails) return;
+			slot.seq.store(pos + m_mask + 1, std::memory_order_release);
+			m_retired.fetch_add(1, std::memory_order_release);
+		}
 
+		bool isEmpty() const
+		{
+			size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+			return m_slots[pos & m_mask].seq.load(std::memory_order_acquire) != pos + 1;
+		}
+
+		template<typename CHAR>
+		void enqueue(uint32_t flags, CHAR const* message, size_t messageLength) const
+		{
+			size_t pos = 0;
+			Slot* slot = tryClaimEnqueue(pos);
+			while (slot == nullptr)
 			{
-				std::lock_guard<std::mutex> lock{m_threadLock};
-				if (m_useConsoleWrite)
+				OverflowPolicy policy = m_overflowPolicy.load(std::memory_order_relaxed);
+				if (policy == OverflowPolicy::DropNewest)
+				{
+					m_dropped.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+				if (policy == OverflowPolicy::DropOldest)
 				{
-					WriteConsoleImplUnderLock(flags, message, messageLength);
+					size_t oldPos = 0;
+					Slot* old = tryClaimDequeue(oldPos);
+					if (old != nullptr)
+					{
+						m_dropped.fetch_add(1, std::memory_order_relaxed);
+						release(*old, oldPos);
+					}
 				}
 				else
 				{
-					WritePrintImplUnderLock(flags, message, messageLength);
+					std::unique_lock<std::mutex> lock{ m_progressLock };
+					m_progressWaiters.fetch_add(1);
+					slot = tryClaimEnqueue(pos);
+					if (slot == nullptr)
+					{
+						m_progress.wait_for(lock, std::chrono::milliseconds(10));
+					}
+					m_progressWaiters.fetch_sub(1);
+					if (slot != nullptr) break;
+				}
+				slot = tryClaimEnqueue(pos);
+			}
+
+			slot->flags = flags;
+			try
+			{
+				assign(*slot, message, messageLength);
+			}
+			catch (...)
+			{
+				// the claimed slot is published in any case, as the writer thread forwards the slots in order
+				slot->dropped = true;
+				slot->seq.store(pos + 1, std::memory_order_release);
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+				throw;
+			}
+			slot->seq.store(pos + 1, std::memory_order_release);
+
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (m_writerSleeping.load(std::memory_order_relaxed))
+			{
+				std::lock_guard<std::mutex> lock{ m_wakeLock };
+				m_wakeWriter.notify_one();
+			}
+		}
+
+		void writerThread() const
+		{
+			for (;;)
+			{
+				size_t forwarded = 0;
+				size_t pos = 0;
+				Slot* slot = nullptr;
+				while (forwarded < BatchSize && (slot = tryClaimDequeue(pos)) != nullptr)
+				{
+					try
+					{
+						if (slot->dropped)
+						{
+							slot->dropped = false;
+						}
+						else if (slot->wide)
+						{
+							ForwardWriteImpl(m_baseLog, slot->flags, slot->wtext.data(), slot->wtext.size());
+						}
+						else
+						{
+							ForwardWriteImpl(m_baseLog, slot->flags, slot->text.data(), slot->text.size());
+						}
+					}
+					catch (...) {}
+					release(*slot, pos);
+					++forwarded;
+				}
+
+				if (forwarded > 0)
+				{
+					if (m_progressWaiters.load() > 0)
+					{
+						std::lock_guard<std::mutex> lock{ m_progressLock };
+						m_progress.notify_all();
+					}
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock{ m_wakeLock };
+				m_writerSleeping.store(true, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (isEmpty())
+				{
+					if (m_stop.load()) break;
+					m_wakeWriter.wait_for(lock, std::chrono::milliseconds(100));
 				}
+				m_writerSleeping.store(false, std::memory_order_relaxed);
 			}
 		}
 
+		ISimpleLog& m_baseLog;
+
+		std::unique_ptr<Slot[]> m_slots;
+		size_t m_mask{ 0 };
+
+		alignas(64) mutable std::atomic<size_t> m_enqueuePos{ 0 };
+		alignas(64) mutable std::atomic<size_t> m_dequeuePos{ 0 };
+		alignas(64) mutable std::atomic<size_t> m_retired{ 0 };
+		mutable std::atomic<uint64_t> m_dropped{ 0 };
+		std::atomic<OverflowPolicy> m_overflowPolicy;
+
+		/// <summary>
+		/// Used to wake up the writer thread when it went to sleep on an empty queue
+		/// </summary>
+		mutable std::mutex m_wakeLock;
+		mutable std::condition_variable m_wakeWriter;
+		mutable std::atomic<bool> m_writerSleeping{ false };
+		std::atomic<bool> m_stop{ false };
+
+		/// <summary>
+		/// Used to wake up threads waiting for the writer thread to make progress, i.e. blocked producers or `Drain`
+		/// </summary>
+		mutable std::mutex m_progressLock;
+		mutable std::condition_variable m_progress;
+		mutable std::atomic<int> m_progressWaiters{ 0 };
+
+		std::thread m_writer;
 	};
 
 	/// <summary>
-	/// Extention to SimpleLog, which echoes all messages to DebugOutput
+	/// Extention to SimpleLog, which writes all messages to several logs
 	/// </summary>
-	class DebugOutputEchoingSimpleLog : public ISimpleLog
+	/// <remarks>
+	/// Messages are formatted once, before they are handed to this log, and every log receives the same message string.
+	/// Logs which would discard a message are skipped. On POSIX systems, wide messages are converted to UTF8 once for all logs.
+	/// On Windows, narrow strings use the system code page, so wide messages are handed to the logs unchanged.
+	/// Printf-based messages are always formatted, also for logs with the binary file format.
+	/// </remarks>
+	class TeeSimpleLog : public ISimpleLog
 	{
-	private:
-		ISimpleLog& m_baseLog;
 	public:
-		DebugOutputEchoingSimpleLog(ISimpleLog& baseLog) : m_baseLog{ baseLog } {}
-		virtual ~DebugOutputEchoingSimpleLog() = default;
 
-		DebugOutputEchoingSimpleLog(const DebugOutputEchoingSimpleLog&) = delete;
-		DebugOutputEchoingSimpleLog(DebugOutputEchoingSimpleLog&&) = delete;
-		DebugOutputEchoingSimpleLog& operator=(const DebugOutputEchoingSimpleLog&) = delete;
-		DebugOutputEchoingSimpleLog& operator=(DebugOutputEchoingSimpleLog&&) = delete;
+		/// <summary>
+		/// Specifies how messages are handed to a log
+		/// </summary>
+		enum class Dispatch
+		{
+			/// <summary>
+			/// The log is written by the calling thread
+			/// </summary>
+			Inline,
+
+			/// <summary>
+			/// The log is written by an own thread, via an `AsyncSimpleLog`, e.g. for slow logs
+			/// </summary>
+			Background
+		};
+
+		TeeSimpleLog() = default;
+
+		/// <summary>
+		/// Creates a TeeSimpleLog writing to all logs by the calling thread
+		/// </summary>
+		TeeSimpleLog(std::initializer_list<std::reference_wrapper<ISimpleLog>> logs)
+		{
+			for (ISimpleLog& log : logs)
+			{
+				Add(log);
+			}
+		}
+
+		virtual ~TeeSimpleLog() = default;
+
+		TeeSimpleLog(const TeeSimpleLog&) = delete;
+		TeeSimpleLog(TeeSimpleLog&&) = delete;
+		TeeSimpleLog& operator=(const TeeSimpleLog&) = delete;
+		TeeSimpleLog& operator=(TeeSimpleLog&&) = delete;
+
+		/// <summary>
+		/// Adds a log all messages are written to. Add all logs before messages are written.
+		/// </summary>
+		/// <param name="log">The log; must outlive this object</param>
+		/// <param name="dispatch">How messages are handed to the log</param>
+		void Add(ISimpleLog& log, Dispatch dispatch = Dispatch::Inline)
+		{
+			if (dispatch == Dispatch::Background)
+			{
+				m_asyncLogs.push_back(std::make_unique<AsyncSimpleLog>(log));
+				m_logs.push_back(m_asyncLogs.back().get());
+				return;
+			}
+			m_logs.push_back(&log);
+		}
+
+		/// <summary>
+		/// Gets the number of logs messages are written to
+		/// </summary>
+		inline size_t GetLogCount() const noexcept { return m_logs.size(); }
 
 	protected:
 
@@ -1416,26 +6895,14 @@ namespace sgrottel
 		/// </summary>
 		/// <param name="flags">The message flags</param>
 		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
-		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.
-		/// If set less than zero, the message string is treated being zero terminated.</param>
+		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.</param>
 		void WriteImpl(uint32_t flags, char const* message, size_t messageLength) const override
 		{
-			ForwardWriteImpl(m_baseLog, flags, message, messageLength);
-			std::string outputCopy;
-			outputCopy.reserve(messageLength + 4 + 2);
-			outputCopy += "[";
-			switch (flags & ISimpleLog::FlagLevelMask) {
-			case ISimpleLog::FlagLevelCritical: outputCopy += "C"; break;
-			case ISimpleLog::FlagLevelError: outputCopy += "E"; break;
-			case ISimpleLog::FlagLevelWarning: outputCopy += "W"; break;
-			case ISimpleLog::FlagLevelMessage: outputCopy += "l"; break;
-			case ISimpleLog::FlagLevelDetail: outputCopy += "d"; break;
-			default: outputCopy += "."; break;
-			}
-			outputCopy += "] ";
-			outputCopy += std::string_view{ message, messageLength };
-			outputCopy += "\n";
-			OutputDebugStringA(outputCopy.c_str());
+			for (ISimpleLog const* log : m_logs)
+			{
+				if (!log->IsEnabled(flags)) continue;
+				ForwardWriteImpl(*log, flags, message, messageLength);
+			}
 		}
 
 		/// <summary>
@@ -1443,27 +6910,60 @@ namespace sgrottel
 		/// </summary>
 		/// <param name="flags">The message flags</param>
 		/// <param name="message">The message string. Expected to NOT contain a new line at the end.</param>
-		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.
-		/// If set less than zero, the message string is treated being zero terminated.</param>
+		/// <param name="messageLength">The length of the message string in characters, not including a terminating zero.</param>
 		void WriteImpl(uint32_t flags, wchar_t const* message, size_t messageLength) const override
 		{
-			ForwardWriteImpl(m_baseLog, flags, message, messageLength);
-			std::wstring outputCopy;
-			outputCopy.reserve(messageLength + 4 + 2);
-			outputCopy += L"[";
-			switch (flags & ISimpleLog::FlagLevelMask) {
-			case ISimpleLog::FlagLevelCritical: outputCopy += L"C"; break;
-			case ISimpleLog::FlagLevelError: outputCopy += L"E"; break;
-			case ISimpleLog::FlagLevelWarning: outputCopy += L"W"; break;
-			case ISimpleLog::FlagLevelMessage: outputCopy += L"l"; break;
-			case ISimpleLog::FlagLevelDetail: outputCopy += L"d"; break;
-			default: outputCopy += L"."; break;
-			}
-			outputCopy += L"] ";
-			outputCopy += std::wstring_view{ message, messageLength };
-			outputCopy += L"\n";
-			OutputDebugStringW(outputCopy.c_str());
+#if defined(SIMPLELOG_POSIX)
+			std::string* utf8 = nullptr;
+#endif
+			for (ISimpleLog const* log : m_logs)
+			{
+				if (!log->IsEnabled(flags)) continue;
+#if defined(SIMPLELOG_POSIX)
+				if (utf8 == nullptr)
+				{
+					utf8 = &threadUtf8Buffer();
+					Utf8Encoding::FromWide(*utf8, message, messageLength);
+				}
+				ForwardWriteImpl(*log, flags, utf8->data(), utf8->size());
+#else
+				ForwardWriteImpl(*log, flags, message, messageLength);
+#endif
+			}
+		}
+
+		/// <summary>
+		/// Checks if a message with these flags would be written at all
+		/// </summary>
+		/// <param name="flags">The message flags</param>
+		/// <returns>True if any of the logs writes the message</returns>
+		bool IsEnabledImpl(uint32_t flags) const override
+		{
+			for (ISimpleLog const* log : m_logs)
+			{
+				if (log->IsEnabled(flags)) return true;
+			}
+			return false;
+		}
+
+	private:
+
+#if defined(SIMPLELOG_POSIX)
+		/// <summary>
+		/// Per-thread buffer for wide messages converted to UTF8, reused to avoid allocations
+		/// </summary>
+		static std::string& threadUtf8Buffer()
+		{
+			thread_local std::string buffer;
+			return buffer;
 		}
+#endif
+
+		/// <summary>
+		/// The logs messages are written to, including the `AsyncSimpleLog` objects of logs written by own threads
+		/// </summary>
+		std::vector<ISimpleLog const*> m_logs;
+		std::vector<std::unique_ptr<AsyncSimpleLog>> m_asyncLogs;
 	};
 
 #endif /* SIMPLELOG_INTERFACE_ONLY */
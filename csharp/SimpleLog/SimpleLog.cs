@@ -412,6 +412,35 @@ namespace SGrottel
 			GC.SuppressFinalize(this);
 		}
 
+		/// <summary>
+		/// Gets the name of the mutex serializing the retention renames of the log files of one name in one directory.
+		/// Logs of other names or in other directories are set up in parallel.
+		/// The Cpp implementation derives the same name.
+		/// </summary>
+		private static string GetSetupMutexName(string directory, string name)
+		{
+			return GetSetupMutexName(Path.GetFullPath(Path.Combine(directory, name)));
+		}
+
+		/// <summary>
+		/// Gets the name of the setup mutex for the full path of the log files without file name extension.
+		/// Mutex names must not contain backslashes, so the name is derived from the FNV-1a hash of the UTF16 code units of the path.
+		/// Only ASCII letters are lower-cased, as case mappings of other characters depend on the runtime and its version.
+		/// </summary>
+		internal static string GetSetupMutexName(string fullPath)
+		{
+			ulong hash = 14695981039346656037UL;
+			unchecked
+			{
+				foreach (char c in fullPath)
+				{
+					char u = (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c;
+					hash = (hash ^ u) * 1099511628211UL;
+				}
+			}
+			return string.Format(CultureInfo.InvariantCulture, "SGROTTEL_SIMPLELOG_{0:x16}", hash);
+		}
+
 		/// <summary>
 		/// Creates a SimpleLog instance.
 		/// </summary>
@@ -433,7 +462,7 @@ namespace SGrottel
 			ArgumentException.ThrowIfNullOrWhiteSpace(name);
 			if (retention < 2) throw new ArgumentException("Retention value must be 2 or larger", paramName: nameof(retention));
 
-			using (Mutex logSetupMutex = new Mutex(false, "SGROTTEL_SIMPLELOG_CREATION"))
+			using (Mutex logSetupMutex = new Mutex(false, GetSetupMutexName(directory, name)))
 			{
 				logSetupMutex.WaitOne();
 				try